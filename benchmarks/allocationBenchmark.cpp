@@ -0,0 +1,150 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include "../jsonParser.h"
+
+/**
+ * Counts heap calls of a json document built by the parser (arena) and the same document
+ * built from separately allocated JsonValues.
+ */
+
+namespace {
+
+// GCC sees malloc and free through the inlined replacements below and reports every new expression as a
+// mismatched allocation, the counters do not need them inlined
+#if defined(__GNUC__) || defined(__clang__)
+#define COUNTED __attribute__((noinline))
+#else
+#define COUNTED
+#endif
+
+size_t allocations = 0;     /**< Amount of calls to operator new*/
+size_t deallocations = 0;   /**< Amount of calls to operator delete*/
+
+/**
+ * Create a document with the same shape as test_input/complex/animation.json,
+ * with a configurable amount of animations.
+ */
+std::string makeAnimationDocument(int animations)
+{
+    const char* names[] = {"walk_right", "walk_left", "idle_front", "idle_back"};
+    std::string text = R"({
+	"file": "animation.png",
+	"tile_size": {"width": 32, "height": 32},
+	"border": 1,
+	"type": "animation",
+	"number_of_animations": )"+std::to_string(animations)+R"(,
+	"animations": [)";
+    for (int i = 0; i<animations; i++) {
+        if (i>0)
+            text += ",";
+        text += R"(
+		{
+			"id": )"+std::to_string(i)+R"(,
+			"name": ")"+std::string(names[i%4])+R"(",
+			"loop": true,
+			"row_in_sheet": 3,
+			"sprite_count": 8,
+			"pingpong": false,
+			"frame_time": 0.2
+		})";
+    }
+    text += "\n\t]\n}";
+    return text;
+}
+
+/**
+ * Deep copy a value to the heap, the way every value was allocated before the arena.
+ */
+JsonValue* copyToHeap(JsonValue& value)
+{
+    if (value.isObject()) {
+        auto* copy = new JsonValue(ValueType::JSON_OBJ);
+        for (auto& member : value.getObjectValue())
+            copy->addToObject(copyToHeap(*member.second), std::string(member.first.data(), member.first.size()));
+        return copy;
+    }
+    if (value.isArray()) {
+        auto* copy = new JsonValue(ValueType::JSON_ARRAY);
+        for (auto* element : value.getArrayValue())
+            copy->addToArray(copyToHeap(*element));
+        return copy;
+    }
+    if (value.isString())
+        return new JsonValue(ValueType::JSON_STRING, value.getStringValue());
+    if (value.isNull())
+        return new JsonValue(ValueType::JSON_NULL);
+    if (value.isNumber())
+        return new JsonValue(ValueType::JSON_NUM, std::to_string(value.getNumberValue()));
+    return new JsonValue(ValueType::JSON_BOOL, value.getBoolValue() ? "true" : "false");
+}
+
+double millisecondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now()-start).count();
+}
+
+}
+
+COUNTED void* operator new(size_t size)
+{
+    allocations++;
+    if (void* p = std::malloc(size == 0 ? 1 : size))
+        return p;
+    throw std::bad_alloc();
+}
+
+COUNTED void operator delete(void* p) noexcept
+{
+    if (p!=nullptr)
+        deallocations++;
+    std::free(p);
+}
+
+COUNTED void operator delete(void* p, size_t) noexcept
+{
+    if (p!=nullptr)
+        deallocations++;
+    std::free(p);
+}
+
+int main()
+{
+    std::cout << "animations\tarena allocs\tarena frees\theap allocs\theap frees\tarena teardown ms\theap teardown ms"
+                 "\tdocument bytes\n";
+    for (int animations : {2, 100, 10000, 100000}) {
+        std::string text = makeAnimationDocument(animations);
+        auto* parser = new JsonParser;
+
+        size_t start = allocations;
+        parser->parseString(text);
+        size_t arenaAllocations = allocations-start;
+        size_t documentBytes = parser->memoryUsage();
+
+        // Build the same document from separately allocated values
+        start = allocations;
+        auto* heapDocument = new JsonValue(ValueType::JSON_OBJ);
+        for (const char* key : {"file", "tile_size", "border", "type", "number_of_animations", "animations"})
+            heapDocument->addToObject(copyToHeap((*parser)[key]), key);
+        size_t heapAllocations = allocations-start;
+
+        start = deallocations;
+        auto timer = std::chrono::steady_clock::now();
+        delete parser;
+        double arenaTeardown = millisecondsSince(timer);
+        size_t arenaDeallocations = deallocations-start;
+
+        start = deallocations;
+        timer = std::chrono::steady_clock::now();
+        delete heapDocument;
+        double heapTeardown = millisecondsSince(timer);
+        size_t heapDeallocations = deallocations-start;
+
+        std::cout << animations << "\t\t" << arenaAllocations << "\t\t" << arenaDeallocations << "\t\t"
+                  << heapAllocations << "\t\t" << heapDeallocations << "\t\t" << arenaTeardown << "\t\t\t"
+                  << heapTeardown << "\t\t" << documentBytes << "\n";
+    }
+    return 0;
+}
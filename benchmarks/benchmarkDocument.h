@@ -0,0 +1,36 @@
+#ifndef JSONPARSER_BENCHMARKDOCUMENT_H
+#define JSONPARSER_BENCHMARKDOCUMENT_H
+
+#include <chrono>
+#include <string>
+
+/**
+ * Create a document with an array of records with numbers, repeated keys and strings, and nested values.
+ * The binary and image benchmarks load the same document, so their results can be compared.
+ */
+inline std::string makeDocument(int records)
+{
+    std::string text = R"({"records": [)";
+    for (int i = 0; i<records; i++) {
+        text += i==0 ? "{" : ", {";
+        text += R"("id": )"+std::to_string(i)+R"(, "name": "record number )"+std::to_string(i)
+                +R"(", "score": )"+std::to_string(i)+R"(.125, "active": )"+(i%2==0 ? "true" : "false")
+                +R"(, "tags": ["first", "second", "third"], "position": {"x": )"+std::to_string(i%640)
+                +R"(, "y": )"+std::to_string(i%480)+R"(, "z": -1.5e-3}, "note": null})";
+    }
+    return text+"]}";
+}
+
+/**
+ * Average seconds of a call to load.
+ */
+template<class Load>
+double seconds(int repetitions, Load load)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i<repetitions; i++)
+        load();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count()/repetitions;
+}
+
+#endif //JSONPARSER_BENCHMARKDOCUMENT_H
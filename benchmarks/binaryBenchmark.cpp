@@ -0,0 +1,43 @@
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include "../jsonParser.h"
+#include "benchmarkDocument.h"
+
+/**
+ * Measures loading a document from its json text against loading it from a binary snapshot, both from a file.
+ */
+
+namespace {
+
+size_t fileSize(const std::string& file_name)
+{
+    std::ifstream file(file_name, std::ios::binary | std::ios::ate);
+    return static_cast<size_t>(file.tellg());
+}
+
+}
+
+int main()
+{
+    const int repetitions = 5;
+    const std::string textFile = "binary_benchmark.json";
+    const std::string binaryFile = "binary_benchmark.ejsb";
+    {
+        std::ofstream file(textFile, std::ios::binary);
+        file << makeDocument(400000);
+    }
+
+    JsonParser parser;
+    double text = seconds(repetitions, [&]() { parser.parseMapped(textFile); });
+    parser.save(binaryFile);
+    double binary = seconds(repetitions, [&]() { parser.loadBinary(binaryFile); });
+
+    std::cout << "text MB\tbinary MB\ttext load ms\tbinary load ms\tspeedup\n";
+    std::cout << fileSize(textFile)/1e6 << "\t" << fileSize(binaryFile)/1e6 << "\t\t" << text*1e3 << "\t\t"
+              << binary*1e3 << "\t\t" << text/binary << "\n";
+    std::remove(textFile.c_str());
+    std::remove(binaryFile.c_str());
+    return 0;
+}
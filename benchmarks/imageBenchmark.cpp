@@ -0,0 +1,59 @@
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include "../jsonParser.h"
+#include "../jsonImage.h"
+#include "benchmarkDocument.h"
+
+/**
+ * Measures the startup cost of a document, opening it and reading a few values, from its json text, from a binary
+ * snapshot and from a document image, all from a file.
+ */
+
+int main()
+{
+    const int repetitions = 5;
+    const int records = 400000;
+    const int lookups = 1000;
+    const std::string textFile = "image_benchmark.json";
+    const std::string binaryFile = "image_benchmark.ejsb";
+    const std::string imageFile = "image_benchmark.ejsi";
+    {
+        std::ofstream file(textFile, std::ios::binary);
+        file << makeDocument(records);
+    }
+
+    // Every run reads the same spread out records, so the image only touches their pages
+    double sum = 0;
+    JsonParser parser;
+    double text = seconds(repetitions, [&]() {
+        parser.parseMapped(textFile);
+        JsonArray& array = parser["records"].getArrayValue();
+        for (int i = 0; i<lookups; i++)
+            sum += array[i*(records/lookups)]->getObjectValue()["score"].getNumberValue();
+    });
+    parser.save(binaryFile);
+    double binary = seconds(repetitions, [&]() {
+        parser.loadBinary(binaryFile);
+        JsonArray& array = parser["records"].getArrayValue();
+        for (int i = 0; i<lookups; i++)
+            sum += array[i*(records/lookups)]->getObjectValue()["score"].getNumberValue();
+    });
+    parser.saveImage(imageFile);
+    JsonImage image;
+    double mapped = seconds(repetitions, [&]() {
+        image.open(imageFile);
+        JsonImageValue array = image["records"];
+        for (int i = 0; i<lookups; i++)
+            sum += array[i*(records/lookups)]["score"].getNumberValue();
+    });
+
+    std::cout << "text ms\t\tbinary ms\timage ms\tspeedup over text\n";
+    std::cout << text*1e3 << "\t\t" << binary*1e3 << "\t\t" << mapped*1e3 << "\t\t" << text/mapped << "\n";
+    std::cout << "checksum " << sum << "\n";
+    std::remove(textFile.c_str());
+    std::remove(binaryFile.c_str());
+    std::remove(imageFile.c_str());
+    return 0;
+}
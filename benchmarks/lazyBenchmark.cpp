@@ -0,0 +1,94 @@
+#include <chrono>
+#include <iostream>
+#include <string>
+#include "../jsonParser.h"
+#include "../jsonDocument.h"
+
+/**
+ * Compares reading a few values of a large document with JsonParser, which builds every value,
+ * and with JsonDocument, which only reads the values that are accessed.
+ */
+
+namespace {
+
+/**
+ * Create a document with the same shape as test_input/complex/animation.json,
+ * with a configurable amount of animations and a key after the animations.
+ */
+std::string makeAnimationDocument(int animations)
+{
+    const char* names[] = {"walk_right", "walk_left", "idle_front", "idle_back"};
+    std::string text = R"({
+	"file": "animation.png",
+	"tile_size": {"width": 32, "height": 32},
+	"border": 1,
+	"animations": [)";
+    for (int i = 0; i<animations; i++) {
+        if (i>0)
+            text += ",";
+        text += R"(
+		{
+			"id": )"+std::to_string(i)+R"(,
+			"name": ")"+std::string(names[i%4])+R"(",
+			"loop": true,
+			"row_in_sheet": 3,
+			"sprite_count": 8,
+			"pingpong": false,
+			"frame_time": 0.2
+		})";
+    }
+    text += "\n\t],\n\t\"number_of_animations\": "+std::to_string(animations)+"\n}";
+    return text;
+}
+
+/**
+ * Read the same values from a JsonParser or a JsonDocument.
+ */
+template<class Document>
+double readValues(Document& document)
+{
+    return document["tile_size"]["width"].getNumberValue()+document["border"].getNumberValue()
+            +document["animations"][3]["frame_time"].getNumberValue()
+            +document["number_of_animations"].getNumberValue()
+            +static_cast<double>(document["file"].getStringView().size());
+}
+
+template<class Run>
+double millisecondsPerRun(int repetitions, Run run)
+{
+    double result = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i<repetitions; i++)
+        result += run();
+    double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now()-start).count();
+    // Use the result, so the loop is not optimized away
+    if (result<0)
+        std::cerr << "unexpected result\n";
+    return elapsed/repetitions;
+}
+
+}
+
+int main()
+{
+    std::cout << "animations\tdocument bytes\tJsonParser ms\tJsonDocument ms\n";
+    for (int animations : {1000, 10000, 100000}) {
+        std::string text = makeAnimationDocument(animations);
+        int repetitions = 2000000/animations;
+
+        JsonParser parser;
+        double parsed = millisecondsPerRun(repetitions, [&]() {
+            parser.parse(text.data(), text.size());
+            return readValues(parser);
+        });
+
+        JsonDocument document;
+        double lazy = millisecondsPerRun(repetitions, [&]() {
+            document.parse(text.data(), text.size());
+            return readValues(document);
+        });
+
+        std::cout << animations << "\t\t" << text.size() << "\t\t" << parsed << "\t\t" << lazy << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,65 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include "../jsonLines.h"
+
+/**
+ * Measures the throughput of parsing newline delimited json with an increasing amount of threads,
+ * keeping the records in order and passing them to a function.
+ */
+
+namespace {
+
+std::string makeLines(int records)
+{
+    std::string text;
+    for (int i = 0; i<records; i++) {
+        text += R"({"time": )"+std::to_string(1600000000+i)+R"(, "level": ")"+(i%10==0 ? "warning" : "info")
+                +R"(", "message": "request )"+std::to_string(i)+R"( handled", "duration": )"+std::to_string(i%1000*0.25)
+                +R"(, "tags": ["http", "api"], "client": {"ip": "10.0.0.1", "port": 8080}})"+"\n";
+    }
+    return text;
+}
+
+double megabytesPerSecond(size_t bytes, int repetitions, std::chrono::steady_clock::time_point start)
+{
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+    return static_cast<double>(bytes)*repetitions/seconds/1e6;
+}
+
+}
+
+int main()
+{
+    const int repetitions = 5;
+    std::string text = makeLines(500000);
+    std::cout << "document size: " << text.size() << " bytes, hardware threads: "
+              << std::thread::hardware_concurrency() << "\n";
+
+    double single = 0;
+    for (unsigned threads : {1u, 2u, 4u, 8u, 16u}) {
+        JsonLines lines(threads);
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i<repetitions; i++)
+            lines.parseString(text);
+        double ordered = megabytesPerSecond(text.size(), repetitions, start);
+
+        std::atomic<size_t> warnings(0);
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i<repetitions; i++) {
+            lines.forEach(text.data(), text.size(), [&warnings](int, JsonValue& record) {
+                if (record["level"].getStringView()=="warning")
+                    warnings++;
+            });
+        }
+        double callback = megabytesPerSecond(text.size(), repetitions, start);
+        if (threads==1)
+            single = ordered;
+        std::cout << threads << " threads:\tordered " << ordered << " MB/s (" << ordered/single
+                  << "x)\tcallback " << callback << " MB/s\n";
+    }
+    return 0;
+}
@@ -0,0 +1,66 @@
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/stat.h>
+#include "../jsonLoader.h"
+
+/**
+ * Measures loading thousands of small files, one JsonParser per file after each other and with JsonLoader
+ * on an increasing amount of threads, and shows how the time is split between reading and parsing.
+ */
+
+namespace {
+
+std::string makeFile(int number)
+{
+    std::string text = R"({"name": "component )"+std::to_string(number)+R"(", "enabled": true, "priority": )"
+                       +std::to_string(number%10)+R"(, "settings": {)";
+    for (int i = 0; i<20; i++) {
+        text += (i==0 ? "" : ", ")+std::string(R"("setting )")+std::to_string(i)+R"(": {"value": )"
+                +std::to_string(number*0.5+i)+R"(, "unit": "ms", "tags": ["a", "b"]})";
+    }
+    return text+"}}\n";
+}
+
+}
+
+int main()
+{
+    const int files = 4000;
+    const std::string directory = "loader_benchmark_files";
+    mkdir(directory.c_str(), 0755);
+    std::vector<std::string> paths;
+    for (int i = 0; i<files; i++) {
+        paths.push_back(directory+"/component"+std::to_string(i)+".json");
+        std::ofstream(paths.back()) << makeFile(i);
+    }
+    std::cout << files << " files, hardware threads: " << std::thread::hardware_concurrency() << "\n";
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::unique_ptr<JsonParser>> documents;
+    for (const std::string& path : paths) {
+        documents.emplace_back(new JsonParser());
+        documents.back()->parse(path);
+    }
+    double serial = std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+    std::cout << "one JsonParser per file:\t" << serial*1e3 << " ms\n";
+    documents.clear();
+
+    for (unsigned threads : {1u, 2u, 4u, 8u}) {
+        JsonLoader loader(threads);
+        std::vector<JsonLoadResult> results = loader.loadAll(paths);
+        const JsonLoadStatistics& statistics = loader.statistics();
+        std::cout << threads << " threads:\t" << statistics.wallSeconds*1e3 << " ms (" << serial/statistics.wallSeconds
+                  << "x)\tI/O " << statistics.ioSeconds*1e3 << " ms\tparse " << statistics.parseSeconds*1e3
+                  << " ms\tfailed " << statistics.failed << "\n";
+    }
+
+    for (const std::string& path : paths)
+        std::remove(path.c_str());
+    std::remove(directory.c_str());
+    return 0;
+}
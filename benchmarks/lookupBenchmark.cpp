@@ -0,0 +1,77 @@
+#include <chrono>
+#include <iostream>
+#include <string>
+#include "../jsonPointer.h"
+
+/**
+ * Measures the cost of accessing a nested value, ex. parser["object"]["subobject"]["subobject name"], and of
+ * resolving a JsonPointer to the same value that was parsed once.
+ */
+
+namespace {
+
+/**
+ * Create a document with a nested object, every object has some other keys as well.
+ */
+std::string makeDocument(int keysPerObject)
+{
+    auto filler = [&](const std::string& prefix) {
+        std::string text;
+        for (int i = 0; i<keysPerObject; i++)
+            text += "\""+prefix+" key "+std::to_string(i)+"\": "+std::to_string(i)+", ";
+        return text;
+    };
+    return "{"+filler("root")+R"("object": {)"+filler("object")+R"("subobject": {)"+filler("subobject")
+            +R"("subobject name": "value"}}})";
+}
+
+template<class Access>
+double nanosecondsPerAccess(int repetitions, Access access)
+{
+    size_t found = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i<repetitions; i++)
+        found += access();
+    double elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now()-start).count();
+    // Use the result, so the loop is not optimized away
+    if (found!=static_cast<size_t>(repetitions))
+        std::cerr << "lookup failed\n";
+    return elapsed/repetitions;
+}
+
+}
+
+int main()
+{
+    const int repetitions = 2000000;
+    std::cout << "keys per object\tstring literals ns\tstd::string ns\tfind ns\tpointer ns\n";
+    for (int keys : {4, 32, 256}) {
+        JsonParser parser;
+        parser.parseString(makeDocument(keys));
+
+        double literals = nanosecondsPerAccess(repetitions, [&]() {
+            return parser["object"]["subobject"]["subobject name"].getStringView().size()==5;
+        });
+
+        std::string object = "object", subobject = "subobject", name = "subobject name";
+        double strings = nanosecondsPerAccess(repetitions, [&]() {
+            return parser[object][subobject][name].getStringView().size()==5;
+        });
+
+        double find = nanosecondsPerAccess(repetitions, [&]() {
+            JsonValue* value = parser.find("object");
+            value = value!=nullptr ? value->find("subobject") : nullptr;
+            value = value!=nullptr ? value->find("subobject name") : nullptr;
+            return value!=nullptr && value->getStringView().size()==5;
+        });
+
+        JsonPointer pointer("/object/subobject/subobject name");
+        double resolve = nanosecondsPerAccess(repetitions, [&]() {
+            JsonValue* value = pointer.resolve(parser);
+            return value!=nullptr && value->getStringView().size()==5;
+        });
+
+        std::cout << keys << "\t\t" << literals << "\t\t\t" << strings << "\t\t" << find << "\t" << resolve << "\n";
+    }
+    return 0;
+}
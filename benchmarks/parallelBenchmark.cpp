@@ -0,0 +1,52 @@
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include "../jsonParallelParser.h"
+
+/**
+ * Measures the speedup of parsing a large root array of objects with an increasing amount of threads.
+ */
+
+namespace {
+
+std::string makeRecords(int records)
+{
+    std::string text = "[\n";
+    for (int i = 0; i<records; i++) {
+        if (i>0)
+            text += ",\n";
+        text += R"(  {"id": )"+std::to_string(i)+R"(, "name": "item \")"+std::to_string(i)+R"(\", [in stock]", "price": )"
+                +std::to_string(i%1000*0.25)+R"(, "tags": ["a", "b", "c"], "size": {"w": 10, "h": 20}, "active": true})";
+    }
+    return text+"\n]\n";
+}
+
+double megabytesPerSecond(size_t bytes, int repetitions, std::chrono::steady_clock::time_point start)
+{
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+    return static_cast<double>(bytes)*repetitions/seconds/1e6;
+}
+
+}
+
+int main()
+{
+    const int repetitions = 5;
+    std::string text = makeRecords(500000);
+    std::cout << "document size: " << text.size() << " bytes, hardware threads: "
+              << std::thread::hardware_concurrency() << "\n";
+
+    double single = 0;
+    for (unsigned threads : {1u, 2u, 4u, 8u, 16u}) {
+        JsonParallelParser parser(threads);
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i<repetitions; i++)
+            parser.parseString(text);
+        double throughput = megabytesPerSecond(text.size(), repetitions, start);
+        if (threads==1)
+            single = throughput;
+        std::cout << threads << " threads:\t" << throughput << " MB/s\tspeedup " << throughput/single << "x\n";
+    }
+    return 0;
+}
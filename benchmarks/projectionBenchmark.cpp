@@ -0,0 +1,67 @@
+#include <chrono>
+#include <iostream>
+#include <string>
+#include "../jsonParser.h"
+#include "../jsonProjection.h"
+
+/**
+ * Measures parsing a document of wide records completely against parsing only a dozen fields of every record
+ * with a projection.
+ */
+
+namespace {
+
+/**
+ * Create a document with an array of records with many fields, a quarter of them nested objects.
+ */
+std::string makeDocument(int records, int fields)
+{
+    std::string text = R"({"records": [)";
+    for (int i = 0; i<records; i++) {
+        text += i==0 ? "{" : ", {";
+        for (int j = 0; j<fields; j++) {
+            text += (j==0 ? "\"field " : ", \"field ")+std::to_string(j)+"\": ";
+            if (j%4==0)
+                text += R"({"x": )"+std::to_string(i)+R"(, "y": [1, 2, 3], "label": "nested value"})";
+            else if (j%4==1)
+                text += "\"text of field "+std::to_string(j)+"\"";
+            else
+                text += std::to_string(i*fields+j)+".25";
+        }
+        text += "}";
+    }
+    return text+"]}";
+}
+
+template<class Parse>
+double megabytesPerSecond(size_t bytes, int repetitions, Parse parse)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i<repetitions; i++)
+        parse();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+    return bytes*static_cast<double>(repetitions)/seconds/1e6;
+}
+
+}
+
+int main()
+{
+    const int repetitions = 5;
+    std::string json = makeDocument(2000, 300);
+    std::vector<std::string> pointers;
+    for (int j = 0; j<300; j += 25)
+        pointers.push_back("/records/field "+std::to_string(j+1));
+    JsonProjection projection(pointers);
+
+    JsonParser parser;
+    double full = megabytesPerSecond(json.size(), repetitions, [&]() { parser.parseString(json); });
+    size_t fullMemory = parser.memoryUsage();
+    double projected = megabytesPerSecond(json.size(), repetitions, [&]() { parser.parseString(json, projection); });
+    size_t projectedMemory = parser.memoryUsage();
+
+    std::cout << "document MB\tfields read\tfull MB/s\tprojected MB/s\tfull memory MB\tprojected memory MB\n";
+    std::cout << json.size()/1e6 << "\t\t" << pointers.size() << "\t\t" << full << "\t\t" << projected << "\t\t"
+              << fullMemory/1e6 << "\t\t" << projectedMemory/1e6 << "\n";
+    return 0;
+}
@@ -0,0 +1,75 @@
+#include <chrono>
+#include <iostream>
+#include <string>
+#include "../jsonQuery.h"
+
+/**
+ * Measures a compiled JsonQuery with a filter against the same selection written by hand, over a large array
+ * of objects.
+ */
+
+namespace {
+
+/**
+ * Create a document with an array of records.
+ */
+std::string makeDocument(int records)
+{
+    std::string text = R"({"records": [)";
+    for (int i = 0; i<records; i++) {
+        text += (i==0 ? "" : ", ");
+        text += R"({"id": )"+std::to_string(i)+R"(, "name": "record )"+std::to_string(i)+R"(", "active": )"
+                +(i%3==0 ? "true" : "false")+R"(, "price": )"+std::to_string(i%250)+".5}";
+    }
+    return text+"]}";
+}
+
+template<class Select>
+double millisecondsPerRun(int repetitions, size_t expected, Select select)
+{
+    size_t found = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i<repetitions; i++)
+        found += select();
+    double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now()-start).count();
+    // Use the result, so the loop is not optimized away
+    if (found!=expected*repetitions)
+        std::cerr << "selection failed\n";
+    return elapsed/repetitions;
+}
+
+}
+
+int main()
+{
+    const int repetitions = 20;
+    std::cout << "records\t\tselected\tby hand ms\tquery ms\n";
+    for (int records : {1000, 100000, 1000000}) {
+        JsonParser parser;
+        parser.parseString(makeDocument(records));
+
+        JsonQuery query("$.records[?(@.active == true && @.price > 100)].name");
+        size_t expected = query.evaluate(parser).size();
+
+        double byHand = millisecondsPerRun(repetitions, expected, [&]() {
+            std::vector<JsonValue*> names;
+            for (JsonValue* record : parser["records"].getArrayValue()) {
+                JsonValue* active = record->find("active");
+                JsonValue* price = record->find("price");
+                if (active!=nullptr && active->isBool() && !active->isNumber() && active->getBoolValue()
+                    && price!=nullptr && price->isNumber() && price->getNumberValue()>100) {
+                    if (JsonValue* name = record->find("name"))
+                        names.push_back(name);
+                }
+            }
+            return names.size();
+        });
+
+        double compiled = millisecondsPerRun(repetitions, expected, [&]() {
+            return query.evaluate(parser).size();
+        });
+
+        std::cout << records << "\t\t" << expected << "\t\t" << byHand << "\t\t" << compiled << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,111 @@
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <string>
+#include "../jsonSerializer.h"
+#include "../jsonWriter.h"
+
+/**
+ * Measures the throughput of writing parsed documents back to json text: a mixed document compact and indented,
+ * a document of doubles and a document of strings. The doubles are compared with printf("%.17g"), and the mixed
+ * document is also written call by call with a JsonWriter, without building it first.
+ */
+
+namespace {
+
+std::string makeMixed(int records)
+{
+    std::string text = R"({"records": [)";
+    for (int i = 0; i<records; i++) {
+        text += (i==0 ? "" : ", ")+std::string(R"({"id": )")+std::to_string(i)+R"(, "name": "item )"
+                +std::to_string(i)+R"(", "price": )"+std::to_string(i%1000*0.25)
+                +R"(, "tags": ["a", "b", "c"], "size": {"w": 10, "h": 20}, "active": true, "note": null})";
+    }
+    return text+"]}";
+}
+
+std::string makeDoubles(int count)
+{
+    std::mt19937_64 random(42);
+    std::uniform_real_distribution<double> distribution(-1e6, 1e6);
+    std::string text = R"({"values": [)";
+    char buffer[32];
+    for (int i = 0; i<count; i++) {
+        snprintf(buffer, sizeof(buffer), "%.17g", distribution(random));
+        text += (i==0 ? "" : ", ")+std::string(buffer);
+    }
+    return text+"]}";
+}
+
+std::string makeStrings(int count)
+{
+    std::string text = R"({"strings": [)";
+    for (int i = 0; i<count; i++) {
+        text += (i==0 ? "" : ", ")+std::string(R"("a somewhat longer string value without escapes )")
+                +std::to_string(i)+(i%10==0 ? R"( with \"quotes\" and a\nnewline")" : "\"");
+    }
+    return text+"]}";
+}
+
+double measure(JsonSerializer& serializer, const JsonParser& parser, size_t& bytes)
+{
+    const int repetitions = 10;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i<repetitions; i++)
+        bytes = serializer.serialize(parser).size();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+    return static_cast<double>(bytes)*repetitions/seconds/1e6;
+}
+
+}
+
+int main()
+{
+    JsonSerializer compact;
+    JsonSerializer pretty(2);
+    JsonParser parser;
+    size_t bytes = 0;
+
+    parser.parseString(makeMixed(200000));
+    double throughput = measure(compact, parser, bytes);
+    std::cout << "mixed, compact:\t" << throughput << " MB/s (" << bytes << " bytes)\n";
+    throughput = measure(pretty, parser, bytes);
+    std::cout << "mixed, indented:\t" << throughput << " MB/s (" << bytes << " bytes)\n";
+
+    auto start = std::chrono::steady_clock::now();
+    bytes = 0;
+    {
+        JsonWriter writer([&bytes](const char*, size_t length) { bytes += length; });
+        writer.beginObject().key("records").beginArray();
+        for (int i = 0; i<200000; i++) {
+            writer.beginObject().key("id").value(i).key("name").value("item "+std::to_string(i))
+                  .key("price").value(i%1000*0.25).key("tags").beginArray().value("a").value("b").value("c").endArray()
+                  .key("size").beginObject().key("w").value(10).key("h").value(20).endObject()
+                  .key("active").value(true).key("note").null().endObject();
+        }
+        writer.endArray().endObject().finish();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+    std::cout << "mixed, JsonWriter:\t" << static_cast<double>(bytes)/seconds/1e6 << " MB/s (" << bytes << " bytes)\n";
+
+    parser.parseString(makeDoubles(1000000));
+    throughput = measure(compact, parser, bytes);
+    std::cout << "doubles:\t" << throughput << " MB/s (" << bytes << " bytes)\n";
+    JsonValue& values = parser["values"];
+    start = std::chrono::steady_clock::now();
+    std::string text;
+    char buffer[32];
+    for (const JsonValue* value : values.getArrayValue()) {
+        int length = snprintf(buffer, sizeof(buffer), "%.17g,", value->getNumberValue());
+        text.append(buffer, static_cast<size_t>(length));
+    }
+    seconds = std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+    std::cout << "doubles, printf(\"%.17g\"):\t" << static_cast<double>(text.size())/seconds/1e6 << " MB/s ("
+              << text.size() << " bytes)\n";
+
+    parser.parseString(makeStrings(500000));
+    throughput = measure(compact, parser, bytes);
+    std::cout << "strings:\t" << throughput << " MB/s (" << bytes << " bytes)\n";
+    return 0;
+}
@@ -0,0 +1,86 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include "../jsonStructural.h"
+#include "../jsonTape.h"
+#include "../jsonReader.h"
+#include "../jsonPushParser.h"
+
+/**
+ * Measures the throughput of the structural index for every implementation the CPU supports,
+ * and of reading the same text without building anything, in chunks, to a tape and to JsonValues.
+ */
+
+namespace {
+
+std::string makeDocument(int records)
+{
+    std::string text = "{\n\t\"records\": [";
+    for (int i = 0; i<records; i++) {
+        if (i>0)
+            text += ",";
+        text += R"(
+		{"id": )"+std::to_string(i)+R"(, "name": "record \"number\" )"+std::to_string(i)
+                +R"(", "valid": true, "parent": null, "scores": [0.5, 12, -3.25e2]})";
+    }
+    text += "\n\t]\n}";
+    return text;
+}
+
+double megabytesPerSecond(size_t bytes, int repetitions, std::chrono::steady_clock::time_point start)
+{
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+    return static_cast<double>(bytes)*repetitions/seconds/1e6;
+}
+
+}
+
+int main()
+{
+    const int repetitions = 20;
+    std::string text = makeDocument(100000);
+    std::cout << "document size: " << text.size() << " bytes\n";
+
+    const char* names[] = {"auto", "scalar", "sse2", "avx2"};
+    for (auto implementation : {JsonStructuralIndex::SCALAR, JsonStructuralIndex::SSE2, JsonStructuralIndex::AVX2}) {
+        if (!JsonStructuralIndex::isSupported(implementation))
+            continue;
+        JsonStructuralIndex index;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i<repetitions; i++)
+            index.build(text.data(), text.size(), implementation);
+        std::cout << "index " << names[implementation] << ":\t" << megabytesPerSecond(text.size(), repetitions, start)
+                  << " MB/s\n";
+    }
+
+    JsonReader reader;
+    JsonHandler ignore;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i<repetitions; i++)
+        reader.parseString(text, ignore);
+    std::cout << "events only:\t" << megabytesPerSecond(text.size(), repetitions, start) << " MB/s\n";
+
+    JsonPushParser pushParser(ignore);
+    const size_t chunkSize = 64*1024;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i<repetitions; i++) {
+        for (size_t offset = 0; offset<text.size(); offset += chunkSize)
+            pushParser.feed(text.data()+offset, std::min(chunkSize, text.size()-offset));
+        pushParser.finish();
+    }
+    std::cout << "push events (64KB chunks):\t" << megabytesPerSecond(text.size(), repetitions, start) << " MB/s\n";
+
+    JsonTape tape;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i<repetitions; i++)
+        tape.parseString(text);
+    std::cout << "tape parse:\t" << megabytesPerSecond(text.size(), repetitions, start) << " MB/s\n";
+
+    JsonParser parser;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i<repetitions; i++)
+        parser.parseString(text);
+    std::cout << "JsonValue parse:\t" << megabytesPerSecond(text.size(), repetitions, start) << " MB/s\n";
+    return 0;
+}
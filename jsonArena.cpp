@@ -0,0 +1,80 @@
+#include <cstring>
+#include <algorithm>
+#include "jsonArena.h"
+
+namespace {
+
+const size_t FIRST_BLOCK_SIZE = 4096;           /**< Size of the first block of an arena*/
+const size_t MAX_BLOCK_SIZE = 1024*1024;        /**< Blocks stop growing at this size*/
+
+}
+
+JsonArena::JsonArena()
+        :head(nullptr), cleanups(nullptr), current(nullptr), end(nullptr), nextBlockSize(FIRST_BLOCK_SIZE),
+         blocks(0), used(0)
+{
+
+}
+
+JsonArena::~JsonArena()
+{
+    release();
+}
+
+JsonArena::JsonArena(JsonArena&& other) noexcept
+        :head(other.head), cleanups(other.cleanups), current(other.current), end(other.end),
+         nextBlockSize(other.nextBlockSize), blocks(other.blocks), used(other.used)
+{
+    other.head = nullptr;
+    other.cleanups = nullptr;
+    other.current = nullptr;
+    other.end = nullptr;
+    other.nextBlockSize = FIRST_BLOCK_SIZE;
+    other.blocks = 0;
+    other.used = 0;
+}
+
+void JsonArena::grow(size_t size, size_t alignment)
+{
+    size_t needed = size+alignment;
+    size_t blockSize = std::max(nextBlockSize, needed);
+    if (nextBlockSize<MAX_BLOCK_SIZE)
+        nextBlockSize *= 2;
+
+    auto* block = static_cast<Block*>(::operator new(sizeof(Block)+blockSize));
+    block->next = head;
+    block->size = blockSize;
+    head = block;
+    blocks++;
+
+    current = reinterpret_cast<char*>(block+1);
+    end = current+blockSize;
+}
+
+char* JsonArena::copyString(const char* data, size_t length)
+{
+    auto* result = static_cast<char*>(allocate(length+1, 1));
+    if (length>0)
+        memcpy(result, data, length);
+    result[length] = '\0';
+    return result;
+}
+
+void JsonArena::release()
+{
+    // Cleanups are stored in the blocks, so they need to run first
+    for (Cleanup* cleanup = cleanups; cleanup!=nullptr; cleanup = cleanup->next)
+        cleanup->destroy(cleanup->object);
+    cleanups = nullptr;
+
+    while (head!=nullptr) {
+        Block* next = head->next;
+        ::operator delete(head);
+        head = next;
+    }
+    current = nullptr;
+    end = nullptr;
+    nextBlockSize = FIRST_BLOCK_SIZE;
+    blocks = 0;
+    used = 0;
+}
@@ -0,0 +1,235 @@
+#ifndef JSONPARSER_JSONARENA_H
+#define JSONPARSER_JSONARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+ * Monotonic allocator that owns all memory of a parsed document.
+ * Memory is handed out from large blocks and is never freed on its own. Releasing the arena
+ * frees all blocks at once, destructors of the allocated objects are not called.
+ * Objects that do need destruction (ex. values allocated with new) can be registered with own().
+ */
+class JsonArena {
+private:
+    /**
+     * Header of a block of memory, the usable memory follows the header.
+     */
+    struct Block {
+        Block* next;    /**< Previously allocated block*/
+        size_t size;    /**< Usable size of the block*/
+    };
+
+    /**
+     * Registered object that needs to be destructed when the arena is released.
+     */
+    struct Cleanup {
+        Cleanup* next;              /**< Previously registered cleanup*/
+        void (* destroy)(void*);    /**< Function that destructs the object*/
+        void* object;               /**< Object to destruct*/
+    };
+
+    Block* head;            /**< Most recently allocated block*/
+    Cleanup* cleanups;      /**< Most recently registered cleanup*/
+    char* current;          /**< Next free byte in the head block*/
+    char* end;              /**< End of the head block*/
+    size_t nextBlockSize;   /**< Size of the next block that will be allocated*/
+    size_t blocks;          /**< Amount of allocated blocks*/
+    size_t used;            /**< Amount of bytes handed out, without alignment padding*/
+
+    /**
+     * Allocates a new block that can hold at least size bytes with the given alignment.
+     * @param size Minimum amount of bytes the block needs to hold.
+     * @param alignment Alignment of the allocation.
+     */
+    void grow(size_t size, size_t alignment);
+
+public:
+
+    /**
+     * Default constructor. No memory is allocated until the first allocation.
+     */
+    JsonArena();
+
+    /**
+     * Destructor, releases all memory.
+     * @related release()
+     */
+    ~JsonArena();
+
+    /**
+     * Move constructor. The other arena will be empty.
+     * @param other Arena to take the memory from.
+     */
+    JsonArena(JsonArena&& other) noexcept;
+
+    /**
+     * Deleted copy constructor. Copying is not allowed.
+     */
+    JsonArena(const JsonArena&) = delete;
+
+    /**
+     * Deleted assignment operator. Assigning is not allowed.
+     */
+    JsonArena& operator=(const JsonArena&) = delete;
+
+    /**
+     * Allocate uninitialized memory.
+     * @param size Amount of bytes to allocate.
+     * @param alignment Alignment of the memory, must be a power of two.
+     * @return Pointer to the memory, valid until the arena is released.
+     */
+    void* allocate(size_t size, size_t alignment = alignof(std::max_align_t))
+    {
+        uintptr_t address = (reinterpret_cast<uintptr_t>(current)+alignment-1) & ~(alignment-1);
+        if (current==nullptr || address+size>reinterpret_cast<uintptr_t>(end)) {
+            grow(size, alignment);
+            address = (reinterpret_cast<uintptr_t>(current)+alignment-1) & ~(alignment-1);
+        }
+        current = reinterpret_cast<char*>(address+size);
+        used += size;
+        return reinterpret_cast<void*>(address);
+    }
+
+    /**
+     * Construct an object in the arena.
+     * The destructor of the object will not be called when the arena is released.
+     * @param args Arguments for the constructor.
+     * @return Pointer to the new object.
+     */
+    template<class T, class... Args>
+    T* create(Args&& ... args)
+    {
+        return new(allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+    /**
+     * Copy a string into the arena. The copy is null terminated.
+     * @param data Characters to copy.
+     * @param length Amount of characters to copy.
+     * @return Pointer to the copy.
+     */
+    char* copyString(const char* data, size_t length);
+
+    /**
+     * Register a heap object that should be deleted when the arena is released.
+     * @param object Object allocated with new.
+     */
+    template<class T>
+    void own(T* object)
+    {
+        auto* cleanup = create<Cleanup>();
+        cleanup->next = cleanups;
+        cleanup->destroy = [](void* o) { delete static_cast<T*>(o); };
+        cleanup->object = object;
+        cleanups = cleanup;
+    }
+
+    /**
+     * Free all memory at once. Everything allocated in the arena becomes invalid.
+     */
+    void release();
+
+    /**
+     * Get the amount of blocks the arena allocated from the heap.
+     * @return Amount of blocks.
+     */
+    size_t blockCount() const
+    {
+        return blocks;
+    }
+
+    /**
+     * Get the amount of bytes that were allocated from the arena.
+     * @return Amount of bytes, without alignment padding and unused space at the end of the blocks.
+     */
+    size_t bytesUsed() const
+    {
+        return used;
+    }
+};
+
+/**
+ * Standard library allocator that allocates from a JsonArena.
+ * An allocator without arena falls back to the heap, so containers using it can live on their own too.
+ * Copies of containers are always allocated on the heap, so they can outlive the arena.
+ */
+template<class T>
+class ArenaAllocator {
+private:
+    JsonArena* m_arena;     /**< Arena to allocate from, nullptr to use the heap*/
+
+    template<class U> friend class ArenaAllocator;
+
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    /**
+     * Creates an allocator.
+     * @param arena Arena to allocate from, nullptr to use the heap.
+     */
+    ArenaAllocator(JsonArena* arena = nullptr) noexcept // NOLINT
+            :m_arena(arena)
+    {
+
+    }
+
+    /**
+     * Converting copy constructor, used by containers to allocate their internal types.
+     * @param other Allocator to copy the arena from.
+     */
+    template<class U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept // NOLINT
+            :m_arena(other.m_arena)
+    {
+
+    }
+
+    T* allocate(size_t n)
+    {
+        if (m_arena==nullptr)
+            return static_cast<T*>(::operator new(n*sizeof(T)));
+        return static_cast<T*>(m_arena->allocate(n*sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* p, size_t) noexcept
+    {
+        // Arena memory is only freed when the arena is released
+        if (m_arena==nullptr)
+            ::operator delete(p);
+    }
+
+    ArenaAllocator select_on_container_copy_construction() const
+    {
+        return ArenaAllocator();
+    }
+
+    /**
+     * Get the arena of this allocator.
+     * @return The arena, nullptr if the allocator uses the heap.
+     */
+    JsonArena* arena() const
+    {
+        return m_arena;
+    }
+
+    template<class U>
+    bool operator==(const ArenaAllocator<U>& other) const
+    {
+        return m_arena==other.m_arena;
+    }
+
+    template<class U>
+    bool operator!=(const ArenaAllocator<U>& other) const
+    {
+        return m_arena!=other.m_arena;
+    }
+};
+
+#endif //JSONPARSER_JSONARENA_H
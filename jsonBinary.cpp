@@ -0,0 +1,413 @@
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+#include "jsonBinary.h"
+#include "jsonValueBuilder.h"
+
+const uint32_t JsonBinary::VERSION;
+
+namespace {
+
+const char MAGIC[4] = {'E', 'J', 'S', 'B'};
+
+/**
+ * Hash of a JsonStringView for the string table.
+ */
+struct ViewHash {
+    size_t operator()(JsonStringView view) const
+    {
+        return JsonObject::hash(view);
+    }
+};
+
+/**
+ * Append a little endian integer to a buffer.
+ */
+template<class T>
+void appendLittleEndian(std::string& buffer, T value)
+{
+    char bytes[sizeof(T)];
+    for (size_t i = 0; i<sizeof(T); i++)
+        bytes[i] = static_cast<char>(value >> (8*i));
+    buffer.append(bytes, sizeof(T));
+}
+
+/**
+ * Reads little endian integers, every read checks that the data is long enough.
+ */
+class Decoder {
+public:
+    Decoder(const char* data, size_t length)
+            :position(reinterpret_cast<const unsigned char*>(data)),
+             end(reinterpret_cast<const unsigned char*>(data)+length)
+    {
+    }
+
+    size_t remaining() const
+    {
+        return static_cast<size_t>(end-position);
+    }
+
+    uint8_t readByte()
+    {
+        need(1);
+        return *position++;
+    }
+
+    uint32_t readUInt32()
+    {
+        return read<uint32_t>();
+    }
+
+    uint64_t readUInt64()
+    {
+        return read<uint64_t>();
+    }
+
+    /**
+     * Read the amount of members or elements of a container. Every member or element takes at least one byte,
+     * so a corrupt count can not make a builder reserve more than the data.
+     */
+    uint32_t readCount()
+    {
+        uint32_t count = readUInt32();
+        if (count>remaining())
+            throw std::invalid_argument("Invalid binary json: unexpected end of data");
+        return count;
+    }
+
+    const char* readBytes(size_t length)
+    {
+        need(length);
+        const char* start = reinterpret_cast<const char*>(position);
+        position += length;
+        return start;
+    }
+
+private:
+    const unsigned char* position;  /**< Next byte to read*/
+    const unsigned char* end;       /**< End of the data*/
+
+    void need(size_t length) const
+    {
+        if (remaining()<length)
+            throw std::invalid_argument("Invalid binary json: unexpected end of data");
+    }
+
+    template<class T>
+    T read()
+    {
+        need(sizeof(T));
+        T value = 0;
+        for (size_t i = 0; i<sizeof(T); i++)
+            value |= static_cast<T>(position[i]) << (8*i);
+        position += sizeof(T);
+        return value;
+    }
+};
+
+/**
+ * Object or array whose members are being decoded.
+ */
+struct Container {
+    uint32_t remaining;     /**< Members or elements that are not decoded yet*/
+    bool object;            /**< True for an object, false for an array*/
+};
+
+/**
+ * Forwards the decoded values to a JsonHandler, the amounts of members and elements are not used.
+ */
+struct HandlerBuilder {
+    JsonHandler& handler;   /**< Receives the events*/
+
+    void startObject(uint32_t)
+    {
+        handler.startObject();
+    }
+
+    void key(JsonStringView key)
+    {
+        handler.key(key);
+    }
+
+    void endObject()
+    {
+        handler.endObject();
+    }
+
+    void startArray(uint32_t)
+    {
+        handler.startArray();
+    }
+
+    void endArray()
+    {
+        handler.endArray();
+    }
+
+    void string(JsonStringView value)
+    {
+        handler.string(value);
+    }
+
+    void number(const JsonNumber& value)
+    {
+        handler.number(value);
+    }
+
+    void boolean(bool value)
+    {
+        handler.boolean(value);
+    }
+
+    void null()
+    {
+        handler.null();
+    }
+};
+
+}
+
+/**
+ * Encodes values and interns their strings. The values and the string table are kept apart
+ * because the table is written first.
+ */
+class JsonBinary::Encoder {
+public:
+    std::string values;                     /**< Encoded root object*/
+    std::vector<JsonStringView> strings;    /**< Distinct strings in order of their index*/
+
+    void writeByte(uint8_t byte)
+    {
+        values += static_cast<char>(byte);
+    }
+
+    void writeUInt64(uint64_t value)
+    {
+        appendLittleEndian(values, value);
+    }
+
+    void writeCount(size_t count)
+    {
+        if (count>UINT32_MAX)
+            throw std::length_error("Too many values for: JsonBinary");
+        appendLittleEndian(values, static_cast<uint32_t>(count));
+    }
+
+    void writeString(JsonStringView string)
+    {
+        auto found = indices.find(string);
+        if (found==indices.end()) {
+            if (strings.size()>=UINT32_MAX)
+                throw std::length_error("Too many strings for: JsonBinary");
+            found = indices.emplace(string, static_cast<uint32_t>(strings.size())).first;
+            strings.push_back(string);
+        }
+        appendLittleEndian(values, found->second);
+    }
+
+private:
+    std::unordered_map<JsonStringView, uint32_t, ViewHash> indices;  /**< Index of every distinct string*/
+};
+
+std::string JsonBinary::encode(const JsonObject& root)
+{
+    Encoder encoder;
+    encodeObject(encoder, root);
+
+    size_t tableSize = 4;
+    for (JsonStringView string : encoder.strings)
+        tableSize += 4+string.size();
+    std::string result;
+    result.reserve(sizeof(MAGIC)+4+tableSize+encoder.values.size());
+    result.append(MAGIC, sizeof(MAGIC));
+    appendLittleEndian(result, VERSION);
+    appendLittleEndian(result, static_cast<uint32_t>(encoder.strings.size()));
+    for (JsonStringView string : encoder.strings) {
+        if (string.size()>UINT32_MAX)
+            throw std::length_error("String too long for: JsonBinary");
+        appendLittleEndian(result, static_cast<uint32_t>(string.size()));
+        result.append(string.data(), string.size());
+    }
+    result += encoder.values;
+    return result;
+}
+
+void JsonBinary::save(const JsonObject& root, const std::string& file_name)
+{
+    std::string snapshot = encode(root);
+    std::ofstream file(file_name, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+        throw std::invalid_argument("Can not write file '"+file_name+'\'');
+    file.write(snapshot.data(), static_cast<std::streamsize>(snapshot.size()));
+    file.close();
+    if (file.fail())
+        throw std::invalid_argument("Can not write file '"+file_name+'\'');
+}
+
+void JsonBinary::encodeObject(Encoder& encoder, const JsonObject& object)
+{
+    encoder.writeByte(OBJECT);
+    encoder.writeCount(object.size());
+    for (const auto& member : object) {
+        encoder.writeString(member.first);
+        encodeValue(encoder, *member.second);
+    }
+}
+
+void JsonBinary::encodeValue(Encoder& encoder, const JsonValue& value)
+{
+    switch (value.type()) {
+    case JSON_NULL:
+        encoder.writeByte(NULL_VALUE);
+        return;
+    case JSON_BOOL:
+        encoder.writeByte(value.getBoolValue() ? TRUE_VALUE : FALSE_VALUE);
+        return;
+    case JSON_INT:
+        encoder.writeByte(INT);
+        encoder.writeUInt64(static_cast<uint64_t>(value.getInt64Value()));
+        return;
+    case JSON_UINT:
+        encoder.writeByte(UINT);
+        encoder.writeUInt64(value.getUInt64Value());
+        return;
+    case JSON_NUM: {
+        double number = value.getNumberValue();
+        uint64_t bits;
+        memcpy(&bits, &number, sizeof(bits));
+        encoder.writeByte(DOUBLE);
+        encoder.writeUInt64(bits);
+        return;
+    }
+    case JSON_STRING:
+        encoder.writeByte(STRING);
+        encoder.writeString(value.getStringView());
+        return;
+    case JSON_ARRAY: {
+        const JsonArray& array = value.getArrayValue();
+        encoder.writeByte(ARRAY);
+        encoder.writeCount(array.size());
+        for (const JsonValue* element : array)
+            encodeValue(encoder, *element);
+        return;
+    }
+    case JSON_OBJ:
+        encodeObject(encoder, value.getObjectValue());
+        return;
+    }
+}
+
+void JsonBinary::decode(const char* data, size_t length, JsonHandler& handler)
+{
+    HandlerBuilder builder{handler};
+    decode(data, length, builder);
+}
+
+JsonObject* JsonBinary::load(const char* data, size_t length, JsonArena& arena)
+{
+    // The amounts of members and elements are known before they are decoded, so every object and array is
+    // allocated once with its final size
+    JsonValueBuilder builder(arena);
+    decode(data, length, builder);
+    return &builder.value()->getObjectValue();
+}
+
+template<class Builder>
+void JsonBinary::decode(const char* data, size_t length, Builder& builder)
+{
+    Decoder decoder(data, length);
+    if (memcmp(decoder.readBytes(sizeof(MAGIC)), MAGIC, sizeof(MAGIC))!=0)
+        throw std::invalid_argument("Invalid binary json: missing header");
+    if (decoder.readUInt32()!=VERSION)
+        throw std::invalid_argument("Invalid binary json: unsupported version");
+
+    // Every string takes at least its length, so a corrupt count can not reserve more than the data
+    uint32_t stringCount = decoder.readUInt32();
+    if (stringCount>decoder.remaining()/4)
+        throw std::invalid_argument("Invalid binary json: unexpected end of data");
+    std::vector<JsonStringView> strings;
+    strings.reserve(stringCount);
+    for (uint32_t i = 0; i<stringCount; i++) {
+        uint32_t size = decoder.readUInt32();
+        strings.emplace_back(decoder.readBytes(size), size);
+    }
+    auto readString = [&decoder, &strings]() {
+        uint32_t index = decoder.readUInt32();
+        if (index>=strings.size())
+            throw std::invalid_argument("Invalid binary json: string index out of range");
+        return strings[index];
+    };
+
+    if (decoder.readByte()!=OBJECT)
+        throw std::invalid_argument("Invalid binary json: the root is not an object");
+    std::vector<Container> open;
+    open.push_back({decoder.readCount(), true});
+    builder.startObject(open.back().remaining);
+
+    // Nested values are decoded with a stack instead of recursion, so deep nesting can not overflow the stack
+    while (!open.empty()) {
+        Container& container = open.back();
+        if (container.remaining==0) {
+            if (container.object)
+                builder.endObject();
+            else
+                builder.endArray();
+            open.pop_back();
+            continue;
+        }
+        container.remaining--;
+        if (container.object)
+            builder.key(readString());
+
+        uint8_t tag = decoder.readByte();
+        switch (tag) {
+        case NULL_VALUE:
+            builder.null();
+            break;
+        case FALSE_VALUE:
+        case TRUE_VALUE:
+            builder.boolean(tag==TRUE_VALUE);
+            break;
+        case INT: {
+            JsonNumber number{};
+            number.kind = JsonNumber::INT;
+            number.int_value = static_cast<int64_t>(decoder.readUInt64());
+            builder.number(number);
+            break;
+        }
+        case UINT: {
+            JsonNumber number{};
+            number.kind = JsonNumber::UINT;
+            number.uint_value = decoder.readUInt64();
+            builder.number(number);
+            break;
+        }
+        case DOUBLE: {
+            JsonNumber number{};
+            number.kind = JsonNumber::DOUBLE;
+            uint64_t bits = decoder.readUInt64();
+            memcpy(&number.double_value, &bits, sizeof(bits));
+            builder.number(number);
+            break;
+        }
+        case STRING:
+            builder.string(readString());
+            break;
+        case ARRAY:
+            open.push_back({decoder.readCount(), false});
+            builder.startArray(open.back().remaining);
+            break;
+        case OBJECT:
+            open.push_back({decoder.readCount(), true});
+            builder.startObject(open.back().remaining);
+            break;
+        default:
+            throw std::invalid_argument("Invalid binary json: unknown type "+std::to_string(tag));
+        }
+    }
+    if (decoder.remaining()!=0)
+        throw std::invalid_argument("Invalid binary json: data after the root object");
+}
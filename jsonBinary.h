@@ -0,0 +1,109 @@
+#ifndef JSONPARSER_JSONBINARY_H
+#define JSONPARSER_JSONBINARY_H
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include "jsonParser.h"
+
+/**
+ * Compact binary snapshot of a document, to load a large document again without parsing its text.
+ * All integers are little endian, the layout is:
+ * - header: the characters "EJSB" and the uint32 VERSION
+ * - string table: the uint32 amount of strings, then every distinct key and string value as its uint32 length
+ *   followed by its characters
+ * - the root object, encoded as a value: one Tag byte and its payload. INT, UINT and DOUBLE have 8 bytes,
+ *   STRING has the uint32 index of the string in the table. ARRAY has the uint32 amount of elements followed by
+ *   the elements, OBJECT the uint32 amount of members followed by the uint32 index of the key and the value of
+ *   every member. NULL_VALUE, TRUE_VALUE and FALSE_VALUE have no payload.
+ * Decoding does not tokenize, unescape or convert numbers, it copies the bytes and checks every length and index
+ * against the size of the data, so a truncated or corrupt snapshot throws instead of reading past its end.
+ * parser.save("config.ejsb");
+ * parser.loadBinary("config.ejsb");
+ */
+class JsonBinary {
+public:
+
+    static const uint32_t VERSION = 1;      /**< Version of the layout, snapshots of other versions are rejected*/
+
+    /**
+     * Type byte in front of every value.
+     */
+    enum Tag : uint8_t {
+        NULL_VALUE,
+        FALSE_VALUE,
+        TRUE_VALUE,
+        INT,
+        UINT,
+        DOUBLE,
+        STRING,
+        ARRAY,
+        OBJECT
+    };
+
+    /**
+     * Encode a document.
+     * @param root Root object of the document.
+     * @return The snapshot.
+     */
+    static std::string encode(const JsonObject& root);
+
+    /**
+     * Encode a document and write it to a file, an existing file is overwritten.
+     * @throw invalid argument if the file can not be written.
+     * @param root Root object of the document.
+     * @param file_name Path of the file.
+     */
+    static void save(const JsonObject& root, const std::string& file_name);
+
+    /**
+     * Decode a snapshot into the events of a handler, like a JsonReader does for json text.
+     * The views given to the handler point into the data.
+     * @throw invalid argument if the data is not a valid snapshot.
+     * @param data Start of the snapshot.
+     * @param length Size of the snapshot in bytes.
+     * @param handler Receives the events.
+     */
+    static void decode(const char* data, size_t length, JsonHandler& handler);
+
+    /**
+     * Decode a snapshot into JsonValues in an arena. Every object and array is allocated with its final size.
+     * Values that were decoded before an error stay in the arena.
+     * @throw invalid argument if the data is not a valid snapshot.
+     * @param data Start of the snapshot.
+     * @param length Size of the snapshot in bytes.
+     * @param arena Arena of the values, the strings are copied to it.
+     * @return The root object, allocated in the arena.
+     */
+    static JsonObject* load(const char* data, size_t length, JsonArena& arena);
+
+private:
+
+    class Encoder;
+
+    /**
+     * Encode an object and all values nested in it.
+     * @param encoder Receives the encoded object.
+     * @param object The object.
+     */
+    static void encodeObject(Encoder& encoder, const JsonObject& object);
+
+    /**
+     * Encode a value and all values nested in it.
+     * @param encoder Receives the encoded value.
+     * @param value The value.
+     */
+    static void encodeValue(Encoder& encoder, const JsonValue& value);
+
+    /**
+     * Decode a snapshot into the calls of a builder, which gets the amount of members and elements
+     * with startObject and startArray.
+     * @param data Start of the snapshot.
+     * @param length Size of the snapshot in bytes.
+     * @param builder Receives the values.
+     */
+    template<class Builder>
+    static void decode(const char* data, size_t length, Builder& builder);
+};
+
+#endif //JSONPARSER_JSONBINARY_H
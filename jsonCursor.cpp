@@ -0,0 +1,320 @@
+#include <algorithm>
+#include <cstring>
+#include "jsonCursor.h"
+
+namespace {
+
+bool isWhiteSpace(char c)
+{
+    return c==' ' || c=='\t' || c=='\n' || c=='\r';
+}
+
+int hexValue(char c)
+{
+    if (c>='0' && c<='9')
+        return c-'0';
+    if (c>='a' && c<='f')
+        return c-'a'+10;
+    if (c>='A' && c<='F')
+        return c-'A'+10;
+    return -1;
+}
+
+void appendUtf8(std::string& result, unsigned long codePoint)
+{
+    if (codePoint<0x80) {
+        result += static_cast<char>(codePoint);
+    }
+    else if (codePoint<0x800) {
+        result += static_cast<char>(0xC0 | (codePoint >> 6));
+        result += static_cast<char>(0x80 | (codePoint & 0x3F));
+    }
+    else if (codePoint<0x10000) {
+        result += static_cast<char>(0xE0 | (codePoint >> 12));
+        result += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        result += static_cast<char>(0x80 | (codePoint & 0x3F));
+    }
+    else {
+        result += static_cast<char>(0xF0 | (codePoint >> 18));
+        result += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+        result += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        result += static_cast<char>(0x80 | (codePoint & 0x3F));
+    }
+}
+
+}
+
+JsonCursor::JsonCursor(const char* data, size_t length, int firstLine)
+        :begin(data), current(data), end(data+length), structuralBegin(nullptr), structural(nullptr),
+         structuralEnd(nullptr), firstLine(firstLine)
+{
+
+}
+
+void JsonCursor::useStructuralIndex(const JsonStructuralIndex& index)
+{
+    structuralBegin = index.positions().data();
+    structural = structuralBegin;
+    structuralEnd = structural+index.positions().size();
+    syncStructural();
+}
+
+void JsonCursor::moveTo(const char* position)
+{
+    if (structural!=nullptr && position<current)
+        structural = structuralBegin;
+    current = position;
+}
+
+void JsonCursor::skipWhiteSpace()
+{
+    if (structural!=nullptr) {
+        // Only whitespace can be between the cursor and the next structural position
+        syncStructural();
+        current = structural<structuralEnd ? begin+*structural : end;
+        return;
+    }
+    while (current<end && isWhiteSpace(*current))
+        ++current;
+}
+
+bool JsonCursor::expectChar(char c)
+{
+    if (current<end && *current==c) {
+        ++current;
+        return true;
+    }
+    return false;
+}
+
+bool JsonCursor::expectLiteral(const char* literal, size_t length)
+{
+    if (static_cast<size_t>(end-current)<length || memcmp(current, literal, length)!=0)
+        return false;
+    current += length;
+    return true;
+}
+
+bool JsonCursor::atValueEnd() const
+{
+    if (current>=end)
+        return true;
+    char c = *current;
+    return isWhiteSpace(c) || c==',' || c=='}' || c==']';
+}
+
+void JsonCursor::readQuotedString(std::string& result)
+{
+    char quoteChar = *current;
+    ++current;
+
+    result.clear();
+    if (structural!=nullptr && quoteChar=='"') {
+        // The closing quote is the next structural position, strings without escapes are copied at once
+        syncStructural();
+        if (structural<structuralEnd) {
+            const char* closing = begin+*structural;
+            if (memchr(current, '\\', static_cast<size_t>(closing-current))==nullptr) {
+                result.assign(current, closing);
+                current = closing+1;
+                return;
+            }
+        }
+    }
+    while (true) {
+        // Copy everything up to the next special character at once
+        const char* start = current;
+        while (current<end && *current!=quoteChar && *current!='\\' && *current!='\n')
+            ++current;
+        result.append(start, current);
+
+        if (current>=end || *current=='\n')
+            throw error("Missing closing "+std::string(1, quoteChar));
+        if (*current==quoteChar) {
+            ++current;
+            return;
+        }
+
+        // Escape sequence
+        ++current;
+        if (current>=end)
+            throw error("Missing closing "+std::string(1, quoteChar));
+        char escaped = *current++;
+        switch (escaped) {
+        case '"':
+        case '\'':
+        case '\\':
+        case '/':
+            result += escaped;
+            break;
+        case 'b':
+            result += '\b';
+            break;
+        case 'f':
+            result += '\f';
+            break;
+        case 'n':
+            result += '\n';
+            break;
+        case 'r':
+            result += '\r';
+            break;
+        case 't':
+            result += '\t';
+            break;
+        case 'u': {
+            auto readHex = [&]() {
+                if (end-current<4)
+                    throw error("Invalid unicode escape");
+                unsigned long value = 0;
+                for (int i = 0; i<4; i++) {
+                    int digit = hexValue(current[i]);
+                    if (digit<0)
+                        throw error("Invalid unicode escape");
+                    value = (value << 4) | static_cast<unsigned long>(digit);
+                }
+                current += 4;
+                return value;
+            };
+            unsigned long codePoint = readHex();
+            // Combine surrogate pairs into a single code point
+            if (codePoint>=0xD800 && codePoint<=0xDBFF && end-current>=2 && current[0]=='\\' && current[1]=='u') {
+                current += 2;
+                unsigned long low = readHex();
+                if (low>=0xDC00 && low<=0xDFFF) {
+                    codePoint = 0x10000+((codePoint-0xD800) << 10)+(low-0xDC00);
+                }
+                else {
+                    appendUtf8(result, codePoint);
+                    codePoint = low;
+                }
+            }
+            appendUtf8(result, codePoint);
+            break;
+        }
+        default:
+            --current;
+            throw error("Invalid escape sequence '\\"+std::string(1, escaped)+"'");
+        }
+    }
+}
+
+JsonStringView JsonCursor::skipQuotedString()
+{
+    char quoteChar = *current;
+    const char* start = ++current;
+    if (structural!=nullptr && quoteChar=='"') {
+        // The closing quote is the next structural position
+        syncStructural();
+        if (structural<structuralEnd) {
+            current = begin+*structural;
+            JsonStringView result(start, static_cast<size_t>(current-start));
+            ++current;
+            return result;
+        }
+    }
+    while (true) {
+        while (current<end && *current!=quoteChar && *current!='\\' && *current!='\n')
+            ++current;
+        if (current>=end || *current=='\n')
+            throw error("Missing closing "+std::string(1, quoteChar));
+        if (*current==quoteChar)
+            break;
+        // Skip the backslash and the escaped character, escape sequences are validated when they are read
+        current = end-current>2 ? current+2 : end;
+    }
+    JsonStringView result(start, static_cast<size_t>(current-start));
+    ++current;
+    return result;
+}
+
+void JsonCursor::skipValue()
+{
+    char c = peek();
+    if (c=='"' || c=='\'') {
+        skipQuotedString();
+        return;
+    }
+    if (c!='{' && c!='[') {
+        // Literals and numbers end at the first character that may follow a value
+        const char* start = current;
+        while (!atValueEnd())
+            ++current;
+        if (current==start)
+            throw error("Unexpected token: '"+std::string(1, c)+"'");
+        return;
+    }
+
+    size_t depth = 0;
+    if (structural!=nullptr) {
+        // Brackets inside strings are not structural, so only the brackets of the index need to be counted
+        syncStructural();
+        for (; structural<structuralEnd; ++structural) {
+            char token = begin[*structural];
+            if (token=='{' || token=='[') {
+                depth++;
+            }
+            else if ((token=='}' || token==']') && --depth==0) {
+                current = begin+*structural+1;
+                ++structural;
+                return;
+            }
+        }
+        current = end;
+        throw ParseError(line(), "END OF FILE", c=='[' ? "Unbalanced []" : "Unbalanced {}");
+    }
+    while (current<end) {
+        switch (*current) {
+        case '"':
+        case '\'':
+            skipQuotedString();
+            continue;
+        case '{':
+        case '[':
+            depth++;
+            break;
+        case '}':
+        case ']':
+            if (--depth==0) {
+                ++current;
+                return;
+            }
+            break;
+        default:
+            break;
+        }
+        ++current;
+    }
+    throw ParseError(line(), "END OF FILE", c=='[' ? "Unbalanced []" : "Unbalanced {}");
+}
+
+void JsonCursor::readNumber(JsonNumber& result)
+{
+    const char* start = current;
+    const char* numberEnd = JsonNumber::parse(current, end, result);
+    if (numberEnd!=nullptr) {
+        current = numberEnd;
+        if (atValueEnd())
+            return;
+    }
+    current = start;
+    throw error("Incorrect number format");
+}
+
+int JsonCursor::line() const
+{
+    return static_cast<int>(std::count(begin, current, '\n'))+firstLine;
+}
+
+std::string JsonCursor::lineContent() const
+{
+    const char* lineEnd = current;
+    while (lineEnd<end && *lineEnd!='\n' && *lineEnd!='\r')
+        ++lineEnd;
+    return std::string(current, lineEnd);
+}
+
+ParseError JsonCursor::error(const std::string& message) const
+{
+    return ParseError(line(), lineContent(), message);
+}
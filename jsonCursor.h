@@ -0,0 +1,180 @@
+#ifndef JSONPARSER_JSONCURSOR_H
+#define JSONPARSER_JSONCURSOR_H
+
+#include <string>
+#include <cstddef>
+#include "jsonError.h"
+#include "jsonStringView.h"
+#include "jsonStructural.h"
+#include "jsonNumber.h"
+
+/**
+ * Read-only cursor over a contiguous buffer of json text.
+ * The cursor never modifies or copies the buffer, every operation only moves
+ * the current position forward. This keeps parsing linear in the size of the input.
+ */
+class JsonCursor {
+private:
+    const char* begin;      /**< Start of the buffer*/
+    const char* current;    /**< Current position in the buffer*/
+    const char* end;        /**< One past the last character of the buffer*/
+    const uint32_t* structuralBegin;    /**< First entry of the structural index, nullptr without index*/
+    const uint32_t* structural;     /**< Next entry of the structural index, nullptr without index*/
+    const uint32_t* structuralEnd;  /**< End of the structural index*/
+    int firstLine;          /**< Line of the first character of the buffer*/
+
+    /**
+     * Move the structural index to the first position at or after the cursor.
+     */
+    void syncStructural()
+    {
+        auto offset = static_cast<uint32_t>(current-begin);
+        while (structural<structuralEnd && *structural<offset)
+            ++structural;
+    }
+
+public:
+
+    /**
+     * Creates a cursor at the start of a buffer.
+     * @param data Start of the buffer, does not need to be null terminated.
+     * @param length Amount of characters in the buffer.
+     * @param firstLine Line of the first character, for buffers that are a part of a larger text.
+     */
+    JsonCursor(const char* data, size_t length, int firstLine = 1);
+
+    /**
+     * Let the cursor jump over whitespace and strings with a structural index of the buffer.
+     * The index must be built from the same buffer and must stay alive as long as the cursor.
+     * @param index Usable index of the buffer.
+     */
+    void useStructuralIndex(const JsonStructuralIndex& index);
+
+    /**
+     * Check whether the cursor reached the end of the buffer.
+     * @return True if there are no characters left.
+     */
+    bool atEnd() const
+    {
+        return current>=end;
+    }
+
+    /**
+     * Get the character at the current position without consuming it.
+     * @return The current character, or '\0' if the cursor is at the end.
+     */
+    char peek() const
+    {
+        return current<end ? *current : '\0';
+    }
+
+    /**
+     * Move the cursor forward.
+     * @param count Amount of characters to skip.
+     */
+    void advance(size_t count = 1)
+    {
+        current += count;
+    }
+
+    /**
+     * Get the current position in the buffer.
+     * @return Pointer to the current character.
+     */
+    const char* position() const
+    {
+        return current;
+    }
+
+    /**
+     * Move the cursor to any position in the buffer, ex. back to a value that was skipped before.
+     * @param position Position in the buffer.
+     */
+    void moveTo(const char* position);
+
+    /**
+     * Skip all whitespace characters (spaces, tabs, carriage returns and newlines).
+     * With a structural index, this is a jump to the next structural position.
+     */
+    void skipWhiteSpace();
+
+    /**
+     * Check whether the current character is c.
+     * If the expected character is found, it will be consumed.
+     * @param c Character we need to check for.
+     * @return True if the current character is c, else false.
+     */
+    bool expectChar(char c);
+
+    /**
+     * Check whether the buffer continues with a literal (ex. true, false, null).
+     * If the literal is found, it will be consumed.
+     * @param literal Literal to check for.
+     * @param length Length of the literal.
+     * @return True if the literal was found.
+     */
+    bool expectLiteral(const char* literal, size_t length);
+
+    /**
+     * Check whether the current character may follow a value.
+     * Values must be followed by whitespace, ',', '}', ']' or the end of the buffer.
+     * @return True if the current character ends a value.
+     */
+    bool atValueEnd() const;
+
+    /**
+     * Read a quoted string and consume it, including the quotes.
+     * The current character should be the quote character (' or ").
+     * Escape sequences are resolved, \\u escapes are encoded as UTF-8.
+     * @throw ParseError if the string is not terminated or contains an invalid escape sequence.
+     * @param result Buffer that receives the unquoted string, its capacity is reused.
+     */
+    void readQuotedString(std::string& result);
+
+    /**
+     * Skip a quoted string without resolving its escape sequences.
+     * The current character should be the quote character (' or ").
+     * @throw ParseError if the string is not terminated.
+     * @return The characters between the quotes, exactly as they are in the buffer.
+     */
+    JsonStringView skipQuotedString();
+
+    /**
+     * Skip a complete value without reading it.
+     * Objects and arrays are skipped by matching brackets, which only checks that the brackets are
+     * balanced and the strings are terminated. The contents are not validated.
+     * With a structural index, only the brackets of the index are visited instead of every character.
+     * @throw ParseError if there is no value at the cursor or the value is not terminated.
+     */
+    void skipValue();
+
+    /**
+     * Read a number and consume it.
+     * The current character should be a digit or '-'.
+     * @throw ParseError if the number is formatted incorrectly (ex. two dots)
+     * @param result Receives the number, integers that fit in 64 bits are kept exact.
+     */
+    void readNumber(JsonNumber& result);
+
+    /**
+     * Get the line of the current position. Lines are counted starting from 1.
+     * This is only meant for error reporting, it is linear in the amount of consumed characters.
+     * @return The current line.
+     */
+    int line() const;
+
+    /**
+     * Get the remainder of the current line, starting from the current position.
+     * @return The remaining characters of the current line.
+     */
+    std::string lineContent() const;
+
+    /**
+     * Create a parse error for the current position.
+     * @param message Message of the error.
+     * @return ParseError containing the line and the remainder of that line.
+     */
+    ParseError error(const std::string& message) const;
+};
+
+#endif //JSONPARSER_JSONCURSOR_H
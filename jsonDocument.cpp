@@ -0,0 +1,384 @@
+#include <cstring>
+#include <stdexcept>
+#include "jsonDocument.h"
+#include "jsonCursor.h"
+#include "jsonValueBuilder.h"
+
+namespace {
+
+bool isClosing(char c)
+{
+    return c=='}' || c==']';
+}
+
+}
+
+JsonDocument::JsonDocument()
+        :text(nullptr), length(0), rootObject(nullptr)
+{
+
+}
+
+JsonDocument::JsonDocument(const std::string& file_name)
+        :JsonDocument()
+{
+    parse(file_name);
+}
+
+void JsonDocument::parse(const std::string& file_name)
+{
+    clear();
+    source.open(file_name);
+    use(source.data(), source.size());
+}
+
+void JsonDocument::parse(const char* data, size_t size)
+{
+    clear();
+    use(data, size);
+}
+
+void JsonDocument::parseString(const std::string& json)
+{
+    clear();
+    copy = json;
+    use(copy.data(), copy.size());
+}
+
+void JsonDocument::use(const char* data, size_t size)
+{
+    JsonCursor cursor(data, size);
+    cursor.skipWhiteSpace();
+    if (!cursor.expectChar('{'))
+        throw cursor.error("Missing root '{'");
+    text = data;
+    length = size;
+    rootObject = cursor.position()-1;
+}
+
+void JsonDocument::clear()
+{
+    text = nullptr;
+    length = 0;
+    rootObject = nullptr;
+    copy.clear();
+    source.close();
+    resolved.clear();
+    materialized.clear();
+    arena.release();
+}
+
+JsonLazyValue JsonDocument::root() const
+{
+    if (rootObject==nullptr)
+        throw std::invalid_argument("JsonDocument is empty");
+    return JsonLazyValue(this, rootObject);
+}
+
+bool JsonDocument::hasKey(JsonStringView key) const
+{
+    return rootObject!=nullptr && root().hasKey(key);
+}
+
+JsonLazyValue JsonDocument::operator[](JsonStringView key) const
+{
+    const char* found = rootObject==nullptr ? nullptr : root().find(key);
+    if (found==nullptr)
+        throw std::invalid_argument("There is no such key '"+std::string(key)+"'");
+    return JsonLazyValue(this, found);
+}
+
+JsonCursor JsonDocument::cursorAt(const char* position) const
+{
+    JsonCursor cursor(text, length);
+    cursor.moveTo(position);
+    return cursor;
+}
+
+JsonStringView JsonDocument::resolveString(const char* quote) const
+{
+    auto found = resolved.find(quote);
+    if (found!=resolved.end())
+        return found->second;
+    std::string value;
+    cursorAt(quote).readQuotedString(value);
+    JsonStringView view(arena.copyString(value.data(), value.size()), value.size());
+    resolved.emplace(quote, view);
+    return view;
+}
+
+bool JsonLazyValue::isBool() const
+{
+    return *position=='t' || *position=='f';
+}
+
+bool JsonLazyValue::isNull() const
+{
+    return *position=='n';
+}
+
+bool JsonLazyValue::isString() const
+{
+    return *position=='"' || *position=='\'';
+}
+
+bool JsonLazyValue::isArray() const
+{
+    return *position=='[';
+}
+
+bool JsonLazyValue::isObject() const
+{
+    return *position=='{';
+}
+
+bool JsonLazyValue::isNumber() const
+{
+    return isdigit(static_cast<unsigned char>(*position)) || *position=='-';
+}
+
+bool JsonLazyValue::isInteger() const
+{
+    if (!isNumber())
+        return false;
+    JsonNumber number{};
+    document->cursorAt(position).readNumber(number);
+    return number.kind!=JsonNumber::DOUBLE;
+}
+
+bool JsonLazyValue::getBoolValue() const
+{
+    if (!isBool())
+        throw std::invalid_argument("Unexpected value for JsonBool");
+    bool value = *position=='t';
+    JsonCursor cursor = document->cursorAt(position);
+    if (!(value ? cursor.expectLiteral("true", 4) : cursor.expectLiteral("false", 5)) || !cursor.atValueEnd())
+        throw cursor.error("Unexpected token: '"+std::string(1, cursor.peek())+"'");
+    return value;
+}
+
+double JsonLazyValue::getNumberValue() const
+{
+    if (!isNumber())
+        throw std::invalid_argument("Invalid type for: JsonNumber");
+    JsonNumber number{};
+    document->cursorAt(position).readNumber(number);
+    return number.toDouble();
+}
+
+int64_t JsonLazyValue::getInt64Value() const
+{
+    if (!isNumber())
+        throw std::invalid_argument("Invalid type for: JsonInt");
+    JsonNumber number{};
+    document->cursorAt(position).readNumber(number);
+    if (number.kind==JsonNumber::DOUBLE)
+        throw std::invalid_argument("Invalid type for: JsonInt");
+    if (number.kind==JsonNumber::UINT)
+        throw std::invalid_argument("Value out of range for: JsonInt");
+    return number.int_value;
+}
+
+uint64_t JsonLazyValue::getUInt64Value() const
+{
+    if (!isNumber())
+        throw std::invalid_argument("Invalid type for: JsonUInt");
+    JsonNumber number{};
+    document->cursorAt(position).readNumber(number);
+    if (number.kind==JsonNumber::DOUBLE)
+        throw std::invalid_argument("Invalid type for: JsonUInt");
+    if (number.kind==JsonNumber::INT && number.int_value<0)
+        throw std::invalid_argument("Value out of range for: JsonUInt");
+    return number.uint_value;
+}
+
+std::string JsonLazyValue::getStringValue() const
+{
+    if (!isString())
+        throw std::invalid_argument("Invalid type for: JsonString");
+    std::string result;
+    document->cursorAt(position).readQuotedString(result);
+    return result;
+}
+
+JsonStringView JsonLazyValue::getStringView() const
+{
+    if (!isString())
+        throw std::invalid_argument("Invalid type for: JsonString");
+    JsonStringView raw = document->cursorAt(position).skipQuotedString();
+    if (raw.find('\\')==JsonStringView::npos)
+        return raw;
+    return document->resolveString(position);
+}
+
+size_t JsonLazyValue::size() const
+{
+    if (!isArray() && !isObject())
+        throw std::invalid_argument("Invalid type for: JsonArray or JsonObject");
+    size_t result = 0;
+    for (auto it = begin(); it!=end(); ++it)
+        result++;
+    return result;
+}
+
+JsonLazyValue JsonLazyValue::operator[](int index) const
+{
+    if (!isArray())
+        throw std::invalid_argument("Object is not of type JsonArray");
+    if (index>=0) {
+        int current = 0;
+        for (auto it = begin(); it!=end(); ++it, ++current) {
+            if (current==index)
+                return it.value();
+        }
+    }
+    size_t count = size();
+    if (count==0)
+        throw std::invalid_argument("Index out of range, got ["+std::to_string(index)+"], but JsonArray is empty");
+    throw std::invalid_argument(
+            "Index out of range, got ["+std::to_string(index)+"], max is ["+std::to_string(count-1)+"]");
+}
+
+JsonLazyValue JsonLazyValue::operator[](JsonStringView key) const
+{
+    if (!isObject())
+        throw std::invalid_argument("Object is not of type JsonObject");
+    const char* found = find(key);
+    if (found==nullptr)
+        throw std::invalid_argument("Did not find key '"+std::string(key)+"' in JsonObject");
+    return JsonLazyValue(document, found);
+}
+
+bool JsonLazyValue::hasKey(JsonStringView key) const
+{
+    if (!isObject())
+        throw std::invalid_argument("JsonValue is not of type 'JsonObject'");
+    return find(key)!=nullptr;
+}
+
+const char* JsonLazyValue::find(JsonStringView key) const
+{
+    for (auto it = begin(); it!=end(); ++it) {
+        if (it.keyEquals(key))
+            return it.value().data();
+    }
+    return nullptr;
+}
+
+JsonValue& JsonLazyValue::materialize() const
+{
+    JsonValue*& value = document->materialized[position];
+    if (value==nullptr) {
+        JsonCursor cursor = document->cursorAt(position);
+        JsonValueBuilder builder(document->arena);
+        try {
+            document->reader.readValue(cursor, builder);
+        }
+        catch (...) {
+            document->materialized.erase(position);
+            throw;
+        }
+        value = builder.value();
+    }
+    return *value;
+}
+
+JsonLazyValue::Iterator JsonLazyValue::begin() const
+{
+    if (!isArray() && !isObject())
+        throw std::invalid_argument("Invalid type for: JsonArray or JsonObject");
+    return Iterator(document, position);
+}
+
+JsonLazyValue::Iterator JsonLazyValue::end() const
+{
+    if (!isArray() && !isObject())
+        throw std::invalid_argument("Invalid type for: JsonArray or JsonObject");
+    return Iterator();
+}
+
+JsonLazyValue::Iterator::Iterator(const JsonDocument* document, const char* position)
+        :document(document), rawKey(), valuePosition(nullptr), object(*position=='{')
+{
+    JsonCursor cursor = document->cursorAt(position+1);
+    read(cursor, true);
+}
+
+void JsonLazyValue::Iterator::read(JsonCursor& cursor, bool first)
+{
+    cursor.skipWhiteSpace();
+    char current = cursor.peek();
+    if (current==(object ? '}' : ']')) {
+        if (!first)
+            throw ParseError(cursor.line(), "Expected new object after ','");
+        rawKey = JsonStringView();
+        valuePosition = nullptr;
+        return;
+    }
+    if (cursor.atEnd())
+        throw ParseError(cursor.line(), "END OF FILE", object ? "Unbalanced {}" : "Unbalanced []");
+
+    if (object) {
+        if (current!='"' && current!='\'')
+            throw cursor.error("Unexpected token: '"+std::string(1, current)+"'");
+        rawKey = cursor.skipQuotedString();
+        cursor.skipWhiteSpace();
+        if (!cursor.expectChar(':'))
+            throw cursor.error("Missing ':' after \""+std::string(rawKey)+"\"");
+        cursor.skipWhiteSpace();
+        current = cursor.peek();
+    }
+    if (cursor.atEnd())
+        throw ParseError(cursor.line(), "END OF FILE", object ? "Unbalanced {}" : "Unbalanced []");
+    if (current==',' || isClosing(current))
+        throw cursor.error("Unexpected token: '"+std::string(1, current)+"'");
+    valuePosition = cursor.position();
+}
+
+JsonLazyValue::Iterator& JsonLazyValue::Iterator::operator++()
+{
+    JsonCursor cursor = document->cursorAt(valuePosition);
+    cursor.skipValue();
+    cursor.skipWhiteSpace();
+    if (cursor.expectChar(',')) {
+        read(cursor, false);
+        return *this;
+    }
+    if (cursor.expectChar(object ? '}' : ']')) {
+        rawKey = JsonStringView();
+        valuePosition = nullptr;
+        return *this;
+    }
+    if (cursor.atEnd())
+        throw ParseError(cursor.line(), "END OF FILE", object ? "Unbalanced {}" : "Unbalanced []");
+    if (isClosing(cursor.peek()))
+        throw cursor.error("Unexpected token: '"+std::string(1, cursor.peek())+"'");
+    throw cursor.error("Missing ','");
+}
+
+std::string JsonLazyValue::Iterator::key() const
+{
+    if (!object)
+        throw std::invalid_argument("Object is not of type JsonObject");
+    std::string result;
+    document->cursorAt(rawKey.data()-1).readQuotedString(result);
+    return result;
+}
+
+JsonStringView JsonLazyValue::Iterator::keyView() const
+{
+    if (!object)
+        throw std::invalid_argument("Object is not of type JsonObject");
+    if (rawKey.find('\\')==JsonStringView::npos)
+        return rawKey;
+    return document->resolveString(rawKey.data()-1);
+}
+
+bool JsonLazyValue::Iterator::keyEquals(JsonStringView key) const
+{
+    if (!object)
+        throw std::invalid_argument("Object is not of type JsonObject");
+    if (rawKey.find('\\')==JsonStringView::npos)
+        return rawKey==key;
+    return this->key()==key;
+}
@@ -0,0 +1,413 @@
+#ifndef JSONPARSER_JSONDOCUMENT_H
+#define JSONPARSER_JSONDOCUMENT_H
+
+#include <string>
+#include <cstdint>
+#include <unordered_map>
+#include "jsonParser.h"
+
+class JsonDocument;
+
+/**
+ * Read-only view of a value in the text of a JsonDocument.
+ * The view is just a position in the text, nothing is read until an accessor is used. Looking up a key or an
+ * index scans forward from the start of the object or array and skips the values in between by matching
+ * brackets, so only the values that are touched are ever read. The accessors mirror the ones of JsonValue.
+ * A view stays valid as long as its document is not cleared or parsed again.
+ */
+class JsonLazyValue {
+private:
+    const JsonDocument* document;   /**< Document the value lives in*/
+    const char* position;           /**< First character of the value*/
+
+public:
+
+    /**
+     * Creates a view of a value in a document.
+     * @param document Document the value lives in.
+     * @param position First character of the value.
+     */
+    JsonLazyValue(const JsonDocument* document, const char* position)
+            :document(document), position(position)
+    {
+
+    }
+
+    /**
+     * Check whether the value is of JsonBool type.
+     * @return true if the type is a JsonBool.
+     */
+    bool isBool() const;
+
+    /**
+     * Check whether the value is of JsonNull type.
+     * @return true if the type is JsonNull.
+     */
+    bool isNull() const;
+
+    /**
+     * Check whether the value is of JsonString type.
+     * @return true if the type is JsonString.
+     */
+    bool isString() const;
+
+    /**
+     * Check whether the value is of JsonArray type.
+     * @return true if the type is JsonArray.
+     */
+    bool isArray() const;
+
+    /**
+     * Check whether the value is of JsonObject type.
+     * @return true if the type is JsonObject.
+     */
+    bool isObject() const;
+
+    /**
+     * Check whether the value is of JsonNum type.
+     * @return True if the type is JsonNum.
+     */
+    bool isNumber() const;
+
+    /**
+     * Check whether the value is a number that is stored as an exact 64-bit integer.
+     * @throw ParseError if the number is formatted incorrectly.
+     * @return True if getInt64Value or getUInt64Value can be used.
+     */
+    bool isInteger() const;
+
+    /**
+     * Get the boolean value.
+     * @throw invalid argument if the type is not JsonBool.
+     * @return the boolean value.
+     */
+    bool getBoolValue() const;
+
+    /**
+     * Get the number value.
+     * @throw invalid argument if the type is not JsonNum.
+     * @throw ParseError if the number is formatted incorrectly.
+     * @return the number value.
+     */
+    double getNumberValue() const;
+
+    /**
+     * Get the exact value of an integer.
+     * @throw invalid argument if the number is not an integer or does not fit in an int64_t.
+     * @throw ParseError if the number is formatted incorrectly.
+     * @return the integer value.
+     */
+    int64_t getInt64Value() const;
+
+    /**
+     * Get the exact value of a non-negative integer.
+     * @throw invalid argument if the number is not an integer or is negative.
+     * @throw ParseError if the number is formatted incorrectly.
+     * @return the integer value.
+     */
+    uint64_t getUInt64Value() const;
+
+    /**
+     * Get the string value.
+     * @throw invalid argument if the type is not JsonString.
+     * @throw ParseError if the string is not terminated or contains an invalid escape sequence.
+     * @return the string value.
+     */
+    std::string getStringValue() const;
+
+    /**
+     * Get the string value without copying it.
+     * Strings without escape sequences are viewed in the text itself, others are resolved into the arena
+     * of the document the first time they are read.
+     * @throw invalid argument if the type is not JsonString.
+     * @throw ParseError if the string is not terminated or contains an invalid escape sequence.
+     * @return View of the string, valid as long as the document.
+     */
+    JsonStringView getStringView() const;
+
+    /**
+     * Get the amount of elements of an array or members of an object.
+     * This scans the complete array or object.
+     * @throw invalid argument if the type is not JsonArray or JsonObject.
+     * @return Amount of elements or members.
+     */
+    size_t size() const;
+
+    /**
+     * Index operator which can be used if the value is a JsonArray.
+     * @throw invalid argument if the type is not JsonArray.
+     * @throw invalid argument if the index is out of bounds.
+     * @param index Index in the array.
+     * @return View of the element.
+     */
+    JsonLazyValue operator[](int index) const;
+
+    /**
+     * Index operator which can be used if the value is a JsonObject.
+     * Duplicate keys are not detected, the first one is returned.
+     * @throw invalid argument if the type is not JsonObject.
+     * @throw invalid argument if the key cannot be found in the JsonObject.
+     * @param key Key associated to the value we want to get.
+     * @return View of the value associated with key.
+     */
+    JsonLazyValue operator[](JsonStringView key) const;
+
+    /**
+     * Check whether a key exists if the value is a JsonObject.
+     * @throw invalid argument if the type is not JsonObject
+     * @param key Key to check
+     * @return True if the key can be found
+     */
+    bool hasKey(JsonStringView key) const;
+
+    /**
+     * Read the complete value and build it as a JsonValue.
+     * The value is validated like JsonParser does and lives in the arena of the document. It is built the
+     * first time, later calls for the same value return the same JsonValue.
+     * @throw ParseError if the value is not valid json.
+     * @return The value, valid as long as the document.
+     */
+    JsonValue& materialize() const;
+
+    /**
+     * Get the position of the value in the text.
+     * @return Pointer to the first character of the value.
+     */
+    const char* data() const
+    {
+        return position;
+    }
+
+    /**
+     * Iterator over the elements of an array or the members of an object.
+     */
+    class Iterator {
+    private:
+        const JsonDocument* document;   /**< Document the values live in*/
+        JsonStringView rawKey;          /**< Current key as it is in the text, empty for arrays*/
+        const char* valuePosition;      /**< First character of the current value, nullptr at the end*/
+        bool object;                    /**< True if the iterator walks over object members*/
+
+        /**
+         * Move to the member or element starting at the cursor, or to the end at a closing bracket.
+         * @param cursor Cursor after a '{', '[' or ','.
+         * @param first True right after the '{' or '[', where a closing bracket is allowed.
+         */
+        void read(JsonCursor& cursor, bool first);
+
+    public:
+
+        /**
+         * Creates an iterator at the first element or member.
+         * @param document Document the values live in.
+         * @param position The '{' or '[' of the object or array.
+         */
+        Iterator(const JsonDocument* document, const char* position);
+
+        /**
+         * Creates an end iterator.
+         */
+        Iterator()
+                :document(nullptr), rawKey(), valuePosition(nullptr), object(false)
+        {
+
+        }
+
+        /**
+         * Get the key of the current member.
+         * @throw invalid argument if the iterator walks over an array.
+         * @return The key, escape sequences are resolved.
+         */
+        std::string key() const;
+
+        /**
+         * Get the key of the current member without copying it.
+         * @throw invalid argument if the iterator walks over an array.
+         * @return View of the key, valid as long as the document.
+         */
+        JsonStringView keyView() const;
+
+        /**
+         * Check whether the current key equals a key, without copying it.
+         * @throw invalid argument if the iterator walks over an array.
+         * @param key Key to compare with.
+         * @return True if the keys are equal.
+         */
+        bool keyEquals(JsonStringView key) const;
+
+        /**
+         * Get the current element or member value.
+         * @return View of the value.
+         */
+        JsonLazyValue value() const
+        {
+            return JsonLazyValue(document, valuePosition);
+        }
+
+        Iterator& operator++();
+
+        bool operator!=(const Iterator& other) const
+        {
+            return valuePosition!=other.valuePosition;
+        }
+
+        bool operator==(const Iterator& other) const
+        {
+            return valuePosition==other.valuePosition;
+        }
+
+        JsonLazyValue operator*() const
+        {
+            return value();
+        }
+    };
+
+    /**
+     * Get an iterator to the first element or member.
+     * @throw invalid argument if the type is not JsonArray or JsonObject.
+     * @return The iterator.
+     */
+    Iterator begin() const;
+
+    /**
+     * Get an iterator past the last element or member.
+     * @throw invalid argument if the type is not JsonArray or JsonObject.
+     * @return The iterator.
+     */
+    Iterator end() const;
+
+private:
+
+    /**
+     * Find the value of a member if the value is a JsonObject.
+     * @param key Key to look for.
+     * @return First character of the value, nullptr if the key does not exist.
+     */
+    const char* find(JsonStringView key) const;
+
+    friend class JsonDocument;
+};
+
+/**
+ * Json document that is read on demand.
+ * Parsing only checks the root '{', values are read from the text when they are accessed through
+ * JsonLazyValue. This is the fastest way to read a few values of a large document: the values in between
+ * are skipped, not built. Errors in values that are never accessed are not reported.
+ * Everything that is read lives in the text or in the arena of the document, use JsonParser
+ * when all values are needed.
+ * Reads are not pure: resolved strings and materialized values are added to the arena of the document
+ * once per value, so reading from several threads at the same time needs a lock around the document.
+ */
+class JsonDocument {
+public:
+
+    /**
+     * Default constructor, creates an empty document.
+     */
+    JsonDocument();
+
+    /**
+     * Creates a JsonDocument and immediately maps a file.
+     * @param file_name Name of the file to parse.
+     */
+    explicit JsonDocument(const std::string& file_name);
+
+    /**
+     * Deleted copy constructor, values refer to the document.
+     */
+    JsonDocument(const JsonDocument&) = delete;
+
+    /**
+     * Deleted assignment operator, values refer to the document.
+     */
+    JsonDocument& operator=(const JsonDocument&) = delete;
+
+    /**
+     * Maps a json file, the mapping stays alive as long as the document.
+     * @throw invalid argument if the file can not be opened.
+     * @throw ParseError if the file does not start with the root object.
+     * @param file_name Path to input file.
+     */
+    void parse(const std::string& file_name);
+
+    /**
+     * Uses json text from a buffer without copying it.
+     * The buffer must stay alive and unchanged as long as the document is used.
+     * @throw ParseError if the text does not start with the root object.
+     * @param data Start of the json text.
+     * @param length Amount of characters in the buffer.
+     */
+    void parse(const char* data, size_t length);
+
+    /**
+     * Copies json text from a string.
+     * @throw ParseError if the text does not start with the root object.
+     * @param json String containing the json text.
+     */
+    void parseString(const std::string& json);
+
+    /**
+     * Get the root object.
+     * @throw invalid argument if nothing was parsed.
+     * @return View of the root object.
+     */
+    JsonLazyValue root() const;
+
+    /**
+     * Check whether a key exists in the root object.
+     * @param key Key to check
+     * @return True if the key exists
+     */
+    bool hasKey(JsonStringView key) const;
+
+    /**
+     * Index operator used to access the root object easily.
+     * @throw invalid argument if the key does not exist.
+     * @param key Key to access.
+     * @return View of the value associated with the key.
+     */
+    JsonLazyValue operator[](JsonStringView key) const;
+
+    /**
+     * Removes the text and everything that was read from it.
+     */
+    void clear();
+
+private:
+    const char* text;       /**< Start of the json text, nullptr if nothing was parsed*/
+    size_t length;          /**< Amount of characters of the text*/
+    const char* rootObject; /**< The '{' of the root object*/
+    std::string copy;       /**< Owned copy of the text, if it was parsed from a string*/
+    MappedFile source;      /**< Mapped input file, if it was parsed from a file*/
+    mutable JsonArena arena;    /**< Arena of the materialized values and resolved strings*/
+    mutable JsonReader reader;  /**< Tokenizer of materialized values*/
+    mutable std::unordered_map<const char*, JsonStringView> resolved;   /**< Strings with escapes, by their '"'*/
+    mutable std::unordered_map<const char*, JsonValue*> materialized;   /**< Materialized values, by position*/
+
+    /**
+     * Start using a text, after checking that it starts with the root object.
+     * @throw ParseError if the text does not start with the root object.
+     * @param data Start of the json text.
+     * @param size Amount of characters in the text.
+     */
+    void use(const char* data, size_t size);
+
+    /**
+     * Create a cursor over the text.
+     * @param position Position of the cursor.
+     * @return The cursor.
+     */
+    JsonCursor cursorAt(const char* position) const;
+
+    /**
+     * Get a string with escape sequences, resolved into the arena the first time it is read.
+     * @throw ParseError if the string is not terminated or contains an invalid escape sequence.
+     * @param quote The opening '"' of the string.
+     * @return View of the resolved string.
+     */
+    JsonStringView resolveString(const char* quote) const;
+
+    friend class JsonLazyValue;
+};
+
+#endif //JSONPARSER_JSONDOCUMENT_H
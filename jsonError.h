@@ -0,0 +1,49 @@
+#ifndef JSONPARSER_JSONERROR_H
+#define JSONPARSER_JSONERROR_H
+
+#include <string>
+#include <stdexcept>
+
+/**
+ * Simple error class for Parsing errors.
+ */
+class ParseError : public std::exception {
+private:
+    std::string message;    /**< Message to show*/
+public:
+
+    /**
+     * Constructor for parse errors.
+     * @param line Line of the file where the error happened.
+     * @param content Contents of the line where the error happened.
+     * @param message Additional message.
+     */
+    ParseError(int line, const std::string& content, const std::string& message)
+            :ParseError(line, message)
+    {
+        if (content.empty())
+            return;
+        this->message = "Error at line "+std::to_string(line)+":\n|\n"+content+"\n"+message;
+    }
+
+    /**
+     * Constructor for parse errors.
+     * @param line Line of the file where the error happened.
+     * @param message Additional message.
+     */
+    ParseError(int line, const std::string& message)
+    {
+        this->message = "Error at line "+std::to_string(line)+": "+message;
+    }
+
+    /**
+     * Overridden what function. Displays the message.
+     * @return Error message.
+     */
+    const char* what() const noexcept override
+    {
+        return message.c_str();
+    }
+};
+
+#endif //JSONPARSER_JSONERROR_H
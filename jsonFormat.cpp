@@ -0,0 +1,435 @@
+#include <cmath>
+#include <cstring>
+#include "jsonFormat.h"
+
+namespace {
+
+/**
+ * Pairs of digits 00 up to 99, integers are written two digits at a time.
+ */
+const char digitPairs[] =
+        "00010203040506070809"
+        "10111213141516171819"
+        "20212223242526272829"
+        "30313233343536373839"
+        "40414243444546474849"
+        "50515253545556575859"
+        "60616263646566676869"
+        "70717273747576777879"
+        "80818283848586878889"
+        "90919293949596979899";
+
+/**
+ * Characters that must be escaped in a string: 'u' for \u00XX, the escape character for short escapes,
+ * 0 for characters that are copied as they are.
+ */
+const char escapes[256] = {
+    'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'b', 't', 'n', 'u', 'f', 'r', 'u', 'u',
+    'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u',
+    0, 0, '"', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, '\\', 0, 0, 0,
+};
+
+/**
+ * Normalized 64-bit approximations of the powers of ten 10^-348 up to 10^340 in steps of 8,
+ * rounded to nearest: the power is significand*2^exponent. Used by the Grisu2 algorithm.
+ */
+const struct {
+    uint64_t significand;
+    int exponent;
+} cachedPowers[] = {
+    {0xfa8fd5a0081c0288, -1220},  // 10^-348
+    {0xbaaee17fa23ebf76, -1193},  // 10^-340
+    {0x8b16fb203055ac76, -1166},  // 10^-332
+    {0xcf42894a5dce35ea, -1140},  // 10^-324
+    {0x9a6bb0aa55653b2d, -1113},  // 10^-316
+    {0xe61acf033d1a45df, -1087},  // 10^-308
+    {0xab70fe17c79ac6ca, -1060},  // 10^-300
+    {0xff77b1fcbebcdc4f, -1034},  // 10^-292
+    {0xbe5691ef416bd60c, -1007},  // 10^-284
+    {0x8dd01fad907ffc3c, -980},  // 10^-276
+    {0xd3515c2831559a83, -954},  // 10^-268
+    {0x9d71ac8fada6c9b5, -927},  // 10^-260
+    {0xea9c227723ee8bcb, -901},  // 10^-252
+    {0xaecc49914078536d, -874},  // 10^-244
+    {0x823c12795db6ce57, -847},  // 10^-236
+    {0xc21094364dfb5637, -821},  // 10^-228
+    {0x9096ea6f3848984f, -794},  // 10^-220
+    {0xd77485cb25823ac7, -768},  // 10^-212
+    {0xa086cfcd97bf97f4, -741},  // 10^-204
+    {0xef340a98172aace5, -715},  // 10^-196
+    {0xb23867fb2a35b28e, -688},  // 10^-188
+    {0x84c8d4dfd2c63f3b, -661},  // 10^-180
+    {0xc5dd44271ad3cdba, -635},  // 10^-172
+    {0x936b9fcebb25c996, -608},  // 10^-164
+    {0xdbac6c247d62a584, -582},  // 10^-156
+    {0xa3ab66580d5fdaf6, -555},  // 10^-148
+    {0xf3e2f893dec3f126, -529},  // 10^-140
+    {0xb5b5ada8aaff80b8, -502},  // 10^-132
+    {0x87625f056c7c4a8b, -475},  // 10^-124
+    {0xc9bcff6034c13053, -449},  // 10^-116
+    {0x964e858c91ba2655, -422},  // 10^-108
+    {0xdff9772470297ebd, -396},  // 10^-100
+    {0xa6dfbd9fb8e5b88f, -369},  // 10^-92
+    {0xf8a95fcf88747d94, -343},  // 10^-84
+    {0xb94470938fa89bcf, -316},  // 10^-76
+    {0x8a08f0f8bf0f156b, -289},  // 10^-68
+    {0xcdb02555653131b6, -263},  // 10^-60
+    {0x993fe2c6d07b7fac, -236},  // 10^-52
+    {0xe45c10c42a2b3b06, -210},  // 10^-44
+    {0xaa242499697392d3, -183},  // 10^-36
+    {0xfd87b5f28300ca0e, -157},  // 10^-28
+    {0xbce5086492111aeb, -130},  // 10^-20
+    {0x8cbccc096f5088cc, -103},  // 10^-12
+    {0xd1b71758e219652c, -77},  // 10^-4
+    {0x9c40000000000000, -50},  // 10^4
+    {0xe8d4a51000000000, -24},  // 10^12
+    {0xad78ebc5ac620000, 3},  // 10^20
+    {0x813f3978f8940984, 30},  // 10^28
+    {0xc097ce7bc90715b3, 56},  // 10^36
+    {0x8f7e32ce7bea5c70, 83},  // 10^44
+    {0xd5d238a4abe98068, 109},  // 10^52
+    {0x9f4f2726179a2245, 136},  // 10^60
+    {0xed63a231d4c4fb27, 162},  // 10^68
+    {0xb0de65388cc8ada8, 189},  // 10^76
+    {0x83c7088e1aab65db, 216},  // 10^84
+    {0xc45d1df942711d9a, 242},  // 10^92
+    {0x924d692ca61be758, 269},  // 10^100
+    {0xda01ee641a708dea, 295},  // 10^108
+    {0xa26da3999aef774a, 322},  // 10^116
+    {0xf209787bb47d6b85, 348},  // 10^124
+    {0xb454e4a179dd1877, 375},  // 10^132
+    {0x865b86925b9bc5c2, 402},  // 10^140
+    {0xc83553c5c8965d3d, 428},  // 10^148
+    {0x952ab45cfa97a0b3, 455},  // 10^156
+    {0xde469fbd99a05fe3, 481},  // 10^164
+    {0xa59bc234db398c25, 508},  // 10^172
+    {0xf6c69a72a3989f5c, 534},  // 10^180
+    {0xb7dcbf5354e9bece, 561},  // 10^188
+    {0x88fcf317f22241e2, 588},  // 10^196
+    {0xcc20ce9bd35c78a5, 614},  // 10^204
+    {0x98165af37b2153df, 641},  // 10^212
+    {0xe2a0b5dc971f303a, 667},  // 10^220
+    {0xa8d9d1535ce3b396, 694},  // 10^228
+    {0xfb9b7cd9a4a7443c, 720},  // 10^236
+    {0xbb764c4ca7a44410, 747},  // 10^244
+    {0x8bab8eefb6409c1a, 774},  // 10^252
+    {0xd01fef10a657842c, 800},  // 10^260
+    {0x9b10a4e5e9913129, 827},  // 10^268
+    {0xe7109bfba19c0c9d, 853},  // 10^276
+    {0xac2820d9623bf429, 880},  // 10^284
+    {0x80444b5e7aa7cf85, 907},  // 10^292
+    {0xbf21e44003acdd2d, 933},  // 10^300
+    {0x8e679c2f5e44ff8f, 960},  // 10^308
+    {0xd433179d9c8cb841, 986},  // 10^316
+    {0x9e19db92b4e31ba9, 1013},  // 10^324
+    {0xeb96bf6ebadf77d9, 1039},  // 10^332
+    {0xaf87023b9bf0ee6b, 1066},  // 10^340
+};
+
+const int CACHED_POWER_MIN = -348;      /**< Decimal exponent of the first cached power*/
+const int CACHED_POWER_STEP = 8;        /**< Decimal exponent between two cached powers*/
+
+/**
+ * Number with a 64-bit significand and a binary exponent, value is f*2^e.
+ */
+struct DiyFp {
+    uint64_t f;
+    int e;
+};
+
+DiyFp subtract(DiyFp a, DiyFp b)
+{
+    return DiyFp{a.f-b.f, a.e};
+}
+
+/**
+ * Multiply two numbers, the result is rounded to 64 bits.
+ */
+DiyFp multiply(DiyFp a, DiyFp b)
+{
+    const uint64_t mask = 0xFFFFFFFF;
+    uint64_t ac = (a.f >> 32)*(b.f >> 32);
+    uint64_t bc = (a.f & mask)*(b.f >> 32);
+    uint64_t ad = (a.f >> 32)*(b.f & mask);
+    uint64_t bd = (a.f & mask)*(b.f & mask);
+    uint64_t middle = (bd >> 32)+(ad & mask)+(bc & mask)+(1ull << 31);
+    return DiyFp{ac+(ad >> 32)+(bc >> 32)+(middle >> 32), a.e+b.e+64};
+}
+
+DiyFp normalize(DiyFp value)
+{
+    while ((value.f & (1ull << 63))==0) {
+        value.f <<= 1;
+        value.e--;
+    }
+    return value;
+}
+
+/**
+ * Get the cached power that brings a number with binary exponent e into the range 2^-60 up to 2^-32.
+ * @param e Binary exponent of the normalized number.
+ * @param k Set to the decimal exponent of the inverse of the power.
+ * @return The power.
+ */
+DiyFp cachedPower(int e, int& k)
+{
+    // Smallest decimal exponent that is large enough, offset by 347 so it is positive and can be rounded up
+    double decimal = (-61-e)*0.30102999566398114+347;
+    int rounded = static_cast<int>(decimal);
+    if (decimal-rounded>0)
+        rounded++;
+    // The next cached power, its exponent is CACHED_POWER_MIN+index*CACHED_POWER_STEP
+    int index = rounded/CACHED_POWER_STEP+1;
+    k = -(CACHED_POWER_MIN+index*CACHED_POWER_STEP);
+    return DiyFp{cachedPowers[index].significand, cachedPowers[index].exponent};
+}
+
+/**
+ * Move the last digit towards the exact value while it stays within the boundaries.
+ */
+void roundWeed(char* digits, int length, uint64_t delta, uint64_t rest, uint64_t tenKappa, uint64_t distance)
+{
+    while (rest<distance && delta-rest>=tenKappa
+           && (rest+tenKappa<distance || distance-rest>rest+tenKappa-distance)) {
+        digits[length-1]--;
+        rest += tenKappa;
+    }
+}
+
+/**
+ * Generate the shortest digits of w that lie between the boundaries, w+ minus delta up to w+.
+ * @param w The number, scaled by a cached power.
+ * @param upper Upper boundary, scaled by the same power.
+ * @param delta Distance between the boundaries.
+ * @param digits Receives the digits.
+ * @param length Set to the amount of digits.
+ * @param k Decimal exponent, the digits are scaled by 10^kappa.
+ */
+void generateDigits(DiyFp w, DiyFp upper, uint64_t delta, char* digits, int& length, int& k)
+{
+    static const uint32_t powersOfTen[] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000,
+                                           1000000000};
+    const DiyFp one{1ull << -upper.e, upper.e};
+    const uint64_t distance = subtract(upper, w).f;
+    uint32_t integral = static_cast<uint32_t>(upper.f >> -one.e);
+    uint64_t fraction = upper.f & (one.f-1);
+
+    int kappa = 10;
+    while (kappa>1 && integral<powersOfTen[kappa-1])
+        kappa--;
+    length = 0;
+    while (kappa>0) {
+        uint32_t digit = integral/powersOfTen[kappa-1];
+        integral %= powersOfTen[kappa-1];
+        if (digit!=0 || length!=0)
+            digits[length++] = static_cast<char>('0'+digit);
+        kappa--;
+        uint64_t rest = (static_cast<uint64_t>(integral) << -one.e)+fraction;
+        if (rest<=delta) {
+            k += kappa;
+            roundWeed(digits, length, delta, rest, static_cast<uint64_t>(powersOfTen[kappa]) << -one.e, distance);
+            return;
+        }
+    }
+    uint64_t unit = 1;
+    while (true) {
+        fraction *= 10;
+        delta *= 10;
+        unit *= 10;
+        char digit = static_cast<char>(fraction >> -one.e);
+        if (digit!=0 || length!=0)
+            digits[length++] = static_cast<char>('0'+digit);
+        fraction &= one.f-1;
+        kappa--;
+        if (fraction<delta) {
+            k += kappa;
+            roundWeed(digits, length, delta, fraction, one.f, distance*unit);
+            return;
+        }
+    }
+}
+
+/**
+ * Grisu2: the shortest digits of a positive double that read back as the same double, in almost all cases.
+ * The remaining cases get one digit too many, but still read back correctly.
+ * @param value Positive, finite double.
+ * @param digits Receives at most 17 digits.
+ * @param length Set to the amount of digits.
+ * @param k Set to the decimal exponent, value is digits*10^k.
+ */
+void grisu2(double value, char* digits, int& length, int& k)
+{
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    const uint64_t hiddenBit = 1ull << 52;
+    int biasedExponent = static_cast<int>(bits >> 52);
+    DiyFp v{bits & (hiddenBit-1), 1-1075};
+    if (biasedExponent!=0) {
+        v.f += hiddenBit;
+        v.e = biasedExponent-1075;
+    }
+
+    // Halfway points to the neighbouring doubles, the lower one is closer at a power of two
+    DiyFp upper = normalize(DiyFp{(v.f << 1)+1, v.e-1});
+    DiyFp lower = v.f==hiddenBit ? DiyFp{(v.f << 2)-1, v.e-2} : DiyFp{(v.f << 1)-1, v.e-1};
+    lower.f <<= lower.e-upper.e;
+    lower.e = upper.e;
+
+    DiyFp power = cachedPower(upper.e, k);
+    DiyFp w = multiply(normalize(v), power);
+    DiyFp scaledUpper = multiply(upper, power);
+    DiyFp scaledLower = multiply(lower, power);
+    // Stay inside the boundaries despite the rounding errors of the multiplications
+    scaledUpper.f--;
+    scaledLower.f++;
+    generateDigits(w, scaledUpper, scaledUpper.f-scaledLower.f, digits, length, k);
+}
+
+/**
+ * Write a decimal exponent, without a plus sign.
+ */
+char* writeExponent(int exponent, char* output)
+{
+    if (exponent<0) {
+        *output++ = '-';
+        exponent = -exponent;
+    }
+    if (exponent>=100) {
+        *output++ = static_cast<char>('0'+exponent/100);
+        exponent %= 100;
+        memcpy(output, digitPairs+exponent*2, 2);
+        return output+2;
+    }
+    if (exponent>=10) {
+        memcpy(output, digitPairs+exponent*2, 2);
+        return output+2;
+    }
+    *output++ = static_cast<char>('0'+exponent);
+    return output;
+}
+
+}
+
+char* JsonFormat::writeUInt64(uint64_t value, char* output)
+{
+    char digits[20];
+    char* position = digits+sizeof(digits);
+    while (value>=100) {
+        position -= 2;
+        memcpy(position, digitPairs+value%100*2, 2);
+        value /= 100;
+    }
+    if (value>=10) {
+        position -= 2;
+        memcpy(position, digitPairs+value*2, 2);
+    }
+    else {
+        *--position = static_cast<char>('0'+value);
+    }
+    size_t length = static_cast<size_t>(digits+sizeof(digits)-position);
+    memcpy(output, position, length);
+    return output+length;
+}
+
+char* JsonFormat::writeInt64(int64_t value, char* output)
+{
+    if (value>=0)
+        return writeUInt64(static_cast<uint64_t>(value), output);
+    *output++ = '-';
+    // Negating as unsigned also works for the smallest int64_t
+    return writeUInt64(0-static_cast<uint64_t>(value), output);
+}
+
+char* JsonFormat::writeDouble(double value, char* output)
+{
+    if (value!=value || value-value!=0) {
+        memcpy(output, "null", 4);
+        return output+4;
+    }
+    if (std::signbit(value)) {
+        *output++ = '-';
+        value = -value;
+    }
+    if (value==0) {
+        memcpy(output, "0.0", 3);
+        return output+3;
+    }
+
+    int length;
+    int k;
+    grisu2(value, output, length, k);
+    // The value is between 10^(point-1) and 10^point
+    int point = length+k;
+    if (k>=0 && point<=21) {
+        // 1234e7 -> 12340000000.0
+        memset(output+length, '0', static_cast<size_t>(k));
+        memcpy(output+point, ".0", 2);
+        return output+point+2;
+    }
+    if (point>0 && point<=21) {
+        // 1234e-2 -> 12.34
+        memmove(output+point+1, output+point, static_cast<size_t>(length-point));
+        output[point] = '.';
+        return output+length+1;
+    }
+    if (point>-6 && point<=0) {
+        // 1234e-6 -> 0.001234
+        int offset = 2-point;
+        memmove(output+offset, output, static_cast<size_t>(length));
+        output[0] = '0';
+        output[1] = '.';
+        memset(output+2, '0', static_cast<size_t>(offset-2));
+        return output+length+offset;
+    }
+    if (length==1) {
+        // 1e30
+        output[1] = 'e';
+        return writeExponent(point-1, output+2);
+    }
+    // 1234e30 -> 1.234e33
+    memmove(output+2, output+1, static_cast<size_t>(length-1));
+    output[1] = '.';
+    output[length+1] = 'e';
+    return writeExponent(point-1, output+length+2);
+}
+
+char* JsonFormat::writeString(JsonStringView string, char* output)
+{
+    *output++ = '"';
+    output = writeEscaped(string, output);
+    *output++ = '"';
+    return output;
+}
+
+char* JsonFormat::writeEscaped(JsonStringView string, char* output)
+{
+    const char* position = string.data();
+    const char* end = position+string.size();
+    while (position<end) {
+        // Copy the run of characters that need no escaping at once
+        const char* run = position;
+        while (position<end && escapes[static_cast<unsigned char>(*position)]==0)
+            ++position;
+        memcpy(output, run, static_cast<size_t>(position-run));
+        output += position-run;
+        if (position==end)
+            break;
+
+        char escape = escapes[static_cast<unsigned char>(*position)];
+        *output++ = '\\';
+        *output++ = escape;
+        if (escape=='u') {
+            static const char hex[] = "0123456789abcdef";
+            unsigned char c = static_cast<unsigned char>(*position);
+            memcpy(output, "00", 2);
+            output[2] = hex[c >> 4];
+            output[3] = hex[c & 0xF];
+            output += 4;
+        }
+        ++position;
+    }
+    return output;
+}
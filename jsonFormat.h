@@ -0,0 +1,82 @@
+#ifndef JSONPARSER_JSONFORMAT_H
+#define JSONPARSER_JSONFORMAT_H
+
+#include <cstdint>
+#include <cstddef>
+#include "jsonStringView.h"
+
+/**
+ * Formatting of numbers and strings as json text, shared by everything that writes json.
+ * Every function writes into a buffer that is large enough and returns the position after the last written
+ * character, nothing is null terminated. Formatting never depends on the current locale.
+ */
+struct JsonFormat {
+
+    static const size_t MAX_NUMBER_LENGTH = 32;     /**< Most characters any number is written with*/
+
+    /**
+     * Write an integer.
+     * @param value The integer.
+     * @param output Buffer with room for MAX_NUMBER_LENGTH characters.
+     * @return Pointer past the last written character.
+     */
+    static char* writeInt64(int64_t value, char* output);
+
+    /**
+     * Write a non-negative integer.
+     * @param value The integer.
+     * @param output Buffer with room for MAX_NUMBER_LENGTH characters.
+     * @return Pointer past the last written character.
+     */
+    static char* writeUInt64(uint64_t value, char* output);
+
+    /**
+     * Write a double with the fewest digits that read back as the same double, using the Grisu2 algorithm.
+     * Doubles always get a fraction or an exponent (1.0, 1e30), so they are read back as doubles, not integers.
+     * Json has no infinity or NaN, those are written as null.
+     * @param value The double.
+     * @param output Buffer with room for MAX_NUMBER_LENGTH characters.
+     * @return Pointer past the last written character.
+     */
+    static char* writeDouble(double value, char* output);
+
+    /**
+     * Get the most characters the escaped characters of a string can take, without quotes.
+     * @param length Amount of characters of the string.
+     * @return Size of the buffer writeEscaped needs.
+     */
+    static size_t maxEscapedLength(size_t length)
+    {
+        return length*6;
+    }
+
+    /**
+     * Get the most characters a string can be written with, including its quotes.
+     * @param length Amount of characters of the string.
+     * @return Size of the buffer writeString needs.
+     */
+    static size_t maxStringLength(size_t length)
+    {
+        return maxEscapedLength(length)+2;
+    }
+
+    /**
+     * Write the characters of a string without quotes, escaping quotes, backslashes and control characters.
+     * Other characters are copied as they are, runs of characters that need no escaping are copied at once.
+     * A string can be escaped in parts, the result is the same.
+     * @param string The string.
+     * @param output Buffer with room for maxEscapedLength(string.size()) characters.
+     * @return Pointer past the last written character.
+     */
+    static char* writeEscaped(JsonStringView string, char* output);
+
+    /**
+     * Write a string with quotes, escaping its characters like writeEscaped.
+     * @param string The string.
+     * @param output Buffer with room for maxStringLength(string.size()) characters.
+     * @return Pointer past the closing quote.
+     */
+    static char* writeString(JsonStringView string, char* output);
+};
+
+#endif //JSONPARSER_JSONFORMAT_H
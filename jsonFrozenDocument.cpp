@@ -0,0 +1,90 @@
+#include <stdexcept>
+#include "jsonFrozenDocument.h"
+#include "jsonSerializer.h"
+#include "jsonBinary.h"
+
+const size_t JsonFrozenDocument::INDEX_THRESHOLD;
+
+JsonFrozenDocument::JsonFrozenDocument()
+        :document(nullptr)
+{
+
+}
+
+JsonFrozenDocument::JsonFrozenDocument(JsonParser& parser, bool indexKeys)
+{
+    if (parser.root==nullptr)
+        throw std::invalid_argument("JsonParser is empty");
+    if (parser.pushParser.started())
+        throw std::invalid_argument("JsonParser has an unfinished document");
+
+    // The indices are allocated from the arena, so they are built before the arena is taken over
+    if (indexKeys)
+        index(*parser.root);
+    document = std::make_shared<const Document>(std::move(parser.arena), std::move(parser.source), parser.root);
+    parser.root = nullptr;
+    parser.clear();
+}
+
+void JsonFrozenDocument::index(JsonObject& object)
+{
+    if (object.size()>INDEX_THRESHOLD)
+        object.buildIndex();
+    for (auto& member : object)
+        index(*member.second);
+}
+
+void JsonFrozenDocument::index(JsonValue& value)
+{
+    if (value.isObject()) {
+        index(value.getObjectValue());
+    }
+    else if (value.isArray()) {
+        for (JsonValue* element : value.getArrayValue())
+            index(*element);
+    }
+}
+
+const JsonObject& JsonFrozenDocument::root() const
+{
+    if (document==nullptr)
+        throw std::invalid_argument("JsonFrozenDocument is empty");
+    return *document->root;
+}
+
+bool JsonFrozenDocument::hasKey(JsonStringView key) const
+{
+    return find(key)!=nullptr;
+}
+
+const JsonValue* JsonFrozenDocument::find(JsonStringView key) const
+{
+    if (document==nullptr)
+        return nullptr;
+    auto it = document->root->find(key);
+    return it==document->root->end() ? nullptr : it->second;
+}
+
+const JsonValue& JsonFrozenDocument::operator[](JsonStringView key) const
+{
+    const JsonValue* value = find(key);
+    if (value==nullptr)
+        throw std::invalid_argument("There is no such key '"+std::string(key)+"'");
+    return *value;
+}
+
+std::string JsonFrozenDocument::dump(int indent) const
+{
+    JsonSerializer serializer(indent);
+    return std::string(serializer.serialize(root()));
+}
+
+void JsonFrozenDocument::save(const std::string& file_name) const
+{
+    JsonBinary::save(root(), file_name);
+}
+
+size_t JsonFrozenDocument::memoryUsage() const
+{
+    return document==nullptr ? 0 : document->arena.bytesUsed();
+}
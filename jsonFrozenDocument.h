@@ -0,0 +1,140 @@
+#ifndef JSONPARSER_JSONFROZENDOCUMENT_H
+#define JSONPARSER_JSONFROZENDOCUMENT_H
+
+#include <string>
+#include <memory>
+#include <cstddef>
+#include "jsonParser.h"
+
+/**
+ * Immutable, reference counted document, created by JsonParser::freeze().
+ * The document takes over the arena of the parser, so freezing copies no values. Copies of a JsonFrozenDocument
+ * share the document, the last copy that is destructed releases it. The document only hands out const references
+ * and reading never changes anything, not even a cache or a lazily built index, so any amount of threads can
+ * read the same document without locks. Every thread should hold its own copy of the handle.
+ * JsonPointer::resolve(document.root()) and JsonQuery::evaluate(document.root()) work on frozen documents and
+ * return const values as well. getArrayValue() and getObjectValue() of a JsonValue return mutable containers
+ * even for a const value, they must not be used to change a frozen document.
+ * JsonFrozenDocument document = parser.freeze(true);
+ * std::thread reader([document] { use(document["animations"]); });
+ */
+class JsonFrozenDocument {
+public:
+
+    static const size_t INDEX_THRESHOLD = 4;    /**< Objects with more members than this get a key index*/
+
+    /**
+     * Default constructor, creates an empty handle without document.
+     */
+    JsonFrozenDocument();
+
+    /**
+     * Check whether the handle has a document.
+     * @return True if there is no document.
+     */
+    bool empty() const
+    {
+        return document==nullptr;
+    }
+
+    /**
+     * Get the root object.
+     * @throw invalid argument if there is no document.
+     * @return The root object.
+     */
+    const JsonObject& root() const;
+
+    /**
+     * Check whether a key of the root object exists.
+     * @param key Key to check.
+     * @return True if the key exists.
+     */
+    bool hasKey(JsonStringView key) const;
+
+    /**
+     * Find the value of a key of the root object.
+     * @param key Key to look for.
+     * @return The value, nullptr if the key does not exist or there is no document.
+     */
+    const JsonValue* find(JsonStringView key) const;
+
+    /**
+     * Get the value of a key of the root object.
+     * @throw invalid argument if the key does not exist or there is no document.
+     * @param key Key to look for.
+     * @return The value.
+     */
+    const JsonValue& operator[](JsonStringView key) const;
+
+    /**
+     * Write the root object as json text.
+     * @throw invalid argument if there is no document.
+     * @param indent Amount of spaces per level of nesting, 0 for compact text on a single line.
+     * @return The text.
+     */
+    std::string dump(int indent = 0) const;
+
+    /**
+     * Write the document as a binary snapshot, it can be loaded with JsonParser::loadBinary().
+     * @throw invalid argument if there is no document or the file can not be written.
+     * @param file_name Path of the snapshot, an existing file is overwritten.
+     */
+    void save(const std::string& file_name) const;
+
+    /**
+     * Get the amount of memory the document uses.
+     * @return Amount of bytes allocated from the arena of the document, including the key indices.
+     */
+    size_t memoryUsage() const;
+
+    /**
+     * Get the amount of handles that share the document.
+     * @return Amount of handles, 0 if there is no document.
+     */
+    long useCount() const
+    {
+        return document.use_count();
+    }
+
+private:
+
+    /**
+     * The shared document, never changed after it is created.
+     */
+    struct Document {
+        JsonArena arena;        /**< Arena that owns all values, taken over from the parser*/
+        MappedFile source;      /**< Mapped input file of the parser*/
+        const JsonObject* root; /**< Root object, allocated in the arena*/
+
+        Document(JsonArena&& arena, MappedFile&& source, const JsonObject* root)
+                :arena(std::move(arena)), source(std::move(source)), root(root)
+        {
+        }
+    };
+
+    std::shared_ptr<const Document> document;   /**< The document, nullptr for an empty handle*/
+
+    /**
+     * Takes over the data structure of a parser, the parser is empty afterwards.
+     * @throw invalid argument if the parser is empty or has an unfinished document.
+     * @param parser Parser with a parsed document.
+     * @param indexKeys True to build a key index for every object with more than INDEX_THRESHOLD members.
+     */
+    JsonFrozenDocument(JsonParser& parser, bool indexKeys);
+
+    /**
+     * Build the key index of an object and of all objects nested in it.
+     * @param object Object to index.
+     */
+    static void index(JsonObject& object);
+
+    /**
+     * Build the key index of all objects in a value.
+     * @param value Value to index.
+     */
+    static void index(JsonValue& value);
+
+    friend class JsonParser;
+};
+
+#endif //JSONPARSER_JSONFROZENDOCUMENT_H
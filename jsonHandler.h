@@ -0,0 +1,96 @@
+#ifndef JSONPARSER_JSONHANDLER_H
+#define JSONPARSER_JSONHANDLER_H
+
+#include "jsonNumber.h"
+#include "jsonStringView.h"
+
+/**
+ * Receives the events of a JsonReader, in document order.
+ * Every event has an empty default implementation, so a handler only overrides the events it needs.
+ * Views passed to an event are only valid during the call, copy them to keep them. The only exception is
+ * the key, which stays valid until the next key event.
+ * Exceptions thrown by a handler stop reading and are passed on to the caller of the reader.
+ */
+class JsonHandler {
+public:
+
+    virtual ~JsonHandler() = default;
+
+    /**
+     * An object starts, its members follow as key events each followed by the events of the value.
+     */
+    virtual void startObject()
+    {
+
+    }
+
+    /**
+     * The key of the next member of the current object.
+     * @param key Key with its escape sequences resolved, valid until the next key event.
+     */
+    virtual void key(JsonStringView /*key*/)
+    {
+
+    }
+
+    /**
+     * The current object ends.
+     */
+    virtual void endObject()
+    {
+
+    }
+
+    /**
+     * An array starts, the events of its elements follow.
+     */
+    virtual void startArray()
+    {
+
+    }
+
+    /**
+     * The current array ends.
+     */
+    virtual void endArray()
+    {
+
+    }
+
+    /**
+     * A string value.
+     * @param value String with its escape sequences resolved.
+     */
+    virtual void string(JsonStringView /*value*/)
+    {
+
+    }
+
+    /**
+     * A number value.
+     * @param value The number, integers that fit in 64 bits are exact.
+     */
+    virtual void number(const JsonNumber& /*value*/)
+    {
+
+    }
+
+    /**
+     * A true or false value.
+     * @param value The value.
+     */
+    virtual void boolean(bool /*value*/)
+    {
+
+    }
+
+    /**
+     * A null value.
+     */
+    virtual void null()
+    {
+
+    }
+};
+
+#endif //JSONPARSER_JSONHANDLER_H
@@ -0,0 +1,515 @@
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <unordered_map>
+#include "jsonImage.h"
+
+const size_t JsonImageValue::SLOT_SIZE;
+const uint32_t JsonImage::VERSION;
+const size_t JsonImage::INDEX_THRESHOLD;
+const size_t JsonImage::HEADER_SIZE;
+
+namespace {
+
+const char MAGIC[4] = {'E', 'J', 'S', 'I'};
+
+/**
+ * Type byte of a slot.
+ */
+enum Tag : uint8_t {
+    NULL_VALUE,
+    FALSE_VALUE,
+    TRUE_VALUE,
+    INT,
+    UINT,
+    DOUBLE,
+    STRING,
+    ARRAY,
+    OBJECT
+};
+
+const uint8_t INLINE_STRING = 1;    /**< Flag of a string whose characters are stored in the slot*/
+const size_t INLINE_CAPACITY = 7;   /**< Longest string that is stored in the slot, with its null terminator*/
+
+/**
+ * Read a little endian integer, it does not need to be aligned.
+ */
+template<class T>
+T load(const char* position)
+{
+    T value = 0;
+    for (size_t i = 0; i<sizeof(T); i++)
+        value |= static_cast<T>(static_cast<unsigned char>(position[i])) << (8*i);
+    return value;
+}
+
+/**
+ * Write a little endian integer into a buffer.
+ */
+template<class T>
+void store(char* position, T value)
+{
+    for (size_t i = 0; i<sizeof(T); i++)
+        position[i] = static_cast<char>(value >> (8*i));
+}
+
+/**
+ * Amount of elements or members of a slot.
+ */
+uint32_t countOf(const char* slot)
+{
+    return load<uint32_t>(slot+4);
+}
+
+/**
+ * Value, or offset of the string, elements or members of a slot.
+ */
+uint64_t payloadOf(const char* slot)
+{
+    return load<uint64_t>(slot+8);
+}
+
+/**
+ * Hash of a JsonStringView for the strings that are already written.
+ */
+struct ViewHash {
+    size_t operator()(JsonStringView view) const
+    {
+        return JsonObject::hash(view);
+    }
+};
+
+}
+
+/**
+ * Grows the image. Everything is addressed by offset, the buffer moves when it grows.
+ */
+class JsonImage::Builder {
+public:
+    std::string image;  /**< The image that is written*/
+
+    /**
+     * Append zeroed space, aligned to 8 bytes.
+     * @param size Amount of bytes.
+     * @return Offset of the space.
+     */
+    size_t allocate(size_t size)
+    {
+        size_t offset = image.size();
+        image.resize(offset+((size+7) & ~static_cast<size_t>(7)));
+        return offset;
+    }
+
+    void writeSlot(size_t slot, uint8_t tag, size_t count, uint64_t payload)
+    {
+        if (count>UINT32_MAX)
+            throw std::length_error("Too many values for: JsonImage");
+        char* position = &image[slot];
+        position[0] = static_cast<char>(tag);
+        store(position+4, static_cast<uint32_t>(count));
+        store(position+8, payload);
+    }
+
+    void writeString(size_t slot, JsonStringView string)
+    {
+        if (string.size()<=INLINE_CAPACITY) {
+            writeSlot(slot, STRING, string.size(), 0);
+            image[slot+1] = static_cast<char>(INLINE_STRING);
+            memcpy(&image[slot+8], string.data(), string.size());
+            return;
+        }
+        // Keys repeat in every element of an array, they are written once
+        auto found = written.find(string);
+        if (found==written.end()) {
+            size_t offset = allocate(string.size()+1);
+            memcpy(&image[offset], string.data(), string.size());
+            found = written.emplace(string, offset).first;
+        }
+        writeSlot(slot, STRING, string.size(), found->second);
+    }
+
+private:
+    std::unordered_map<JsonStringView, size_t, ViewHash> written;   /**< Offset of every long string*/
+};
+
+JsonImage::JsonImage()
+        :bytes(nullptr), length(0)
+{
+
+}
+
+JsonImage::JsonImage(const std::string& file_name)
+        :JsonImage()
+{
+    open(file_name);
+}
+
+void JsonImage::open(const std::string& file_name)
+{
+    close();
+    MappedFile file(file_name, MappedFile::RANDOM);
+    use(file.data(), file.size());
+    source = std::move(file);
+}
+
+void JsonImage::open(const char* data, size_t size)
+{
+    close();
+    use(data, size);
+}
+
+void JsonImage::use(const char* data, size_t size)
+{
+    if (size<HEADER_SIZE || memcmp(data, MAGIC, sizeof(MAGIC))!=0)
+        throw std::invalid_argument("Invalid json image: missing header");
+    if (load<uint32_t>(data+4)!=VERSION)
+        throw std::invalid_argument("Invalid json image: unsupported version");
+    if (load<uint64_t>(data+8)!=size)
+        throw std::invalid_argument("Invalid json image: the size does not match the header");
+    bytes = data;
+    length = size;
+    const char* rootSlot = nullptr;
+    try {
+        rootSlot = at(load<uint64_t>(data+16), JsonImageValue::SLOT_SIZE);
+    }
+    catch (const std::invalid_argument&) {
+        close();
+        throw;
+    }
+    if (rootSlot[0]!=OBJECT) {
+        close();
+        throw std::invalid_argument("Invalid json image: the root is not an object");
+    }
+}
+
+void JsonImage::close()
+{
+    bytes = nullptr;
+    length = 0;
+    source.close();
+}
+
+JsonImageValue JsonImage::root() const
+{
+    if (bytes==nullptr)
+        throw std::invalid_argument("JsonImage is empty");
+    return JsonImageValue(this, bytes+load<uint64_t>(bytes+16));
+}
+
+bool JsonImage::hasKey(JsonStringView key) const
+{
+    return bytes!=nullptr && root().find(key)!=nullptr;
+}
+
+JsonImageValue JsonImage::operator[](JsonStringView key) const
+{
+    const char* found = bytes==nullptr ? nullptr : root().find(key);
+    if (found==nullptr)
+        throw std::invalid_argument("There is no such key '"+std::string(key)+"'");
+    return JsonImageValue(this, found);
+}
+
+const char* JsonImage::at(uint64_t offset, uint64_t size) const
+{
+    if (offset>length || size>length-offset)
+        throw std::invalid_argument("Invalid json image: offset out of range");
+    return bytes+offset;
+}
+
+size_t JsonImage::indexSlots(size_t members)
+{
+    // At most half full, so probes stay short
+    size_t count = 32;
+    while (count<members*2)
+        count *= 2;
+    return count;
+}
+
+std::string JsonImage::build(const JsonObject& root)
+{
+    Builder builder;
+    builder.allocate(HEADER_SIZE);
+    size_t rootSlot = builder.allocate(JsonImageValue::SLOT_SIZE);
+    writeObject(builder, rootSlot, root);
+
+    char* header = &builder.image[0];
+    memcpy(header, MAGIC, sizeof(MAGIC));
+    store(header+4, VERSION);
+    store(header+8, static_cast<uint64_t>(builder.image.size()));
+    store(header+16, static_cast<uint64_t>(rootSlot));
+    return std::move(builder.image);
+}
+
+void JsonImage::save(const JsonObject& root, const std::string& file_name)
+{
+    std::string image = build(root);
+    std::ofstream file(file_name, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+        throw std::invalid_argument("Can not write file '"+file_name+'\'');
+    file.write(image.data(), static_cast<std::streamsize>(image.size()));
+    file.close();
+    if (file.fail())
+        throw std::invalid_argument("Can not write file '"+file_name+'\'');
+}
+
+void JsonImage::writeObject(Builder& builder, size_t slot, const JsonObject& object)
+{
+    const size_t count = object.size();
+    const size_t memberSize = 2*JsonImageValue::SLOT_SIZE;
+    const size_t slots = count>INDEX_THRESHOLD ? indexSlots(count) : 0;
+    size_t members = builder.allocate(count*memberSize+slots*sizeof(uint32_t));
+    builder.writeSlot(slot, OBJECT, count, members);
+
+    size_t position = members;
+    for (const auto& member : object) {
+        builder.writeString(position, member.first);
+        writeValue(builder, position+JsonImageValue::SLOT_SIZE, *member.second);
+        position += memberSize;
+    }
+
+    if (slots==0)
+        return;
+    size_t index = members+count*memberSize;
+    size_t mask = slots-1;
+    size_t i = 0;
+    for (const auto& member : object) {
+        size_t probe = JsonObject::hash(member.first) & mask;
+        while (load<uint32_t>(&builder.image[index+probe*sizeof(uint32_t)])!=0)
+            probe = (probe+1) & mask;
+        store(&builder.image[index+probe*sizeof(uint32_t)], static_cast<uint32_t>(++i));
+    }
+}
+
+void JsonImage::writeValue(Builder& builder, size_t slot, const JsonValue& value)
+{
+    switch (value.type()) {
+    case JSON_NULL:
+        builder.writeSlot(slot, NULL_VALUE, 0, 0);
+        return;
+    case JSON_BOOL:
+        builder.writeSlot(slot, value.getBoolValue() ? TRUE_VALUE : FALSE_VALUE, 0, 0);
+        return;
+    case JSON_INT:
+        builder.writeSlot(slot, INT, 0, static_cast<uint64_t>(value.getInt64Value()));
+        return;
+    case JSON_UINT:
+        builder.writeSlot(slot, UINT, 0, value.getUInt64Value());
+        return;
+    case JSON_NUM: {
+        double number = value.getNumberValue();
+        uint64_t bits;
+        memcpy(&bits, &number, sizeof(bits));
+        builder.writeSlot(slot, DOUBLE, 0, bits);
+        return;
+    }
+    case JSON_STRING:
+        builder.writeString(slot, value.getStringView());
+        return;
+    case JSON_ARRAY: {
+        const JsonArray& array = value.getArrayValue();
+        size_t elements = builder.allocate(array.size()*JsonImageValue::SLOT_SIZE);
+        builder.writeSlot(slot, ARRAY, array.size(), elements);
+        for (const JsonValue* element : array) {
+            writeValue(builder, elements, *element);
+            elements += JsonImageValue::SLOT_SIZE;
+        }
+        return;
+    }
+    case JSON_OBJ:
+        writeObject(builder, slot, value.getObjectValue());
+        return;
+    }
+}
+
+bool JsonImageValue::isBool() const
+{
+    return tag()==FALSE_VALUE || tag()==TRUE_VALUE;
+}
+
+bool JsonImageValue::isNull() const
+{
+    return tag()==NULL_VALUE;
+}
+
+bool JsonImageValue::isString() const
+{
+    return tag()==STRING;
+}
+
+bool JsonImageValue::isArray() const
+{
+    return tag()==ARRAY;
+}
+
+bool JsonImageValue::isObject() const
+{
+    return tag()==OBJECT;
+}
+
+bool JsonImageValue::isNumber() const
+{
+    return tag()==INT || tag()==UINT || tag()==DOUBLE;
+}
+
+bool JsonImageValue::isInteger() const
+{
+    return tag()==INT || tag()==UINT;
+}
+
+bool JsonImageValue::getBoolValue() const
+{
+    if (!isBool())
+        throw std::invalid_argument("Unexpected value for JsonBool");
+    return tag()==TRUE_VALUE;
+}
+
+double JsonImageValue::getNumberValue() const
+{
+    switch (tag()) {
+    case INT:
+        return static_cast<double>(static_cast<int64_t>(payloadOf(slot)));
+    case UINT:
+        return static_cast<double>(payloadOf(slot));
+    case DOUBLE: {
+        uint64_t bits = payloadOf(slot);
+        double value;
+        memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+    default:
+        throw std::invalid_argument("Invalid type for: JsonNumber");
+    }
+}
+
+int64_t JsonImageValue::getInt64Value() const
+{
+    if (!isInteger())
+        throw std::invalid_argument("Invalid type for: JsonInt");
+    if (tag()==UINT)
+        throw std::invalid_argument("Value out of range for: JsonInt");
+    return static_cast<int64_t>(payloadOf(slot));
+}
+
+uint64_t JsonImageValue::getUInt64Value() const
+{
+    if (!isInteger())
+        throw std::invalid_argument("Invalid type for: JsonUInt");
+    if (tag()==INT && static_cast<int64_t>(payloadOf(slot))<0)
+        throw std::invalid_argument("Value out of range for: JsonUInt");
+    return payloadOf(slot);
+}
+
+std::string JsonImageValue::getStringValue() const
+{
+    return std::string(getStringView());
+}
+
+JsonStringView JsonImageValue::getStringView() const
+{
+    if (!isString())
+        throw std::invalid_argument("Invalid type for: JsonString");
+    uint32_t size = countOf(slot);
+    if ((slot[1] & INLINE_STRING)!=0) {
+        if (size>INLINE_CAPACITY)
+            throw std::invalid_argument("Invalid json image: offset out of range");
+        return JsonStringView(slot+8, size);
+    }
+    // The null terminator is part of the string
+    return JsonStringView(image->at(payloadOf(slot), static_cast<uint64_t>(size)+1), size);
+}
+
+size_t JsonImageValue::size() const
+{
+    if (!isArray() && !isObject())
+        throw std::invalid_argument("Invalid type for: JsonArray or JsonObject");
+    return countOf(slot);
+}
+
+JsonImageValue JsonImageValue::operator[](int index) const
+{
+    if (!isArray())
+        throw std::invalid_argument("Object is not of type JsonArray");
+    uint32_t count = countOf(slot);
+    if (index>=0 && static_cast<uint32_t>(index)<count)
+        return JsonImageValue(image, children(1)+static_cast<size_t>(index)*SLOT_SIZE);
+    if (count==0)
+        throw std::invalid_argument("Index out of range, got ["+std::to_string(index)+"], but JsonArray is empty");
+    throw std::invalid_argument(
+            "Index out of range, got ["+std::to_string(index)+"], max is ["+std::to_string(count-1)+"]");
+}
+
+JsonImageValue JsonImageValue::operator[](JsonStringView key) const
+{
+    if (!isObject())
+        throw std::invalid_argument("Object is not of type JsonObject");
+    const char* found = find(key);
+    if (found==nullptr)
+        throw std::invalid_argument("Did not find key '"+std::string(key)+"' in JsonObject");
+    return JsonImageValue(image, found);
+}
+
+bool JsonImageValue::hasKey(JsonStringView key) const
+{
+    if (!isObject())
+        throw std::invalid_argument("JsonValue is not of type 'JsonObject'");
+    return find(key)!=nullptr;
+}
+
+const char* JsonImageValue::children(size_t slotsPerEntry) const
+{
+    return image->at(payloadOf(slot), static_cast<uint64_t>(countOf(slot))*slotsPerEntry*SLOT_SIZE);
+}
+
+const char* JsonImageValue::find(JsonStringView key) const
+{
+    const size_t count = countOf(slot);
+    const char* members = children(2);
+    if (count<=JsonImage::INDEX_THRESHOLD) {
+        for (size_t i = 0; i<count; i++) {
+            const char* member = members+i*2*SLOT_SIZE;
+            if (JsonImageValue(image, member).getStringView()==key)
+                return member+SLOT_SIZE;
+        }
+        return nullptr;
+    }
+
+    const size_t slots = JsonImage::indexSlots(count);
+    const char* index = image->at(payloadOf(slot)+count*2*SLOT_SIZE, slots*sizeof(uint32_t));
+    size_t mask = slots-1;
+    size_t probe = JsonObject::hash(key) & mask;
+    // A corrupt index may be full, so the probe never visits a slot twice
+    for (size_t i = 0; i<slots; i++) {
+        uint32_t position = load<uint32_t>(index+probe*sizeof(uint32_t));
+        if (position==0)
+            return nullptr;
+        if (position>count)
+            throw std::invalid_argument("Invalid json image: offset out of range");
+        const char* member = members+(position-1)*2*SLOT_SIZE;
+        if (JsonImageValue(image, member).getStringView()==key)
+            return member+SLOT_SIZE;
+        probe = (probe+1) & mask;
+    }
+    return nullptr;
+}
+
+JsonImageValue::Iterator JsonImageValue::begin() const
+{
+    if (!isArray() && !isObject())
+        throw std::invalid_argument("Invalid type for: JsonArray or JsonObject");
+    return Iterator(image, children(isObject() ? 2 : 1), isObject());
+}
+
+JsonImageValue::Iterator JsonImageValue::end() const
+{
+    if (!isArray() && !isObject())
+        throw std::invalid_argument("Invalid type for: JsonArray or JsonObject");
+    size_t slotsPerEntry = isObject() ? 2 : 1;
+    return Iterator(image, children(slotsPerEntry)+countOf(slot)*slotsPerEntry*SLOT_SIZE, isObject());
+}
+
+JsonStringView JsonImageValue::Iterator::keyView() const
+{
+    if (!object)
+        throw std::invalid_argument("Object is not of type JsonObject");
+    return JsonImageValue(image, position).getStringView();
+}
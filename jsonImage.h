@@ -0,0 +1,447 @@
+#ifndef JSONPARSER_JSONIMAGE_H
+#define JSONPARSER_JSONIMAGE_H
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include "jsonParser.h"
+
+class JsonImage;
+
+/**
+ * Read-only view of a value in a JsonImage.
+ * The view is a pointer to the fixed size slot of the value in the image. Every accessor reads the slot in place:
+ * array indices and sizes are a single read, keys are found with the hash index of the object or by comparing
+ * the keys of small objects. Nothing is decoded, copied or allocated, except by getStringValue and by errors.
+ * The accessors mirror the ones of JsonValue. A view stays valid as long as its image is open.
+ */
+class JsonImageValue {
+private:
+    const JsonImage* image; /**< Image the value lives in*/
+    const char* slot;       /**< Slot of the value*/
+
+public:
+
+    /**
+     * Creates a view of a value in an image.
+     * @param image Image the value lives in.
+     * @param slot Slot of the value.
+     */
+    JsonImageValue(const JsonImage* image, const char* slot)
+            :image(image), slot(slot)
+    {
+    }
+
+    /**
+     * Check whether the value is of JsonBool type.
+     * @return true if the type is a JsonBool.
+     */
+    bool isBool() const;
+
+    /**
+     * Check whether the value is of JsonNull type.
+     * @return true if the type is JsonNull.
+     */
+    bool isNull() const;
+
+    /**
+     * Check whether the value is of JsonString type.
+     * @return true if the type is JsonString.
+     */
+    bool isString() const;
+
+    /**
+     * Check whether the value is of JsonArray type.
+     * @return true if the type is JsonArray.
+     */
+    bool isArray() const;
+
+    /**
+     * Check whether the value is of JsonObject type.
+     * @return true if the type is JsonObject.
+     */
+    bool isObject() const;
+
+    /**
+     * Check whether the value is of JsonNum type.
+     * @return True if the type is JsonNum.
+     */
+    bool isNumber() const;
+
+    /**
+     * Check whether the value is a number that is stored as an exact 64-bit integer.
+     * @return True if getInt64Value or getUInt64Value can be used.
+     */
+    bool isInteger() const;
+
+    /**
+     * Get the boolean value.
+     * @throw invalid argument if the type is not JsonBool.
+     * @return the boolean value.
+     */
+    bool getBoolValue() const;
+
+    /**
+     * Get the number value.
+     * @throw invalid argument if the type is not JsonNum.
+     * @return the number value.
+     */
+    double getNumberValue() const;
+
+    /**
+     * Get the exact value of an integer.
+     * @throw invalid argument if the number is not an integer or does not fit in an int64_t.
+     * @return the integer value.
+     */
+    int64_t getInt64Value() const;
+
+    /**
+     * Get the exact value of a non-negative integer.
+     * @throw invalid argument if the number is not an integer or is negative.
+     * @return the integer value.
+     */
+    uint64_t getUInt64Value() const;
+
+    /**
+     * Get a copy of the string value.
+     * @throw invalid argument if the type is not JsonString.
+     * @return the string value.
+     */
+    std::string getStringValue() const;
+
+    /**
+     * Get the string value without copying it.
+     * @throw invalid argument if the type is not JsonString.
+     * @return View of the string in the image, valid as long as the image is open.
+     */
+    JsonStringView getStringView() const;
+
+    /**
+     * Get the null terminated characters of the string value.
+     * @throw invalid argument if the type is not JsonString.
+     * @return The characters in the image, valid as long as the image is open.
+     */
+    const char* c_str() const
+    {
+        return getStringView().data();
+    }
+
+    /**
+     * Get the amount of elements of an array or members of an object.
+     * @throw invalid argument if the type is not JsonArray or JsonObject.
+     * @return Amount of elements or members.
+     */
+    size_t size() const;
+
+    /**
+     * Index operator which can be used if the value is a JsonArray.
+     * @throw invalid argument if the type is not JsonArray.
+     * @throw invalid argument if the index is out of bounds.
+     * @param index Index in the array.
+     * @return View of the element.
+     */
+    JsonImageValue operator[](int index) const;
+
+    /**
+     * Index operator which can be used if the value is a JsonObject.
+     * @throw invalid argument if the type is not JsonObject.
+     * @throw invalid argument if the key cannot be found in the JsonObject.
+     * @param key Key associated to the value we want to get.
+     * @return View of the value associated with key.
+     */
+    JsonImageValue operator[](JsonStringView key) const;
+
+    /**
+     * Check whether a key exists if the value is a JsonObject.
+     * @throw invalid argument if the type is not JsonObject
+     * @param key Key to check
+     * @return True if the key can be found
+     */
+    bool hasKey(JsonStringView key) const;
+
+    /**
+     * Get the position of the value in the image.
+     * @return Pointer to the slot of the value.
+     */
+    const char* data() const
+    {
+        return slot;
+    }
+
+    /**
+     * Iterator over the elements of an array or the members of an object, in the order of the document.
+     */
+    class Iterator {
+    private:
+        const JsonImage* image; /**< Image the values live in*/
+        const char* position;   /**< Slot of the current element, or of the key of the current member*/
+        bool object;            /**< True if the iterator walks over object members*/
+
+    public:
+
+        /**
+         * Creates an iterator.
+         * @param image Image the values live in.
+         * @param position Slot of the element, or of the key of the member.
+         * @param object True if the iterator walks over object members.
+         */
+        Iterator(const JsonImage* image, const char* position, bool object)
+                :image(image), position(position), object(object)
+        {
+        }
+
+        /**
+         * Get the key of the current member without copying it.
+         * @throw invalid argument if the iterator walks over an array.
+         * @return View of the key, valid as long as the image is open.
+         */
+        JsonStringView keyView() const;
+
+        /**
+         * Get the key of the current member.
+         * @throw invalid argument if the iterator walks over an array.
+         * @return The key.
+         */
+        std::string key() const
+        {
+            return std::string(keyView());
+        }
+
+        /**
+         * Get the current element or member value.
+         * @return View of the value.
+         */
+        JsonImageValue value() const
+        {
+            return JsonImageValue(image, object ? position+SLOT_SIZE : position);
+        }
+
+        Iterator& operator++()
+        {
+            position += object ? 2*SLOT_SIZE : SLOT_SIZE;
+            return *this;
+        }
+
+        bool operator!=(const Iterator& other) const
+        {
+            return position!=other.position;
+        }
+
+        bool operator==(const Iterator& other) const
+        {
+            return position==other.position;
+        }
+
+        JsonImageValue operator*() const
+        {
+            return value();
+        }
+    };
+
+    /**
+     * Get an iterator to the first element or member.
+     * @throw invalid argument if the type is not JsonArray or JsonObject.
+     * @return The iterator.
+     */
+    Iterator begin() const;
+
+    /**
+     * Get an iterator past the last element or member.
+     * @throw invalid argument if the type is not JsonArray or JsonObject.
+     * @return The iterator.
+     */
+    Iterator end() const;
+
+private:
+
+    static const size_t SLOT_SIZE = 16;     /**< Size of the slot of every value and key*/
+
+    /**
+     * Get the type byte of the slot.
+     * @return The type.
+     */
+    uint8_t tag() const
+    {
+        return static_cast<uint8_t>(slot[0]);
+    }
+
+    /**
+     * Get the first slot of the elements or members, after checking that they are inside the image.
+     * @param slotsPerEntry 1 for array elements, 2 for object members.
+     * @return The first slot.
+     */
+    const char* children(size_t slotsPerEntry) const;
+
+    /**
+     * Find the value of a member if the value is a JsonObject.
+     * @param key Key to look for.
+     * @return Slot of the value, nullptr if the key does not exist.
+     */
+    const char* find(JsonStringView key) const;
+
+    friend class JsonImage;
+};
+
+/**
+ * Document image that is read in place, without parsing or decoding it.
+ * An image is written once from a parsed document and opened by memory mapping it: opening only checks the
+ * header, so the startup cost of a large document is the page faults of the values that are read. Processes
+ * that map the same image share its pages in the page cache.
+ * All references in the image are offsets from its start, so it can be mapped at any address. Every value has
+ * a slot of 16 bytes: the type, the length of a string or the size of an array or object, and the value itself
+ * or the offset of the string, the elements or the members. Elements are stored as consecutive slots, members as
+ * consecutive key and value slots, followed by a hash index for objects with more than INDEX_THRESHOLD members.
+ * Strings of up to 7 characters are stored in the slot. All integers are little endian. Every offset is checked
+ * against the size of the image before it is followed.
+ * parser.saveImage("config.ejsi");
+ * JsonImage image("config.ejsi");
+ * image["animations"][1]["name"].getStringView();
+ */
+class JsonImage {
+public:
+
+    static const uint32_t VERSION = 1;          /**< Version of the layout, images of other versions are rejected*/
+    static const size_t INDEX_THRESHOLD = 8;    /**< Objects with more members than this get a hash index*/
+
+    /**
+     * Default constructor, creates an empty image.
+     */
+    JsonImage();
+
+    /**
+     * Creates a JsonImage and immediately maps a file.
+     * @param file_name Path to the image.
+     */
+    explicit JsonImage(const std::string& file_name);
+
+    /**
+     * Deleted copy constructor, values refer to the image.
+     */
+    JsonImage(const JsonImage&) = delete;
+
+    /**
+     * Deleted assignment operator, values refer to the image.
+     */
+    JsonImage& operator=(const JsonImage&) = delete;
+
+    /**
+     * Maps an image file, the mapping stays alive as long as the image is open.
+     * @throw invalid argument if the file can not be opened or is not a valid image.
+     * @param file_name Path to the image.
+     */
+    void open(const std::string& file_name);
+
+    /**
+     * Uses an image in a buffer without copying it.
+     * The buffer must stay alive and unchanged as long as the image is used.
+     * @throw invalid argument if the buffer is not a valid image.
+     * @param data Start of the image.
+     * @param length Size of the image in bytes.
+     */
+    void open(const char* data, size_t length);
+
+    /**
+     * Get the root object.
+     * @throw invalid argument if no image is open.
+     * @return View of the root object.
+     */
+    JsonImageValue root() const;
+
+    /**
+     * Check whether a key exists in the root object.
+     * @param key Key to check
+     * @return True if the key exists
+     */
+    bool hasKey(JsonStringView key) const;
+
+    /**
+     * Index operator used to access the root object easily.
+     * @throw invalid argument if the key does not exist.
+     * @param key Key to access.
+     * @return View of the value associated with the key.
+     */
+    JsonImageValue operator[](JsonStringView key) const;
+
+    /**
+     * Get the size of the image.
+     * @return Size in bytes, 0 if no image is open.
+     */
+    size_t size() const
+    {
+        return length;
+    }
+
+    /**
+     * Unmaps the image, all views become invalid.
+     */
+    void close();
+
+    /**
+     * Write the image of a document.
+     * @param root Root object of the document.
+     * @return The image.
+     */
+    static std::string build(const JsonObject& root);
+
+    /**
+     * Write the image of a document to a file, an existing file is overwritten.
+     * @throw invalid argument if the file can not be written.
+     * @param root Root object of the document.
+     * @param file_name Path of the image.
+     */
+    static void save(const JsonObject& root, const std::string& file_name);
+
+private:
+
+    static const size_t HEADER_SIZE = 32;  /**< Magic, version, size and offset of the root slot*/
+
+    const char* bytes;      /**< Start of the image, nullptr if no image is open*/
+    size_t length;          /**< Size of the image in bytes*/
+    MappedFile source;      /**< Mapped image file, if it was opened from a file*/
+
+    class Builder;
+
+    /**
+     * Start using an image, after checking its header.
+     * @throw invalid argument if the header is not valid.
+     * @param data Start of the image.
+     * @param size Size of the image in bytes.
+     */
+    void use(const char* data, size_t size);
+
+    /**
+     * Write an object and all values nested in it.
+     * @param builder Receives the image.
+     * @param slot Offset of the slot of the object.
+     * @param object The object.
+     */
+    static void writeObject(Builder& builder, size_t slot, const JsonObject& object);
+
+    /**
+     * Write a value and all values nested in it.
+     * @param builder Receives the image.
+     * @param slot Offset of the slot of the value.
+     * @param value The value.
+     */
+    static void writeValue(Builder& builder, size_t slot, const JsonValue& value);
+
+    /**
+     * Get a part of the image, after checking that it is inside the image.
+     * @throw invalid argument if the part is not inside the image.
+     * @param offset Offset of the part.
+     * @param size Size of the part in bytes.
+     * @return Start of the part.
+     */
+    const char* at(uint64_t offset, uint64_t size) const;
+
+    /**
+     * Get the amount of slots of the hash index of an object.
+     * @param members Amount of members, more than INDEX_THRESHOLD.
+     * @return Amount of slots, a power of two.
+     */
+    static size_t indexSlots(size_t members);
+
+    friend class JsonImageValue;
+};
+
+#endif //JSONPARSER_JSONIMAGE_H
@@ -0,0 +1,176 @@
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include "jsonLines.h"
+#include "jsonValueBuilder.h"
+
+namespace {
+
+const size_t MIN_RANGE_SIZE = 64*1024;  /**< Smaller ranges cost more to hand out than to parse*/
+const size_t RANGES_PER_THREAD = 8;     /**< More ranges than threads, so threads that finish early help out*/
+
+/**
+ * Check whether a line only contains whitespace.
+ * @param begin First character of the line.
+ * @param end End of the line.
+ * @return True if the line is empty.
+ */
+bool isBlank(const char* begin, const char* end)
+{
+    for (; begin<end; ++begin) {
+        if (*begin!=' ' && *begin!='\t' && *begin!='\r')
+            return false;
+    }
+    return true;
+}
+
+}
+
+JsonLines::JsonLines(unsigned threads)
+        :ownPool(new JsonThreadPool(threads)), pool(ownPool.get())
+{
+
+}
+
+JsonLines::JsonLines(JsonThreadPool& pool)
+        :pool(&pool)
+{
+
+}
+
+void JsonLines::parse(const std::string& file_name)
+{
+    MappedFile file(file_name);
+    parse(file.data(), file.size());
+}
+
+void JsonLines::parseString(const std::string& json)
+{
+    parse(json.data(), json.size());
+}
+
+void JsonLines::parse(const char* data, size_t length)
+{
+    clear();
+    try {
+        read(data, length, nullptr);
+    }
+    catch (...) {
+        clear();
+        throw;
+    }
+}
+
+void JsonLines::forEach(const std::string& file_name, const RecordFunction& function)
+{
+    MappedFile file(file_name);
+    forEach(file.data(), file.size(), function);
+}
+
+void JsonLines::forEach(const char* data, size_t length, const RecordFunction& function)
+{
+    read(data, length, &function);
+}
+
+JsonValue& JsonLines::operator[](size_t index) const
+{
+    if (index>=records.size()) {
+        if (records.empty())
+            throw std::invalid_argument("Index out of range, got ["+std::to_string(index)+"], but there are no records");
+        throw std::invalid_argument("Index out of range, got ["+std::to_string(index)+"], max is ["
+                                    +std::to_string(records.size()-1)+"]");
+    }
+    return *records[index];
+}
+
+size_t JsonLines::memoryUsage() const
+{
+    size_t result = 0;
+    for (const auto& worker : workers)
+        result += worker->arena.bytesUsed();
+    return result;
+}
+
+void JsonLines::clear()
+{
+    records.clear();
+    for (auto& worker : workers)
+        worker->arena.release();
+}
+
+void JsonLines::read(const char* data, size_t length, const RecordFunction* function)
+{
+    // Split at the first newline after every target position, a newline never occurs inside a record
+    size_t rangeCount = std::max<size_t>(1, std::min(length/MIN_RANGE_SIZE, pool->size()*RANGES_PER_THREAD));
+    std::vector<Range> ranges;
+    const char* begin = data;
+    const char* end = data+length;
+    for (size_t i = 1; i<=rangeCount && begin<end; i++) {
+        const char* rangeEnd = end;
+        if (i<rangeCount) {
+            const char* target = std::max(begin, data+length/rangeCount*i);
+            const void* newline = memchr(target, '\n', static_cast<size_t>(end-target));
+            if (newline!=nullptr)
+                rangeEnd = static_cast<const char*>(newline)+1;
+        }
+        ranges.push_back(Range{begin, rangeEnd, 0, {}, nullptr});
+        begin = rangeEnd;
+    }
+
+    // Line numbers of the ranges
+    pool->run(ranges.size(), [&ranges](size_t task, unsigned) {
+        ranges[task].firstLine = static_cast<int>(std::count(ranges[task].begin, ranges[task].end, '\n'));
+    });
+    int line = 1;
+    for (Range& range : ranges) {
+        int lines = range.firstLine;
+        range.firstLine = line;
+        line += lines;
+    }
+
+    while (workers.size()<pool->size())
+        workers.emplace_back(new Worker());
+    pool->run(ranges.size(), [this, &ranges, function](size_t task, unsigned thread) {
+        readRange(ranges[task], *workers[thread], function);
+    });
+
+    for (Range& range : ranges) {
+        if (range.error!=nullptr)
+            std::rethrow_exception(range.error);
+    }
+    if (function==nullptr) {
+        for (Range& range : ranges)
+            records.insert(records.end(), range.records.begin(), range.records.end());
+    }
+}
+
+void JsonLines::readRange(Range& range, Worker& worker, const RecordFunction* function)
+{
+    JsonArena& arena = function==nullptr ? worker.arena : worker.scratch;
+    JsonValueBuilder builder(arena);
+    int line = range.firstLine;
+    for (const char* position = range.begin; position<range.end; line++) {
+        const void* newline = memchr(position, '\n', static_cast<size_t>(range.end-position));
+        const char* lineEnd = newline==nullptr ? range.end : static_cast<const char*>(newline);
+        if (!isBlank(position, lineEnd)) {
+            builder.reset();
+            try {
+                worker.reader.parse(position, static_cast<size_t>(lineEnd-position), builder, line);
+                if (function==nullptr)
+                    range.records.push_back(builder.value());
+                else
+                    (*function)(line, *builder.value());
+            }
+            catch (...) {
+                // Records after the error are still read, the caller gets the first error of the text
+                if (range.error==nullptr)
+                    range.error = std::current_exception();
+            }
+            if (function!=nullptr)
+                arena.release();
+        }
+        if (lineEnd==range.end)
+            break;
+        position = lineEnd+1;
+    }
+}
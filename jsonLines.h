@@ -0,0 +1,185 @@
+#ifndef JSONPARSER_JSONLINES_H
+#define JSONPARSER_JSONLINES_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <functional>
+#include "jsonParser.h"
+#include "jsonThreadPool.h"
+
+/**
+ * Parser for newline delimited json (NDJSON, JSON Lines): one object per line, ex. a log with a record per line.
+ * The text is split at newlines into ranges which are parsed in parallel on a thread pool. Every thread of the
+ * pool has its own reader and arena, so the threads share nothing while they parse. Empty lines are skipped.
+ * Records are either kept in the order of the text, or passed to a function as soon as they are read.
+ * Line numbers in errors and of records are lines of the complete text.
+ */
+class JsonLines {
+public:
+
+    /**
+     * Function that receives a record, called concurrently from the threads of the pool.
+     * The record and its values are only valid during the call.
+     */
+    using RecordFunction = std::function<void(int line, JsonValue& record)>;
+
+    /**
+     * Creates a parser with its own thread pool.
+     * @param threads Amount of threads, 0 to use one per hardware thread.
+     */
+    explicit JsonLines(unsigned threads = 0);
+
+    /**
+     * Creates a parser that uses an existing thread pool.
+     * @param pool Thread pool, must stay alive as long as the parser.
+     */
+    explicit JsonLines(JsonThreadPool& pool);
+
+    /**
+     * Deleted copy constructor. Copying is not allowed.
+     */
+    JsonLines(const JsonLines&) = delete;
+
+    /**
+     * Deleted assignment operator. Assigning is not allowed.
+     */
+    JsonLines& operator=(const JsonLines&) = delete;
+
+    /**
+     * Parses a file by memory mapping it and keeps the records in order.
+     * @throw invalid argument if the file can not be opened.
+     * @throw ParseError if a record is not valid json, the first error in the text is thrown and no records are kept.
+     * @param file_name Path to input file.
+     */
+    void parse(const std::string& file_name);
+
+    /**
+     * Parses text from a buffer and keeps the records in order.
+     * The buffer is not used anymore after parsing.
+     * @throw ParseError if a record is not valid json, the first error in the text is thrown and no records are kept.
+     * @param data Start of the text.
+     * @param length Amount of characters in the buffer.
+     */
+    void parse(const char* data, size_t length);
+
+    /**
+     * Parses text from a string and keeps the records in order.
+     * @throw ParseError if a record is not valid json, the first error in the text is thrown and no records are kept.
+     * @param json String containing the text.
+     */
+    void parseString(const std::string& json);
+
+    /**
+     * Parses a file by memory mapping it and passes every record to a function, in no particular order.
+     * The kept records are not changed.
+     * @throw invalid argument if the file can not be opened.
+     * @throw ParseError if a record is not valid json.
+     * @param file_name Path to input file.
+     * @param function Receives the records, see forEach(const char*, size_t, const RecordFunction&).
+     */
+    void forEach(const std::string& file_name, const RecordFunction& function);
+
+    /**
+     * Parses text from a buffer and passes every record to a function, in no particular order.
+     * The kept records are not changed. Every valid record is passed on, even after a broken record or an
+     * exception of the function. The first of these errors in the text is thrown after all records are read.
+     * @throw ParseError if a record is not valid json.
+     * @param data Start of the text.
+     * @param length Amount of characters in the buffer.
+     * @param function Receives the records.
+     */
+    void forEach(const char* data, size_t length, const RecordFunction& function);
+
+    /**
+     * Get the amount of kept records.
+     * @return Amount of records.
+     */
+    size_t size() const
+    {
+        return records.size();
+    }
+
+    /**
+     * Get a kept record.
+     * @throw invalid argument if the index is out of bounds.
+     * @param index Index of the record, in the order of the text.
+     * @return The record, a JsonObject.
+     */
+    JsonValue& operator[](size_t index) const;
+
+    /**
+     * Get an iterator to the first kept record.
+     * @return The iterator.
+     */
+    std::vector<JsonValue*>::const_iterator begin() const
+    {
+        return records.begin();
+    }
+
+    /**
+     * Get an iterator past the last kept record.
+     * @return The iterator.
+     */
+    std::vector<JsonValue*>::const_iterator end() const
+    {
+        return records.end();
+    }
+
+    /**
+     * Get the amount of memory the kept records use.
+     * @return Amount of bytes allocated from the arenas of the records.
+     */
+    size_t memoryUsage() const;
+
+    /**
+     * Removes all kept records.
+     */
+    void clear();
+
+private:
+
+    /**
+     * Parse state of one thread of the pool.
+     */
+    struct Worker {
+        JsonReader reader;  /**< Tokenizer of the records, its buffers are reused*/
+        JsonArena arena;    /**< Arena of the kept records*/
+        JsonArena scratch;  /**< Arena of records that are passed to a function, released after every record*/
+    };
+
+    /**
+     * Part of the text that ends after a newline, read by one task.
+     */
+    struct Range {
+        const char* begin;          /**< First character*/
+        const char* end;            /**< Past the last character*/
+        int firstLine;              /**< Line of the first character*/
+        std::vector<JsonValue*> records;    /**< Kept records of the range*/
+        std::exception_ptr error;   /**< First error of the range*/
+    };
+
+    std::unique_ptr<JsonThreadPool> ownPool;    /**< Pool created by the parser, if no pool was given*/
+    JsonThreadPool* pool;                       /**< Pool that runs the tasks*/
+    std::vector<std::unique_ptr<Worker>> workers;   /**< State of every thread of the pool*/
+    std::vector<JsonValue*> records;            /**< Kept records in the order of the text*/
+
+    /**
+     * Split the text into ranges and read them in parallel.
+     * @throw ParseError if a record is not valid json, the first error in the text is thrown.
+     * @param data Start of the text.
+     * @param length Amount of characters in the text.
+     * @param function Receives the records, nullptr to keep them instead.
+     */
+    void read(const char* data, size_t length, const RecordFunction* function);
+
+    /**
+     * Read the records of a range.
+     * @param range The range.
+     * @param worker State of the thread that reads the range.
+     * @param function Receives the records, nullptr to keep them in the range instead.
+     */
+    static void readRange(Range& range, Worker& worker, const RecordFunction* function);
+};
+
+#endif //JSONPARSER_JSONLINES_H
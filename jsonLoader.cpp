@@ -0,0 +1,147 @@
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <stdexcept>
+#include "jsonLoader.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define JSONPARSER_USE_DIRENT
+#include <dirent.h>
+#include <sys/stat.h>
+#endif
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double secondsBetween(Clock::time_point start, Clock::time_point end)
+{
+    return std::chrono::duration<double>(end-start).count();
+}
+
+/**
+ * Check whether a name ends in a suffix.
+ * @param name Name to check.
+ * @param suffix Suffix to look for.
+ * @return True if the name ends in the suffix.
+ */
+bool endsWith(const std::string& name, const std::string& suffix)
+{
+    return name.size()>=suffix.size() && name.compare(name.size()-suffix.size(), suffix.size(), suffix)==0;
+}
+
+}
+
+JsonLoader::JsonLoader(unsigned threads)
+        :ownPool(new JsonThreadPool(threads)), pool(ownPool.get())
+{
+
+}
+
+JsonLoader::JsonLoader(JsonThreadPool& pool)
+        :pool(&pool)
+{
+
+}
+
+std::vector<JsonLoadResult> JsonLoader::loadAll(const std::vector<std::string>& paths)
+{
+    Clock::time_point start = Clock::now();
+    std::vector<JsonLoadResult> results(paths.size());
+    for (size_t i = 0; i<paths.size(); i++)
+        results[i].path = paths[i];
+
+    while (workers.size()<pool->size())
+        workers.emplace_back(new Worker());
+    for (auto& worker : workers) {
+        worker->bytes = 0;
+        worker->ioSeconds = 0;
+        worker->parseSeconds = 0;
+    }
+    pool->run(results.size(), [this, &results](size_t task, unsigned thread) {
+        load(results[task], *workers[thread]);
+    });
+
+    stats = JsonLoadStatistics();
+    stats.files = results.size();
+    stats.failed = static_cast<size_t>(std::count_if(results.begin(), results.end(), [](const JsonLoadResult& result) {
+        return !result.ok();
+    }));
+    for (auto& worker : workers) {
+        stats.bytes += worker->bytes;
+        stats.ioSeconds += worker->ioSeconds;
+        stats.parseSeconds += worker->parseSeconds;
+        // The buffers are only needed during a load, a large file should not keep its memory until the next one
+        std::string().swap(worker->buffer);
+    }
+    stats.wallSeconds = secondsBetween(start, Clock::now());
+    return results;
+}
+
+std::vector<JsonLoadResult> JsonLoader::loadDirectory(const std::string& directory, const std::string& extension)
+{
+    std::vector<std::string> paths;
+#ifdef JSONPARSER_USE_DIRENT
+    DIR* entries = opendir(directory.c_str());
+    if (entries==nullptr)
+        throw std::invalid_argument("Directory not found '"+directory+'\'');
+    std::string prefix = directory.empty() || directory.back()=='/' ? directory : directory+'/';
+    for (dirent* entry = readdir(entries); entry!=nullptr; entry = readdir(entries)) {
+        std::string name = entry->d_name;
+        if (name=="." || name==".." || !endsWith(name, extension))
+            continue;
+        struct stat info{};
+        if (stat((prefix+name).c_str(), &info)==0 && S_ISREG(info.st_mode))
+            paths.push_back(prefix+name);
+    }
+    closedir(entries);
+#else
+    throw std::invalid_argument("Listing directory '"+directory+"' is not supported on this system");
+#endif
+    std::sort(paths.begin(), paths.end());
+    return loadAll(paths);
+}
+
+void JsonLoader::load(JsonLoadResult& result, Worker& worker)
+{
+    Clock::time_point start = Clock::now();
+    try {
+        readFile(result.path, worker.buffer);
+    }
+    catch (const std::invalid_argument& error) {
+        result.error = error.what();
+        worker.ioSeconds += secondsBetween(start, Clock::now());
+        return;
+    }
+    Clock::time_point read = Clock::now();
+    worker.ioSeconds += secondsBetween(start, read);
+    worker.bytes += worker.buffer.size();
+
+    std::unique_ptr<JsonParser> document(new JsonParser());
+    try {
+        document->parse(worker.buffer.data(), worker.buffer.size(), worker.reader);
+        result.document = std::move(document);
+    }
+    catch (const std::exception& error) {
+        // Not only ParseError, ex. a duplicate key, one broken file must not stop the others
+        result.error = error.what();
+    }
+    worker.parseSeconds += secondsBetween(read, Clock::now());
+}
+
+void JsonLoader::readFile(const std::string& path, std::string& buffer)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open())
+        throw std::invalid_argument("File not found '"+path+'\'');
+
+    buffer.clear();
+    file.seekg(0, std::ios::end);
+    std::streamoff size = file.tellg();
+    if (size>0) {
+        buffer.resize(static_cast<size_t>(size));
+        file.seekg(0, std::ios::beg);
+        file.read(&buffer[0], size);
+        buffer.resize(static_cast<size_t>(file.gcount()));
+    }
+}
@@ -0,0 +1,133 @@
+#ifndef JSONPARSER_JSONLOADER_H
+#define JSONPARSER_JSONLOADER_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include "jsonParser.h"
+#include "jsonThreadPool.h"
+
+/**
+ * Outcome of loading one file.
+ */
+struct JsonLoadResult {
+    std::string path;                       /**< Path of the file*/
+    std::unique_ptr<JsonParser> document;   /**< Parsed document, nullptr if the file could not be loaded*/
+    std::string error;                      /**< Message of the error if the file could not be loaded*/
+
+    /**
+     * Check whether the file was loaded.
+     * @return True if the document was parsed.
+     */
+    bool ok() const
+    {
+        return document!=nullptr;
+    }
+};
+
+/**
+ * Where the time of the last load went.
+ * The I/O and parse times are added up over all threads, so on several threads their sum is larger than
+ * the wall clock time.
+ */
+struct JsonLoadStatistics {
+    size_t files = 0;           /**< Amount of files*/
+    size_t failed = 0;          /**< Amount of files that could not be read or parsed*/
+    size_t bytes = 0;           /**< Amount of bytes read*/
+    double ioSeconds = 0;       /**< Time spent opening and reading files*/
+    double parseSeconds = 0;    /**< Time spent parsing*/
+    double wallSeconds = 0;     /**< Wall clock time of the complete load*/
+};
+
+/**
+ * Loads many json files at once, ex. the configuration files of an application at startup.
+ * Every file is read and parsed into its own JsonParser by the threads of a pool, a thread that runs out of files
+ * steals files of another thread. Every thread reads into its own buffer and parses with its own reader, so their
+ * buffers are reused for all files of the thread. A file that can not be read or parsed does not stop the others,
+ * its error is kept in its result.
+ */
+class JsonLoader {
+public:
+
+    /**
+     * Creates a loader with its own thread pool.
+     * @param threads Amount of threads, 0 to use one per hardware thread.
+     */
+    explicit JsonLoader(unsigned threads = 0);
+
+    /**
+     * Creates a loader that uses an existing thread pool.
+     * @param pool Thread pool, must stay alive as long as the loader.
+     */
+    explicit JsonLoader(JsonThreadPool& pool);
+
+    /**
+     * Deleted copy constructor. Copying is not allowed.
+     */
+    JsonLoader(const JsonLoader&) = delete;
+
+    /**
+     * Deleted assignment operator. Assigning is not allowed.
+     */
+    JsonLoader& operator=(const JsonLoader&) = delete;
+
+    /**
+     * Loads files in parallel.
+     * @param paths Paths of the files.
+     * @return Result of every file, in the order of the paths.
+     */
+    std::vector<JsonLoadResult> loadAll(const std::vector<std::string>& paths);
+
+    /**
+     * Loads the files of a directory in parallel, subdirectories are not searched.
+     * @throw invalid argument if the directory can not be opened.
+     * @param directory Path of the directory.
+     * @param extension Only files with names ending in this are loaded, empty to load all files.
+     * @return Result of every file, sorted by path.
+     */
+    std::vector<JsonLoadResult> loadDirectory(const std::string& directory, const std::string& extension = ".json");
+
+    /**
+     * Get the statistics of the last load.
+     * @return The statistics.
+     */
+    const JsonLoadStatistics& statistics() const
+    {
+        return stats;
+    }
+
+private:
+
+    /**
+     * Load state of one thread of the pool.
+     */
+    struct Worker {
+        JsonReader reader;          /**< Tokenizer of the files, its buffers are reused*/
+        std::string buffer;         /**< Contents of the current file, its capacity is reused*/
+        size_t bytes = 0;           /**< Amount of bytes read by the thread*/
+        double ioSeconds = 0;       /**< Time the thread spent reading*/
+        double parseSeconds = 0;    /**< Time the thread spent parsing*/
+    };
+
+    std::unique_ptr<JsonThreadPool> ownPool;    /**< Pool created by the loader, if no pool was given*/
+    JsonThreadPool* pool;                       /**< Pool that runs the tasks*/
+    std::vector<std::unique_ptr<Worker>> workers;   /**< State of every thread of the pool*/
+    JsonLoadStatistics stats;                   /**< Statistics of the last load*/
+
+    /**
+     * Read and parse one file.
+     * @param result Result of the file, its path is set.
+     * @param worker State of the thread that loads the file.
+     */
+    static void load(JsonLoadResult& result, Worker& worker);
+
+    /**
+     * Read a complete file into a buffer.
+     * @throw invalid argument if the file can not be opened.
+     * @param path Path of the file.
+     * @param buffer Receives the contents.
+     */
+    static void readFile(const std::string& path, std::string& buffer);
+};
+
+#endif //JSONPARSER_JSONLOADER_H
@@ -0,0 +1,59 @@
+#ifndef JSONPARSER_JSONNUMBER_H
+#define JSONPARSER_JSONNUMBER_H
+
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * Result of parsing a json number.
+ * Integers that fit in 64 bits are kept exact, everything else is converted to the nearest double.
+ * Parsing never depends on the current locale.
+ */
+struct JsonNumber {
+
+    /**
+     * Storage of the parsed number.
+     */
+    enum Kind {
+        INT,    /**< Integer that fits in an int64_t*/
+        UINT,   /**< Integer that only fits in an uint64_t*/
+        DOUBLE  /**< Number with a fraction or exponent, or an integer that does not fit in 64 bits*/
+    };
+
+    Kind kind;                      /**< Storage of the number*/
+    union {
+        int64_t int_value;          /**< Value if kind is INT*/
+        uint64_t uint_value;        /**< Value if kind is UINT*/
+        double double_value;        /**< Value if kind is DOUBLE*/
+    };
+
+    /**
+     * Parse a number from a buffer.
+     * The accepted format is -?digits(.digits)?([eE][+-]?digits)?, leading zeros are allowed.
+     * Integers are parsed exactly, doubles are rounded correctly: small values with an exact
+     * multiplication, others with the Eisel-Lemire algorithm and the rare remaining cases with strtod.
+     * @param begin First character of the number.
+     * @param end End of the buffer.
+     * @param result Receives the parsed number.
+     * @return Pointer past the last character of the number, nullptr if there is no valid number at begin.
+     */
+    static const char* parse(const char* begin, const char* end, JsonNumber& result);
+
+    /**
+     * Get the number as a double, integers are rounded to the nearest double.
+     * @return The value.
+     */
+    double toDouble() const
+    {
+        switch (kind) {
+        case INT:
+            return static_cast<double>(int_value);
+        case UINT:
+            return static_cast<double>(uint_value);
+        default:
+            return double_value;
+        }
+    }
+};
+
+#endif //JSONPARSER_JSONNUMBER_H
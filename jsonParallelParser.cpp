@@ -0,0 +1,275 @@
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include "jsonParallelParser.h"
+#include "jsonCursor.h"
+#include "jsonValueBuilder.h"
+
+namespace {
+
+const size_t MIN_CHUNK_SIZE = 256*1024; /**< Smaller chunks cost more to hand out than to scan*/
+const size_t CHUNKS_PER_THREAD = 8;     /**< More chunks than threads, so threads that finish early help out*/
+
+bool isWhiteSpace(char c)
+{
+    return c==' ' || c=='\t' || c=='\n' || c=='\r';
+}
+
+/**
+ * Check whether a quote is escaped. Backslashes only occur in strings, so this does not depend on whether
+ * the quote starts or ends a string.
+ * @param text Start of the text.
+ * @param quote The quote.
+ * @return True if the quote follows an odd amount of backslashes.
+ */
+bool isEscaped(const char* text, const char* quote)
+{
+    const char* position = quote;
+    while (position>text && position[-1]=='\\')
+        --position;
+    return (quote-position)%2==1;
+}
+
+/**
+ * Find the closing quote of a string.
+ * @param text Start of the text.
+ * @param position First character to look at.
+ * @param end End of the part to look in.
+ * @return The closing quote, nullptr if the string does not end before end.
+ */
+const char* findClosingQuote(const char* text, const char* position, const char* end)
+{
+    while (position<end) {
+        auto* quote = static_cast<const char*>(memchr(position, '"', static_cast<size_t>(end-position)));
+        if (quote==nullptr)
+            return nullptr;
+        if (!isEscaped(text, quote))
+            return quote;
+        position = quote+1;
+    }
+    return nullptr;
+}
+
+}
+
+JsonParallelParser::JsonParallelParser(unsigned threads)
+        :ownPool(new JsonThreadPool(threads)), pool(ownPool.get()), rootValue(nullptr)
+{
+
+}
+
+JsonParallelParser::JsonParallelParser(JsonThreadPool& pool)
+        :pool(&pool), rootValue(nullptr)
+{
+
+}
+
+void JsonParallelParser::parse(const std::string& file_name)
+{
+    MappedFile file(file_name);
+    parse(file.data(), file.size());
+}
+
+void JsonParallelParser::parseString(const std::string& json)
+{
+    parse(json.data(), json.size());
+}
+
+void JsonParallelParser::parse(const char* data, size_t length)
+{
+    clear();
+    while (workers.size()<pool->size())
+        workers.emplace_back(new Worker());
+
+    const char* open = data;
+    const char* close = data+length;
+    while (open<close && isWhiteSpace(*open))
+        ++open;
+    while (close>open && isWhiteSpace(close[-1]))
+        --close;
+    std::vector<Range> ranges;
+    if (pool->size()>1 && close-open>=2 && *open=='[' && close[-1]==']')
+        ranges = split(data, length, open, close-1);
+    if (ranges.size()<2) {
+        parseSerial(data, length);
+        return;
+    }
+
+    pool->run(ranges.size(), [this, &ranges](size_t task, unsigned thread) {
+        readRange(ranges[task], *workers[thread]);
+    });
+    size_t count = 0;
+    for (Range& range : ranges) {
+        if (range.error!=nullptr) {
+            // Read the text again with a single thread, so the error is the same as without splitting.
+            // If the single thread reads it without error, the split was wrong and its result is kept
+            clear();
+            parseSerial(data, length);
+            return;
+        }
+        count += range.elements.size();
+    }
+
+    // Stitch the elements of all threads into the root array
+    JsonArena& arena = workers[0]->arena;
+    rootValue = arena.create<JsonValue>(ValueType::JSON_ARRAY, &arena);
+    JsonArray& array = rootValue->getArrayValue();
+    array.reserve(count);
+    for (Range& range : ranges)
+        array.insert(array.end(), range.elements.begin(), range.elements.end());
+}
+
+JsonValue& JsonParallelParser::root() const
+{
+    if (rootValue==nullptr)
+        throw std::invalid_argument("Nothing was parsed");
+    return *rootValue;
+}
+
+size_t JsonParallelParser::memoryUsage() const
+{
+    size_t result = 0;
+    for (const auto& worker : workers)
+        result += worker->arena.bytesUsed();
+    return result;
+}
+
+void JsonParallelParser::clear()
+{
+    rootValue = nullptr;
+    for (auto& worker : workers)
+        worker->arena.release();
+}
+
+void JsonParallelParser::parseSerial(const char* data, size_t length)
+{
+    Worker& worker = *workers[0];
+    JsonCursor cursor(data, length);
+    if (worker.index.build(data, length))
+        cursor.useStructuralIndex(worker.index);
+    cursor.skipWhiteSpace();
+    if (cursor.atEnd())
+        throw ParseError(cursor.line(), "Missing root value");
+
+    JsonValueBuilder builder(worker.arena);
+    try {
+        worker.reader.readValue(cursor, builder);
+        cursor.skipWhiteSpace();
+        if (!cursor.atEnd())
+            throw cursor.error("Unexpected token: '"+std::string(1, cursor.peek())+"'");
+    }
+    catch (...) {
+        clear();
+        throw;
+    }
+    rootValue = builder.value();
+}
+
+std::vector<JsonParallelParser::Range> JsonParallelParser::split(const char* data, size_t length, const char* open,
+                                                                 const char* close)
+{
+    size_t chunkCount = std::max<size_t>(1, std::min(length/MIN_CHUNK_SIZE, pool->size()*CHUNKS_PER_THREAD));
+    std::vector<Chunk> chunks(chunkCount);
+    for (size_t i = 0; i<chunkCount; i++) {
+        chunks[i].begin = data+length/chunkCount*i;
+        chunks[i].end = i+1<chunkCount ? data+length/chunkCount*(i+1) : data+length;
+    }
+
+    // Every chunk is summarized for both cases, starting inside or outside a string
+    pool->run(chunks.size(), [data, &chunks](size_t task, unsigned) {
+        chunks[task].summary = JsonStructuralIndex::summarize(data, chunks[task].begin, chunks[task].end);
+    });
+    bool inString = false;
+    long depth = 0;
+    int line = 1;
+    for (Chunk& chunk : chunks) {
+        // A single quote outside a string starts a single quoted string, the quotes of the summary do not cover those
+        if (chunk.summary.singleQuotes[inString])
+            return {};
+        chunk.inString = inString;
+        chunk.depth = depth;
+        chunk.firstLine = line;
+        depth += chunk.summary.depthChange[inString];
+        inString = inString!=chunk.summary.oddQuotes;
+        line += static_cast<int>(chunk.summary.newLines);
+    }
+    if (depth!=0 || inString)
+        return {};
+
+    // The first comma of every chunk between elements of the root array
+    pool->run(chunks.size(), [data, open, close, &chunks](size_t task, unsigned) {
+        Chunk& chunk = chunks[task];
+        chunk.split = nullptr;
+        long depth = chunk.depth;
+        const char* position = std::max(chunk.begin, open);
+        const char* end = std::min(chunk.end, close);
+        if (chunk.inString && position==chunk.begin) {
+            const char* quote = findClosingQuote(data, position, end);
+            position = quote==nullptr ? end : quote+1;
+        }
+        while (position<end && chunk.split==nullptr) {
+            switch (*position) {
+            case '{':
+            case '[':
+                depth++;
+                break;
+            case '}':
+            case ']':
+                depth--;
+                break;
+            case ',':
+                if (depth==1)
+                    chunk.split = position+1;
+                break;
+            case '"': {
+                const char* quote = findClosingQuote(data, position+1, end);
+                position = quote==nullptr ? end : quote+1;
+                continue;
+            }
+            default:
+                break;
+            }
+            ++position;
+        }
+        if (chunk.split!=nullptr)
+            chunk.splitLine = chunk.firstLine+static_cast<int>(std::count(chunk.begin, chunk.split, '\n'));
+    });
+
+    std::vector<Range> ranges;
+    ranges.push_back(Range{open+1, close, static_cast<int>(std::count(data, open, '\n'))+1, {}, nullptr});
+    for (Chunk& chunk : chunks) {
+        if (chunk.split==nullptr || chunk.split<=ranges.back().begin)
+            continue;
+        ranges.back().end = chunk.split-1;
+        ranges.push_back(Range{chunk.split, close, chunk.splitLine, {}, nullptr});
+    }
+    return ranges;
+}
+
+void JsonParallelParser::readRange(Range& range, Worker& worker)
+{
+    size_t length = static_cast<size_t>(range.end-range.begin);
+    JsonCursor cursor(range.begin, length, range.firstLine);
+    if (worker.index.build(range.begin, length))
+        cursor.useStructuralIndex(worker.index);
+    JsonValueBuilder builder(worker.arena);
+    try {
+        // Every range holds at least one element, an empty root array is not split
+        while (true) {
+            cursor.skipWhiteSpace();
+            if (cursor.atEnd())
+                throw ParseError(cursor.line(), "Expected new object after ','");
+            builder.reset();
+            worker.reader.readValue(cursor, builder);
+            range.elements.push_back(builder.value());
+            cursor.skipWhiteSpace();
+            if (cursor.atEnd())
+                return;
+            if (!cursor.expectChar(','))
+                throw cursor.error("Missing ','");
+        }
+    }
+    catch (...) {
+        range.error = std::current_exception();
+    }
+}
@@ -0,0 +1,156 @@
+#ifndef JSONPARSER_JSONPARALLELPARSER_H
+#define JSONPARSER_JSONPARALLELPARSER_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include "jsonParser.h"
+#include "jsonThreadPool.h"
+
+/**
+ * Parser for large documents whose root is an array, ex. a file with millions of records.
+ * A pre-scan finds split points between the elements of the root array, the ranges between them are parsed on
+ * a thread pool into an arena per thread, and the elements are stitched into one root array afterwards.
+ * The pre-scan runs in parallel as well: the threads summarize their part of the text with the classification
+ * of the structural index, for both cases of starting inside or outside a string. A prefix over the summaries
+ * tells every part whether it starts inside a string and at which depth, so it can find the commas between
+ * elements of the root array.
+ * The result is the same as reading the document with a single thread: documents with another root,
+ * single quoted strings or unbalanced brackets are read by a single thread, and so are documents with an error
+ * in one of the ranges, so errors are reported the same way.
+ */
+class JsonParallelParser {
+public:
+
+    /**
+     * Creates a parser with its own thread pool.
+     * @param threads Amount of threads, 0 to use one per hardware thread.
+     */
+    explicit JsonParallelParser(unsigned threads = 0);
+
+    /**
+     * Creates a parser that uses an existing thread pool.
+     * @param pool Thread pool, must stay alive as long as the parser.
+     */
+    explicit JsonParallelParser(JsonThreadPool& pool);
+
+    /**
+     * Deleted copy constructor. Copying is not allowed.
+     */
+    JsonParallelParser(const JsonParallelParser&) = delete;
+
+    /**
+     * Deleted assignment operator. Assigning is not allowed.
+     */
+    JsonParallelParser& operator=(const JsonParallelParser&) = delete;
+
+    /**
+     * Parses a json file by memory mapping it.
+     * @throw invalid argument if the file can not be opened.
+     * @throw ParseError if the file is not valid json.
+     * @param file_name Path to input file.
+     */
+    void parse(const std::string& file_name);
+
+    /**
+     * Parses json text from a buffer, the root may be any value.
+     * The buffer is not used anymore after parsing.
+     * @throw ParseError if the text is not valid json.
+     * @param data Start of the json text.
+     * @param length Amount of characters in the buffer.
+     */
+    void parse(const char* data, size_t length);
+
+    /**
+     * Parses json text from a string.
+     * @throw ParseError if the text is not valid json.
+     * @param json String containing the json text.
+     */
+    void parseString(const std::string& json);
+
+    /**
+     * Get the root value.
+     * @throw invalid argument if nothing was parsed.
+     * @return The root value, valid until the parser is cleared or parses again.
+     */
+    JsonValue& root() const;
+
+    /**
+     * Get the amount of memory the parsed values use.
+     * @return Amount of bytes allocated from the arenas of the parser.
+     */
+    size_t memoryUsage() const;
+
+    /**
+     * Removes the parsed values.
+     */
+    void clear();
+
+private:
+
+    /**
+     * Parse state of one thread of the pool.
+     */
+    struct Worker {
+        JsonReader reader;  /**< Tokenizer of the elements, its buffers are reused*/
+        JsonStructuralIndex index;  /**< Structural index of the text that is being read*/
+        JsonArena arena;    /**< Arena of the elements*/
+    };
+
+    /**
+     * Fixed part of the text that is pre-scanned by one task.
+     */
+    struct Chunk {
+        const char* begin;      /**< First character*/
+        const char* end;        /**< Past the last character*/
+        JsonStructuralIndex::Summary summary;   /**< Summary for both cases, starting inside or outside a string*/
+        int firstLine;          /**< Line of the first character*/
+        bool inString;          /**< True if the chunk starts inside a string*/
+        long depth;             /**< Nesting depth at the first character*/
+        const char* split;      /**< Past the first comma between elements of the root array, nullptr if none*/
+        int splitLine;          /**< Line of the split*/
+    };
+
+    /**
+     * Elements of the root array between two splits, parsed by one task.
+     */
+    struct Range {
+        const char* begin;          /**< First character*/
+        const char* end;            /**< The comma after the last element, or the closing ']'*/
+        int firstLine;              /**< Line of the first character*/
+        std::vector<JsonValue*> elements;   /**< Parsed elements*/
+        std::exception_ptr error;   /**< Error of the range*/
+    };
+
+    std::unique_ptr<JsonThreadPool> ownPool;    /**< Pool created by the parser, if no pool was given*/
+    JsonThreadPool* pool;                       /**< Pool that runs the tasks*/
+    std::vector<std::unique_ptr<Worker>> workers;   /**< State of every thread of the pool*/
+    JsonValue* rootValue;                       /**< Root value, nullptr if nothing was parsed*/
+
+    /**
+     * Read the complete text with the first worker.
+     * @throw ParseError if the text is not valid json.
+     * @param data Start of the json text.
+     * @param length Amount of characters in the text.
+     */
+    void parseSerial(const char* data, size_t length);
+
+    /**
+     * Find the split points of a root array.
+     * @param data Start of the json text.
+     * @param length Amount of characters in the text.
+     * @param open The '[' of the root array.
+     * @param close The ']' of the root array.
+     * @return Ranges between the split points, empty if the text can not be split safely.
+     */
+    std::vector<Range> split(const char* data, size_t length, const char* open, const char* close);
+
+    /**
+     * Read the elements of a range.
+     * @param range The range.
+     * @param worker State of the thread that reads the range.
+     */
+    static void readRange(Range& range, Worker& worker);
+};
+
+#endif //JSONPARSER_JSONPARALLELPARSER_H
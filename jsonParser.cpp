@@ -4,56 +4,104 @@
 #include <algorithm>
 #include <fstream>
 #include "jsonParser.h"
+#include "jsonSerializer.h"
+#include "jsonFrozenDocument.h"
+#include "jsonBinary.h"
+#include "jsonImage.h"
+
+namespace {
+
+/**
+ * Create an object in an arena, or on the heap if there is no arena.
+ */
+template<class T, class... Args>
+T* createIn(JsonArena* arena, Args&& ... args)
+{
+    if (arena==nullptr)
+        return new T(std::forward<Args>(args)...);
+    return arena->create<T>(std::forward<Args>(args)...);
+}
+
+/**
+ * Read a whole file into a string.
+ * @throw invalid argument if the file can not be opened.
+ */
+std::string readFile(const std::string& file_name)
+{
+    std::ifstream file(file_name, std::ios::binary);
+    if (!file.is_open())
+        throw std::invalid_argument("File not found '"+file_name+'\'');
+
+    std::string content;
+    file.seekg(0, std::ios::end);
+    std::streamoff size = file.tellg();
+    if (size>0) {
+        content.resize(static_cast<size_t>(size));
+        file.seekg(0, std::ios::beg);
+        file.read(&content[0], size);
+        content.resize(static_cast<size_t>(file.gcount()));
+    }
+    return content;
+}
+
+}
 
 bool JsonValue::isBool() const
 {
     bool numeric_bool = false;
-    if (type==ValueType::JSON_NUM) {
-        if (number_value==0 || number_value==1)
+    if (isNumber()) {
+        double number = getNumberValue();
+        if (number==0 || number==1)
             numeric_bool = true;
     }
-    return type==ValueType::JSON_BOOL || numeric_bool;
+    return type()==ValueType::JSON_BOOL || numeric_bool;
 }
 
 bool JsonValue::isNull() const
 {
-    return type==ValueType::JSON_NULL;
+    return type()==ValueType::JSON_NULL;
 }
 
 bool JsonValue::isString() const
 {
-    return type==ValueType::JSON_STRING;
+    return type()==ValueType::JSON_STRING;
 }
 
 bool JsonValue::isArray() const
 {
-    return type==ValueType::JSON_ARRAY;
+    return type()==ValueType::JSON_ARRAY;
 }
 
 bool JsonValue::isObject() const
 {
-    return type==ValueType::JSON_OBJ;
+    return type()==ValueType::JSON_OBJ;
 }
 
 bool JsonValue::isNumber() const
 {
     if(this ==nullptr)
         std::cerr << "foutief!";
-    return type==ValueType::JSON_NUM;
+    return type()==ValueType::JSON_NUM || type()==ValueType::JSON_INT || type()==ValueType::JSON_UINT;
+}
+
+bool JsonValue::isInteger() const
+{
+    return type()==ValueType::JSON_INT || type()==ValueType::JSON_UINT;
 }
 
 bool JsonValue::getBoolValue() const
 {
     if (isNumber()) {
-        if (number_value==0)
+        double number = getNumberValue();
+        if (number==0)
             return false;
-        else if (number_value==1)
+        else if (number==1)
             return true;
         else
             throw std::invalid_argument("Unexpected value for JsonBool");
     }
     if (isBool())
-        return bool_value;
+        return large.bool_value;
     else
         throw std::invalid_argument("Unexpected value for JsonBool");
 }
@@ -62,240 +110,386 @@ double JsonValue::getNumberValue() const
 {
     if (!isNumber())
         throw std::invalid_argument("Invalid type for: JsonNumber");
-    return number_value;
+    switch (type()) {
+    case ValueType::JSON_INT:
+        return static_cast<double>(large.int_value);
+    case ValueType::JSON_UINT:
+        return static_cast<double>(large.uint_value);
+    default:
+        return large.number_value;
+    }
+}
+
+int64_t JsonValue::getInt64Value() const
+{
+    if (!isInteger())
+        throw std::invalid_argument("Invalid type for: JsonInt");
+    if (type()==ValueType::JSON_UINT)
+        throw std::invalid_argument("Value out of range for: JsonInt");
+    return large.int_value;
+}
+
+uint64_t JsonValue::getUInt64Value() const
+{
+    if (!isInteger())
+        throw std::invalid_argument("Invalid type for: JsonUInt");
+    if (type()==ValueType::JSON_INT && large.int_value<0)
+        throw std::invalid_argument("Value out of range for: JsonUInt");
+    return large.uint_value;
 }
 
 std::string JsonValue::getStringValue() const
 {
     if (!isString())
         throw std::invalid_argument("Invalid type for: JsonString");
-    return *string_value;
+    return std::string(stringData(), stringLength());
 }
 
 JsonArray& JsonValue::getArrayValue() const
 {
     if (!isArray())
         throw std::invalid_argument("Invalid type for: JsonArray");
-    return *array_value;
+    return *large.array_value;
 }
 
 JsonObject& JsonValue::getObjectValue() const
 {
     if (!isObject())
         throw std::invalid_argument("Invalid type for: JsonObject");
-    return *object_value;
+    return *large.object_value;
 }
 
 JsonValue::JsonValue()
-        :type(ValueType::JSON_NULL), copied(false)
+        :large()
 {
-
+    setType(ValueType::JSON_NULL);
 }
 
-JsonValue::JsonValue(const ValueType& valueType, const std::string& value)
-        :copied(false)
+JsonValue::JsonValue(const ValueType& valueType, const std::string& value, JsonArena* arena)
+        :large()
 {
+    large.tag = arena!=nullptr ? IN_ARENA : 0;
 
 //    std::transform(value.begin(), value.end(), value.begin(), ::tolower);
 
     switch (valueType) {
     default:
-        type = ValueType::JSON_NULL;
+        setType(ValueType::JSON_NULL);
         break;
     case ValueType::JSON_STRING: {
-        type = ValueType::JSON_STRING;
-        string_value = new std::string(value);
+        setString(value.data(), value.size(), arena);
         break;
     }
     case ValueType::JSON_BOOL: {
-        type = ValueType::JSON_BOOL;
+        setType(ValueType::JSON_BOOL);
         if (strcmp(value.c_str(), "0")==0 || strcmp(value.c_str(), "false")==0)
-            bool_value = false;
+            large.bool_value = false;
         else if (strcmp(value.c_str(), "1")==0 || strcmp(value.c_str(), "true")==0)
-            bool_value = true;
+            large.bool_value = true;
         else
-            type = ValueType::JSON_NULL;
+            setType(ValueType::JSON_NULL);
         break;
     }
-    case ValueType::JSON_NUM: {
-        type = ValueType::JSON_NUM;
-        number_value = std::stod(value);
+    case ValueType::JSON_NUM:
+    case ValueType::JSON_INT:
+    case ValueType::JSON_UINT: {
+        JsonNumber number{};
+        if (JsonNumber::parse(value.data(), value.data()+value.size(), number)!=value.data()+value.size())
+            throw std::invalid_argument("Incorrect number format: '"+value+"'");
+        if (valueType==ValueType::JSON_INT && (number.kind!=JsonNumber::INT))
+            throw std::invalid_argument("Value out of range for: JsonInt");
+        if (valueType==ValueType::JSON_UINT && (number.kind==JsonNumber::DOUBLE
+                                                || (number.kind==JsonNumber::INT && number.int_value<0)))
+            throw std::invalid_argument("Value out of range for: JsonUInt");
+        setNumber(number);
         break;
     }
     case ValueType::JSON_ARRAY: {
-        type = ValueType::JSON_ARRAY;
-        array_value = new JsonArray;
+        setType(ValueType::JSON_ARRAY);
+        large.array_value = createIn<JsonArray>(arena, ArenaAllocator<JsonValue*>(arena));
         break;
     }
     case ValueType::JSON_OBJ: {
-        type = ValueType::JSON_OBJ;
-        object_value = new JsonObject;
+        setType(ValueType::JSON_OBJ);
+        large.object_value = createIn<JsonObject>(arena, arena);
+        break;
+    }
+    }
+}
+
+JsonValue::JsonValue(JsonStringView string, JsonArena* arena)
+        :large()
+{
+    large.tag = arena!=nullptr ? IN_ARENA : 0;
+    setString(string.data(), string.size(), arena);
+}
+
+JsonValue::JsonValue(const JsonNumber& number, JsonArena* arena)
+        :large()
+{
+    large.tag = arena!=nullptr ? IN_ARENA : 0;
+    setNumber(number);
+}
+
+void JsonValue::setNumber(const JsonNumber& number)
+{
+    switch (number.kind) {
+    case JsonNumber::INT:
+        setType(ValueType::JSON_INT);
+        large.int_value = number.int_value;
+        break;
+    case JsonNumber::UINT:
+        setType(ValueType::JSON_UINT);
+        large.uint_value = number.uint_value;
+        break;
+    case JsonNumber::DOUBLE:
+        setType(ValueType::JSON_NUM);
+        large.number_value = number.double_value;
         break;
     }
+}
+
+void JsonValue::setString(const char* data, size_t length, JsonArena* arena)
+{
+    setType(ValueType::JSON_STRING);
+    if (length<=SMALL_STRING_CAPACITY) {
+        large.tag |= SMALL_STRING;
+        memset(small.data, 0, SMALL_STRING_CAPACITY);
+        if (length>0)
+            memcpy(small.data, data, length);
+        small.remaining = static_cast<uint8_t>(SMALL_STRING_CAPACITY-length);
+        return;
+    }
+    if (length>UINT32_MAX)
+        throw std::invalid_argument("String is too long for: JsonString");
+    large.length = static_cast<uint32_t>(length);
+    if (arena!=nullptr) {
+        large.string_value = arena->copyString(data, length);
+    }
+    else {
+        large.string_value = new char[length+1];
+        memcpy(large.string_value, data, length);
+        large.string_value[length] = '\0';
     }
 }
 
 JsonValue::~JsonValue()
 {
-    if (copied)
+    destroy();
+}
+
+bool JsonValue::ownsHeapMemory() const
+{
+    if (hasFlag(BORROWED) || hasFlag(IN_ARENA))
+        return false;
+    ValueType valueType = type();
+    return valueType==ValueType::JSON_OBJ || valueType==ValueType::JSON_ARRAY
+           || (valueType==ValueType::JSON_STRING && !hasFlag(SMALL_STRING));
+}
+
+void JsonValue::destroy() noexcept
+{
+    if (!ownsHeapMemory())
         return;
-    switch (type) {
+    switch (type()) {
     default:
         break;
     case ValueType::JSON_OBJ:
-        for (auto it = object_value->begin(); it!=object_value->end();) {
-            delete it->second;
-            it->second = nullptr;
-            it = object_value->erase(it);
+        for (auto& member : *large.object_value) {
+            if (member.second!=nullptr && !member.second->hasFlag(IN_ARENA))
+                delete member.second;
+            member.second = nullptr;
         }
-        delete object_value;
-        object_value = nullptr;
+        delete large.object_value;
+        large.object_value = nullptr;
         break;
     case ValueType::JSON_ARRAY:
-        if (array_value==nullptr)
+        if (large.array_value==nullptr)
             break;
-        for (auto* obj : (*array_value)) {
-            delete obj;
-            obj = nullptr;
+        for (auto* obj : (*large.array_value)) {
+            if (obj!=nullptr && !obj->hasFlag(IN_ARENA))
+                delete obj;
         }
-        array_value->clear();
-        delete array_value;
-        array_value = nullptr;
+        large.array_value->clear();
+        delete large.array_value;
+        large.array_value = nullptr;
         break;
     case ValueType::JSON_STRING:
-        delete string_value;
-        string_value = nullptr;
+        delete[] large.string_value;
+        large.string_value = nullptr;
         break;
     }
 }
 
+void JsonValue::take(JsonValue& other) noexcept
+{
+    // Both values stay where they live, storage that belongs to an arena stays in the arena
+    uint8_t lives = large.tag & IN_ARENA;
+    uint8_t otherLives = other.large.tag & IN_ARENA;
+    ValueType otherType = other.type();
+    bool storage = otherType==ValueType::JSON_OBJ || otherType==ValueType::JSON_ARRAY
+                   || (otherType==ValueType::JSON_STRING && !other.hasFlag(SMALL_STRING));
+    bool borrowed = storage && (other.hasFlag(IN_ARENA) || other.hasFlag(BORROWED));
+    if (other.hasFlag(SMALL_STRING))
+        small = other.small;
+    else
+        large = other.large;
+    large.tag = static_cast<uint8_t>((large.tag & ~(IN_ARENA | BORROWED)) | lives | (borrowed ? BORROWED : 0));
+    other.large = Large();
+    other.large.tag = otherLives;
+}
+
+JsonValue::JsonValue(JsonValue&& other) noexcept
+        :large()
+{
+    take(other);
+}
+
+JsonValue& JsonValue::operator=(JsonValue&& other)
+{
+    if (this==&other)
+        return *this;
+    if (hasFlag(IN_ARENA) && other.ownsHeapMemory())
+        throw std::invalid_argument("Can not move a value with heap memory into a value of an arena");
+    destroy();
+    take(other);
+    return *this;
+}
+
+JsonValue JsonValue::clone() const
+{
+    switch (type()) {
+    case ValueType::JSON_OBJ: {
+        JsonValue result(ValueType::JSON_OBJ);
+        for (const auto& member : *large.object_value)
+            result.addToObject(member.second!=nullptr ? new JsonValue(member.second->clone()) : nullptr, member.first);
+        return result;
+    }
+    case ValueType::JSON_ARRAY: {
+        JsonValue result(ValueType::JSON_ARRAY);
+        for (const JsonValue* element : *large.array_value)
+            result.addToArray(element!=nullptr ? new JsonValue(element->clone()) : nullptr);
+        return result;
+    }
+    case ValueType::JSON_STRING:
+        return JsonValue(getStringView());
+    default: {
+        // Scalars have no storage outside of the value
+        JsonValue result;
+        result.large = large;
+        result.large.tag = static_cast<uint8_t>(large.tag & TYPE_MASK);
+        return result;
+    }
+    }
+}
+
+void JsonValueDeleter::operator()(JsonValue* value) const
+{
+    if (value!=nullptr && !value->hasFlag(JsonValue::IN_ARENA))
+        delete value;
+}
+
 void JsonValue::addToArray(JsonValue* value)
 {
     if (!isArray())
         throw std::invalid_argument("Object is not of type JsonArray");
-    array_value->push_back(value);
+    JsonArena* arena = large.array_value->get_allocator().arena();
+    large.array_value->push_back(value);
+    if (arena!=nullptr && value!=nullptr && !value->hasFlag(IN_ARENA))
+        arena->own(value);
+}
+
+void JsonValue::addToArray(JsonValuePtr value)
+{
+    addToArray(value.get());
+    value.release();
 }
 
-void JsonValue::addToObject(JsonValue* value, const std::string& key)
+void JsonValue::addToObject(JsonValuePtr value, JsonStringView key)
+{
+    addToObject(value.get(), key);
+    value.release();
+}
+
+void JsonValue::addToObject(JsonValue* value, JsonStringView key)
 {
     if (!isObject())
         throw std::invalid_argument("Object is not of type JsonObject");
-    if (hasKey(key)) {
-        throw std::invalid_argument("Duplicate key: '"+key+"'");
+    if (!large.object_value->insert(value, key)) {
+        throw std::invalid_argument("Duplicate key: '"+std::string(key)+"'");
     }
-    (*object_value).add(value, key);
 }
 
 JsonValue& JsonValue::operator[](int index)
 {
-    if (type!=ValueType::JSON_ARRAY) {
+    if (type()!=ValueType::JSON_ARRAY) {
         throw std::invalid_argument("Object is not of type JsonArray");
     }
 
-    if (index>=array_value->size() || index<0) {
-        if (!array_value->empty())
+    if (index>=large.array_value->size() || index<0) {
+        if (!large.array_value->empty())
             throw std::invalid_argument(
                     "Index out of range, got ["+std::to_string(index)+"], max is ["
-                            +std::to_string(array_value->size()-1)
+                            +std::to_string(large.array_value->size()-1)
                             +"]");
         else
             throw std::invalid_argument("Index out of range, got ["+std::to_string(index)+"], but JsonArray is empty");
     }
 
-    return *((*array_value)[index]);
+    return *((*large.array_value)[index]);
 }
 
-JsonValue& JsonValue::operator[](const std::string& key)
+JsonValue& JsonValue::operator[](JsonStringView key)
 {
-    if (type!=ValueType::JSON_OBJ)
-        throw std::invalid_argument("Object is not of type JsonObject");
-
-    if (hasKey(key)==0)
-        throw std::invalid_argument("Did not find key '"+key+"' in JsonObject");
-
-    return (*object_value)[key];
+    JsonValue* value = find(key);
+    if (value==nullptr)
+        throw std::invalid_argument("Did not find key '"+std::string(key)+"' in JsonObject");
+    return *value;
 }
 
-JsonValue::JsonValue(const ValueType& vt)
+JsonValue::JsonValue(const ValueType& vt, JsonArena* arena)
+        :large()
 {
+    large.tag = arena!=nullptr ? IN_ARENA : 0;
     switch (vt) {
     case JSON_ARRAY:
-        array_value = new std::vector<JsonValue*>{};
-        type = vt;
+        large.array_value = createIn<JsonArray>(arena, ArenaAllocator<JsonValue*>(arena));
+        setType(vt);
         break;
     case JSON_OBJ:
-        object_value = new JsonObject{};
-        type = vt;
+        large.object_value = createIn<JsonObject>(arena, arena);
+        setType(vt);
         break;
     case JSON_NULL:
-        type = vt;
+        setType(vt);
         break;
     case JSON_STRING:
-        string_value = new std::string("");
-        type = vt;
+        setString("", 0, arena);
         break;
     default:
         throw std::invalid_argument("Cannot create empty JSON Value");
     }
 }
 
-JsonValue& JsonValue::operator=(const JsonValue& other)
+bool JsonValue::hasKey(JsonStringView key) const
 {
-    type = other.type;
-    copied = true;
-    switch (other.type) {
-    case JSON_NULL:
-        break;
-    case JSON_NUM:
-        number_value = other.number_value;
-        break;
-    case JSON_ARRAY:
-        array_value = other.array_value;
-        break;
-    case JSON_OBJ:
-        object_value = other.object_value;
-        break;
-    case JSON_STRING:
-        string_value = other.string_value;
-        break;
-    case JSON_BOOL:
-        bool_value = other.bool_value;
-        break;
-    }
-    return *this;
+    if(!isObject())
+        throw std::invalid_argument("JsonValue is not of type 'JsonObject'");
+    return large.object_value->count(key) > 0;
 }
 
-JsonValue::JsonValue(const JsonValue& other)
+JsonValue* JsonValue::find(JsonStringView key) const
 {
-    type = other.type;
-    copied = true;
-    switch (other.type) {
-    case JSON_NULL:
-        break;
-    case JSON_NUM:
-        number_value = other.number_value;
-        break;
-    case JSON_ARRAY:
-        array_value = other.array_value;
-        break;
-    case JSON_OBJ:
-        object_value = other.object_value;
-        break;
-    case JSON_STRING:
-        string_value = other.string_value;
-        break;
-    case JSON_BOOL:
-        bool_value = other.bool_value;
-        break;
-    }
-
+    if (type()!=ValueType::JSON_OBJ)
+        throw std::invalid_argument("Object is not of type JsonObject");
+    auto it = large.object_value->find(key);
+    return it==large.object_value->end() ? nullptr : it->second;
 }
 
-bool JsonValue::hasKey(const std::string& key)
+std::string JsonValue::dump(int indent) const
 {
-    if(!isObject())
-        throw std::invalid_argument("JsonValue is not of type 'JsonObject'");
-    return object_value->count(key) > 0;
+    JsonSerializer serializer(indent);
+    return std::string(serializer.serialize(*this));
 }
 
 JsonObject* JsonValue::getNullValue() const
@@ -306,493 +500,204 @@ JsonObject* JsonValue::getNullValue() const
         throw std::invalid_argument("JsonValue is not of type JsonNull");
 }
 
-void JsonParser::skipWhiteSpace(std::string& line)
+void JsonParser::parse(const std::string& file_name)
 {
-    if (line.empty())
-        return;
-    while (line.front()==' ' || line.front() == '\t' || line.front() == '\n')
-        line.erase(0, 1);
+    std::string content = readFile(file_name);
+    parse(content.data(), content.size());
 }
 
-void JsonParser::parse(const std::string& file_name)
+void JsonParser::parse(const std::string& file_name, const JsonProjection& projection)
 {
+    std::string content = readFile(file_name);
+    parse(content.data(), content.size(), projection);
+}
 
+void JsonParser::parseMapped(const std::string& file_name)
+{
+    MappedFile file(file_name);
+    parse(file.data(), file.size());
+    source = std::move(file);
+}
+
+void JsonParser::loadBinary(const std::string& file_name)
+{
+    MappedFile file(file_name);
     clear();
-    root = JsonObject{};
+    root = JsonBinary::load(file.data(), file.size(), arena);
+}
 
-    std::ifstream file(file_name);
-    if (!file.is_open())
-        throw std::invalid_argument("File not found '"+file_name+'\'');
+void JsonParser::save(const std::string& file_name) const
+{
+    if (root==nullptr)
+        throw std::invalid_argument("JsonParser is empty");
+    JsonBinary::save(*root, file_name);
+}
 
-    std::string line;
-    bool first = false;
-    while (getline(file, line)) {
-
-        if (line.empty())
-            continue;
-
-        currentLine++;
-        skipWhiteSpace(line);
-        while (!line.empty()) {
-            skipWhiteSpace(line);
-            char current = line.front();
-            switch (current) {
-
-            case '{':
-                m_curlyCount++;
-                if (!first) {
-                    first = true;
-                    break;
-                }
-                if (parseState.top()==ARRAY) {
-                    if (!canCreateValue) {
-                        throw ParseError(currentLine, line, "Missing ','");
-                    }
-                    unfinishedObjects.push({"", new JsonValue(ValueType::JSON_OBJ)});
-                    parseState.push(OBJECT);
-                    break;
-                }
-            case 'n': {
-                if (parseState.top()==ARRAY) {
-                    if (strcmp(line.substr(0, 4).c_str(), "null")==0) {
-                        JsonValue* jsonVal = new JsonValue(ValueType::JSON_NULL);
-                        auto addTo = unfinishedArrays.top().second;
-                        addTo->addToArray(jsonVal);
-                        // remove 'null'
-                        std::string s = "null";
-                        std::string::size_type i = line.find(s);
-                        if (i!=std::string::npos) {
-                            line.erase(i, s.length());
-                        }
-                        skipWhiteSpace(line);
-                        canCreateValue = expectChar(line, ',');
-                        continue;
-                    }
-                }
-                break;
-            }
-            case '}':
-                m_curlyCount--;
-                if (parseState.top()==OBJECT)
-                    parseState.pop();
-
-                if (parseState.top()==ARRAY) {
-                    if (!unfinishedObjects.empty()) {
-                        line.erase(0, 1);
-                        auto top = unfinishedObjects.top();
-                        unfinishedObjects.pop();
-                        auto array = unfinishedArrays.top().second;
-                        array->addToArray(top.second);
-                        skipWhiteSpace(line);
-                        canCreateValue = expectChar(line, ',');
-                        continue;
-                    }
-                    break;
-                }
-
-                if (!unfinishedObjects.empty()) {
-                    line.erase(0,1);
-                    auto top = unfinishedObjects.top();
-                    unfinishedObjects.pop();
-                    if (unfinishedObjects.empty())
-                        root.add(top.second, top.first);
-//                        root[top.first] = top.second;
-                    else {
-                        auto attachTo = unfinishedObjects.top().second;
-                        attachTo->addToObject(top.second, top.first);
-                    }
-                    canCreateValue = expectChar(line, ',');
-                }
-                break;
-            case '[':
-                // start new array
-                m_straightCount++;
-                if (parseState.top()==ARRAY) {
-                    parseState.push(ARRAY);
-                    unfinishedArrays.push({"", new JsonValue(ValueType::JSON_ARRAY)});
-                    break;
-                }
-            case ']':
-                // end array
-                m_straightCount--;
-                if (parseState.top()==ARRAY) {
-                    line.erase(0, 1);
-                    auto top = unfinishedArrays.top();
-                    parseState.pop();
-                    unfinishedArrays.pop();
-                    if (unfinishedArrays.empty()) {
-                        root.add(top.second, top.first);
-//                        root[top.first] = top.second;
-                    }
-                    else {
-                        auto addTo = unfinishedArrays.top().second;
-                        addTo->addToArray(top.second);
-                    }
-                    canCreateValue = expectChar(line, ',');
-                    continue;
-                }
-            case 't':
-                if (parseState.top()==ARRAY) {
-                    if (strcmp(line.substr(0, 4).c_str(), "true")==0) {
-                        JsonValue* jsonVal = new JsonValue(ValueType::JSON_BOOL, "true");
-                        auto addTo = unfinishedArrays.top().second;
-                        addTo->addToArray(jsonVal);
-                        // Remove 'true'
-                        std::string s = "true";
-                        std::string::size_type i = line.find(s);
-                        if (i!=std::string::npos)
-                            line.erase(i, s.length());
-                        skipWhiteSpace(line);
-                        canCreateValue = expectChar(line, ',');
-                        continue;
-                    }
-                }
-            case 'f':
-                if (parseState.top()==ARRAY) {
-                    if (strcmp(line.substr(0, 5).c_str(), "false")==0) {
-                        JsonValue* jsonVal = new JsonValue(ValueType::JSON_BOOL, "false");
-                        auto addTo = unfinishedArrays.top().second;
-                        addTo->addToArray(jsonVal);
-                        // Remove 'true'
-                        std::string s = "false";
-                        std::string::size_type i = line.find(s);
-                        if (i!=std::string::npos)
-                            line.erase(i, s.length());
-                        skipWhiteSpace(line);
-                        canCreateValue = expectChar(line, ',');
-                        continue;
-                    }
-                }
-            case '\'':
-            case '"': {
-
-                if (!canCreateValue) {
-                    throw ParseError(currentLine, line, "Missing ',' after last created object");
-                }
-
-                std::string key = getQuotedString(line, current);
-                skipWhiteSpace(line);
-
-                if (parseState.top()==ARRAY) {
-                    auto top = unfinishedArrays.top().second;
-                    top->addToArray(new JsonValue(ValueType::JSON_STRING, key));
-                    canCreateValue = expectChar(line, ',');
-                    continue;
-                }
-
-                if (!expectChar(line, ':'))
-                    throw ParseError(currentLine, line, "Missing ':' after \""+key+"\"");
-
-                skipWhiteSpace(line);
-                char new_current = line.front();
-
-                // We need to read the value after the key
-                switch (new_current) {
-                case '"':
-                case '\'': {
-                    std::string value = getQuotedString(line, new_current);
-
-                    JsonValue* jsonVal = new JsonValue(ValueType::JSON_STRING, value);
-
-                    switch (parseState.top()) {
-                    case ARRAY: {
-
-                    }
-                    case OBJECT: {
-                        auto obj = unfinishedObjects.top().second;
-                        obj->addToObject(jsonVal, key);
-                        break;
-                    }
-                    case NORMAL:
-                        root.add(jsonVal, key);
-//                        root[key] = jsonVal;
-                        break;
-                    }
-                    skipWhiteSpace(line);
-                    canCreateValue = expectChar(line, ',');
-                    break;
-                }
-                case 't': {
-                    if (strcmp(line.substr(0, 4).c_str(), "true")==0) {
-                        JsonValue* jsonVal = new JsonValue(ValueType::JSON_BOOL, "true");
-                        switch (parseState.top()) {
-                        case ARRAY: {
-
-                        }
-                        case OBJECT: {
-                            auto obj = unfinishedObjects.top().second;
-                            obj->addToObject(jsonVal, key);
-                            break;
-                        }
-                        case NORMAL:
-                            root.add(jsonVal, key);
-//                            root[key] = jsonVal;
-                            break;
-                        }
-                        // Remove 'true'
-                        std::string s = "true";
-                        std::string::size_type i = line.find(s);
-                        if (i!=std::string::npos)
-                            line.erase(i, s.length());
-                        skipWhiteSpace(line);
-                        if (!line.empty() && line[0]!=',' && line[0]!='\n' && line[0]!=' ') {
-                            std::string c(1, line[0]);
-                            throw ParseError(currentLine, line, "Unexpected token: '"+c+"'");
-                        }
-                        canCreateValue = expectChar(line, ',');
-                        break;
-                    }
-                }
-                case 'f': {
-                    if (strcmp(line.substr(0, 5).c_str(), "false")==0) {
-                        JsonValue* jsonVal = new JsonValue(ValueType::JSON_BOOL, "false");
-                        switch (parseState.top()) {
-                        case ARRAY: {
-
-                        }
-                        case OBJECT: {
-                            auto obj = unfinishedObjects.top().second;
-                            obj->addToObject(jsonVal, key);
-                            break;
-                        }
-                        case NORMAL:
-                            root.add(jsonVal, key);
-//                            root[key] = jsonVal;
-                            break;
-                        }
-                        // Remove 'false'
-                        std::string s = "false";
-                        std::string::size_type i = line.find(s);
-                        if (i!=std::string::npos)
-                            line.erase(i, s.length());
-                        skipWhiteSpace(line);
-                        if (!line.empty() && line[0]!=',' && line[0]!='\n' && line[0]!=' ') {
-                            std::string c(1, line[0]);
-                            throw ParseError(currentLine, line, "Unexpected token: '"+c+"'");
-                        }
-                        canCreateValue = expectChar(line, ',');
-                        break;
-                    }
-                }
-                case 'n': {
-                    if (strcmp(line.substr(0, 45).c_str(), "null")==0) {
-                        JsonValue* jsonVal = new JsonValue(ValueType::JSON_NULL);
-                        switch (parseState.top()) {
-                        case ARRAY: {
-                            break;
-                        }
-                        case OBJECT: {
-                            auto obj = unfinishedObjects.top().second;
-                            obj->addToObject(jsonVal, key);
-                            break;
-                        }
-                        case NORMAL:
-                            root.add(jsonVal, key);
-                            break;
-                        }
-                        // remove 'null'
-                        std::string s = "null";
-                        std::string::size_type i = line.find(s);
-                        if (i!=std::string::npos) {
-                            line.erase(i, s.length());
-                        }
-                        skipWhiteSpace(line);
-                        if (!line.empty() && line[0]!=',' && line[0]!='\n' && line[0]!=' ') {
-                            std::string c(1, line[0]);
-                            throw ParseError(currentLine, line, "Unexpected token: '"+c+"'");
-                        }
-                        canCreateValue = expectChar(line, ',');
-                    }
-                    break;
-                }
-                case '[': {
-                    m_straightCount++;
-                    parseState.push(ARRAY);
-                    unfinishedArrays.push({key, new JsonValue(ValueType::JSON_ARRAY)});
-                    canCreateValue = true;
-                    break;
-                }
-                case '{': {
-                    m_curlyCount++;
-                    parseState.push(OBJECT);
-                    unfinishedObjects.push({key, new JsonValue(ValueType::JSON_OBJ)});
-                    break;
-                }
-                case '}': {
-                    m_curlyCount--;
-                    if (unfinishedObjects.empty())
-                        throw ParseError(currentLine, line, "Unbalanced {}, missing '}'");
-                    auto top = unfinishedObjects.top();
-                    parseState.pop();
-                    unfinishedObjects.pop();
-                    if (unfinishedObjects.empty())
-                        root.add(top.second, top.first);
-//                        root[top.first] = top.second;
-                    else {
-                        auto attachTo = unfinishedObjects.top().second;
-                        attachTo->addToObject(top.second, top.first);
-                    }
-                    skipWhiteSpace(line);
-                    canCreateValue = expectChar(line, ',');
-                    break;
-                }
-                case ']' : {
-                    m_straightCount--;
-                    if (unfinishedArrays.empty())
-                        throw ParseError(currentLine, line, "Unbalanced [], missing ']'");
-                    auto top = unfinishedArrays.top();
-                    unfinishedArrays.pop();
-                    parseState.pop();
-                    if (unfinishedArrays.empty())
-                        root.add(top.second, top.first);
-//                        root[top.first] = top.second;
-                    else {
-                        auto attachTo = unfinishedArrays.top().second;
-                        attachTo->addToArray(top.second);
-                    }
-                    skipWhiteSpace(line);
-                    canCreateValue = expectChar(line, ',');
-                    break;
-                }
-                default: {
-                    if (isdigit(new_current) || new_current=='-') {
-                        std::string value = readNumberValue(line);
-                        skipWhiteSpace(line);
-                        if (!line.empty() && line.front()!=',' && line.front()!=' ' && line.front()!='\n') {
-                            std::string c(1, line.front());
-                            throw ParseError(currentLine, line, "Unexpected token "+c);
-                        }
-                        JsonValue* jsonVal = new JsonValue(ValueType::JSON_NUM, value);
-                        switch (parseState.top()) {
-                        case ARRAY: {
-
-                        }
-                        case OBJECT: {
-                            auto obj = unfinishedObjects.top().second;
-                            obj->addToObject(jsonVal, key);
-                            break;
-                        }
-                        case NORMAL:
-                            root.add(jsonVal, key);
-//                            root[key] = jsonVal;
-                            break;
-                        }
-                        canCreateValue = expectChar(line, ',');
-                        break;
-                    }
-                    std::string c(1, new_current);
-                    throw ParseError(currentLine, line, "Unexpected token: '"+c+"'");
-                }
-
-                }
-                break;
-            }
-            default:
-                if (parseState.top()==ARRAY) {
-                    if (isdigit(current) || current=='-') {
-                        std::string value = readNumberValue(line);
-                        skipWhiteSpace(line);
-                        JsonValue* jsonVal = new JsonValue(ValueType::JSON_NUM, value);
-                        auto addTo = unfinishedArrays.top().second;
-                        addTo->addToArray(jsonVal);
-                        canCreateValue = expectChar(line, ',');
-                        continue;
-                    }
-                }
-                std::string ch;
-                ch += current;
-                throw ParseError(currentLine, line, "Unexpected token: '"+ch+"'");
-            }
-            if (!first)
-                throw ParseError(currentLine, line, "Missing root '{'");
-            if (m_straightCount<0)
-                throw ParseError(currentLine, line, "Unbalanced '[]'");
-            if (m_curlyCount<0)
-                throw ParseError(currentLine, line, "Unbalanced '{}'");
-
-            skipWhiteSpace(line);
-            line.erase(0, 1);
-        }
+void JsonParser::saveImage(const std::string& file_name) const
+{
+    if (root==nullptr)
+        throw std::invalid_argument("JsonParser is empty");
+    JsonImage::save(*root, file_name);
+}
+
+void JsonParser::parseString(const std::string& json)
+{
+    parse(json.data(), json.size());
+}
+
+void JsonParser::parse(const char* data, size_t length)
+{
+    parse(data, length, reader);
+}
+
+void JsonParser::parse(const char* data, size_t length, JsonReader& reader)
+{
+    clear();
+    reader.parse(data, length, *this);
+}
+
+void JsonParser::parse(const char* data, size_t length, const JsonProjection& projection)
+{
+    clear();
+    reader.parse(data, length, *this, projection);
+}
+
+void JsonParser::parseString(const std::string& json, const JsonProjection& projection)
+{
+    parse(json.data(), json.size(), projection);
+}
+
+void JsonParser::feed(const char* data, size_t length)
+{
+    if (!pushParser.started())
+        clear();
+    try {
+        pushParser.feed(data, length);
+    }
+    catch (...) {
+        // Also errors of the data structure, ex. a duplicate key, end the document
+        pushParser.reset();
+        throw;
     }
+}
 
-    if (canCreateValue)
-        throw ParseError(currentLine, "Expected new object after ','");
-    if (m_curlyCount!=0 || !unfinishedObjects.empty())
-        throw ParseError(currentLine, "END OF FILE", "Unbalanced {}");
-    if (m_straightCount!=0 || !unfinishedArrays.empty())
-        throw ParseError(currentLine, "END OF FILE", "Unbalanced []");
+void JsonParser::finish()
+{
+    try {
+        pushParser.finish();
+    }
+    catch (...) {
+        pushParser.reset();
+        throw;
+    }
 }
 
-std::string JsonParser::getQuotedString(std::string& line, char quoteChar)
+void JsonParser::startObject()
 {
-    std::string result;
-    line.erase(0, 1);
-    while (line.front()!=quoteChar) {
-        result += line.front();
-        line.erase(0, 1);
+    if (root==nullptr) {
+        root = arena.create<JsonObject>(&arena);
+        return;
     }
-    line.erase(0, 1);
+    parseState.push(OBJECT);
+    unfinishedObjects.push({std::string(pendingKey), arena.create<JsonValue>(ValueType::JSON_OBJ, &arena)});
+}
 
-    skipWhiteSpace(line);
-    return result;
+void JsonParser::key(JsonStringView key)
+{
+    pendingKey = key;
 }
 
-bool JsonParser::expectChar(std::string& line, char c)
+void JsonParser::endObject()
 {
-    if (line.empty())
-        return false;
-    if (line.front()==c) {
-        line.erase(0, 1);
-        return true;
+    // The root object has no parent
+    if (parseState.top()!=NORMAL)
+        finishValue();
+}
+
+void JsonParser::startArray()
+{
+    parseState.push(ARRAY);
+    unfinishedArrays.push({std::string(pendingKey), arena.create<JsonValue>(ValueType::JSON_ARRAY, &arena)});
+}
+
+void JsonParser::endArray()
+{
+    finishValue();
+}
+
+void JsonParser::string(JsonStringView value)
+{
+    attachValue(arena.create<JsonValue>(value, &arena), pendingKey);
+}
+
+void JsonParser::number(const JsonNumber& value)
+{
+    attachValue(arena.create<JsonValue>(value, &arena), pendingKey);
+}
+
+void JsonParser::boolean(bool value)
+{
+    attachValue(arena.create<JsonValue>(ValueType::JSON_BOOL, value ? "true" : "false", &arena), pendingKey);
+}
+
+void JsonParser::null()
+{
+    attachValue(arena.create<JsonValue>(ValueType::JSON_NULL, &arena), pendingKey);
+}
+
+void JsonParser::finishValue()
+{
+    std::pair<std::string, JsonValue*> top;
+    if (parseState.top()==ARRAY) {
+        top = unfinishedArrays.top();
+        unfinishedArrays.pop();
+    }
+    else {
+        top = unfinishedObjects.top();
+        unfinishedObjects.pop();
+    }
+    parseState.pop();
+    attachValue(top.second, top.first);
+}
+
+void JsonParser::attachValue(JsonValue* value, JsonStringView key)
+{
+    switch (parseState.top()) {
+    case ARRAY:
+        unfinishedArrays.top().second->addToArray(value);
+        break;
+    case OBJECT:
+        unfinishedObjects.top().second->addToObject(value, key);
+        break;
+    case NORMAL:
+        root->add(value, key);
+        break;
     }
-    return false;
 }
 
 JsonParser::JsonParser()
-        :parseState(), currentLine(0), m_curlyCount(0), m_straightCount(0)
+        :parseState(), root(nullptr), pushParser(*this)
 {
     parseState.push(NORMAL);
-    root = JsonObject();
-    canCreateValue = true;
 }
 
-JsonValue& JsonParser::operator[](const std::string& key)
+JsonValue& JsonParser::operator[](JsonStringView key)
 {
-    if(!hasKey(key))
-        throw std::invalid_argument("There is no such key '" + key + "'");
-    return root[key];
+    JsonValue* value = find(key);
+    if(value == nullptr)
+        throw std::invalid_argument("There is no such key '" + std::string(key) + "'");
+    return *value;
 }
 
-std::string JsonParser::readNumberValue(std::string& line)
+std::string JsonParser::dump(int indent) const
 {
-    bool readDot = false;
-    bool readMin = false;
-    auto valid = [&](std::string& line) {
-        if (line.front()=='.') {
-            if (!readDot) {
-                readDot = true;
-            }
-            else {
-                throw ParseError(currentLine, line, "Incorrect number format");
-            }
-        }
-        if (line.front()=='-') {
-            if (!readMin) {
-                readMin = true;
-            }
-            else {
-                throw ParseError(currentLine, line, "Incorrect number format");
-            }
-        }
-        return isdigit(line.front()) || line.front()=='.' || line.front()=='-';
-    };
+    JsonSerializer serializer(indent);
+    return std::string(serializer.serialize(*this));
+}
 
-    std::string result;
-    while (valid(line)) {
-        result += line.front();
-        line.erase(0, 1);
-    }
-    return result;
+JsonFrozenDocument JsonParser::freeze(bool indexKeys)
+{
+    return JsonFrozenDocument(*this, indexKeys);
 }
 
 JsonParser::~JsonParser()
@@ -802,15 +707,15 @@ JsonParser::~JsonParser()
 
 void JsonParser::clear()
 {
-    currentLine = 0;
     parseState = std::stack<PARSE_STATE>{};
     parseState.push(PARSE_STATE::NORMAL);
-    canCreateValue = true;
-    for (auto it = root.begin(); it!=root.end();) {
-        delete it->second;
-        it = root.erase(it);
-    }
-    root.clear();
+    source.close();
+    // Values that were not finished (ex. after a parse error) live in the arena as well
+    unfinishedObjects = {};
+    unfinishedArrays = {};
+    root = nullptr;
+    arena.release();
+    pushParser.reset();
 }
 
 JsonParser::JsonParser(const std::string& file_name)
@@ -819,21 +724,185 @@ JsonParser::JsonParser(const std::string& file_name)
     parse(file_name);
 }
 
-bool JsonParser::hasKey(const std::string& key)
+bool JsonParser::hasKey(JsonStringView key) const
+{
+    return root!=nullptr && root->count(key) > 0;
+}
+
+JsonValue* JsonParser::find(JsonStringView key) const
+{
+    if (root==nullptr)
+        return nullptr;
+    auto it = root->find(key);
+    return it==root->end() ? nullptr : it->second;
+}
+
+JsonObject::JsonObject()
+        :JsonObject(nullptr)
+{
+
+}
+
+JsonObject::JsonObject(JsonArena* arena)
+        :m_arena(arena), members(ArenaAllocator<value_type>(arena)), slots(nullptr), slotCount(0)
+{
+
+}
+
+JsonObject::~JsonObject()
+{
+    if (m_arena!=nullptr)
+        return;
+    for (auto& member : members)
+        delete[] member.first.data();
+    delete[] slots;
+}
+
+size_t JsonObject::hash(JsonStringView key)
+{
+    // FNV-1a
+    uint64_t hash = 14695981039346656037ull;
+    for (char c : key) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ull;
+    }
+    return static_cast<size_t>(hash ^ (hash >> 32));
+}
+
+size_t JsonObject::position(JsonStringView key) const
 {
-    return root.count(key) > 0;
+    return position(key, slots==nullptr ? 0 : hash(key));
 }
 
-JsonValue& JsonObject::operator[](const std::string& k)
+size_t JsonObject::position(JsonStringView key, size_t keyHash) const
 {
-    if(count(k) == 0)
-        throw std::invalid_argument("There is no such key '" + k + "'");
-    return *at(k);
+    if (slots==nullptr) {
+        for (size_t i = 0; i<members.size(); i++) {
+            if (members[i].first==key)
+                return i;
+        }
+        return members.size();
+    }
+
+    size_t mask = slotCount-1;
+    for (size_t slot = keyHash & mask;; slot = (slot+1) & mask) {
+        uint32_t index = slots[slot];
+        if (index==0)
+            return members.size();
+        if (members[index-1].first==key)
+            return index-1;
+    }
 }
 
-void JsonObject::add(JsonValue* value, const std::string& key)
+void JsonObject::rehash(size_t count)
 {
-    if(count(key)!=0)
-        throw std::invalid_argument("There already is a key '" + key + "'");
-    insert({key, value});
+    uint32_t* newSlots = m_arena!=nullptr
+                         ? static_cast<uint32_t*>(m_arena->allocate(count*sizeof(uint32_t), alignof(uint32_t)))
+                         : new uint32_t[count];
+    memset(newSlots, 0, count*sizeof(uint32_t));
+    size_t mask = count-1;
+    for (size_t i = 0; i<members.size(); i++) {
+        size_t slot = hash(members[i].first) & mask;
+        while (newSlots[slot]!=0)
+            slot = (slot+1) & mask;
+        newSlots[slot] = static_cast<uint32_t>(i+1);
+    }
+    if (m_arena==nullptr)
+        delete[] slots;
+    slots = newSlots;
+    slotCount = count;
+}
+
+void JsonObject::reserve(size_t count)
+{
+    members.reserve(count);
+    if (count>HASH_THRESHOLD && count*2>slotCount) {
+        size_t slots = 64;
+        while (slots<count*4)
+            slots *= 2;
+        rehash(slots);
+    }
+}
+
+void JsonObject::buildIndex()
+{
+    if (slots!=nullptr || members.empty())
+        return;
+    size_t count = 8;
+    while (count<members.size()*4)
+        count *= 2;
+    rehash(count);
+}
+
+JsonValue*& JsonObject::at(JsonStringView key)
+{
+    size_t found = position(key);
+    if (found==members.size())
+        throw std::out_of_range("There is no such key '"+std::string(key)+"'");
+    return members[found].second;
+}
+
+JsonValue* const& JsonObject::at(JsonStringView key) const
+{
+    size_t found = position(key);
+    if (found==members.size())
+        throw std::out_of_range("There is no such key '"+std::string(key)+"'");
+    return members[found].second;
+}
+
+JsonValue& JsonObject::operator[](JsonStringView k)
+{
+    auto it = find(k);
+    if(it == end())
+        throw std::invalid_argument("There is no such key '" + std::string(k) + "'");
+    return *it->second;
+}
+
+void JsonObject::add(JsonValue* value, JsonStringView key)
+{
+    if(!insert(value, key))
+        throw std::invalid_argument("There already is a key '" + std::string(key) + "'");
+}
+
+bool JsonObject::insert(JsonValue* value, JsonStringView key)
+{
+    if (position(key)<members.size())
+        return false;
+    if (members.size()>=UINT32_MAX-1)
+        throw std::length_error("Too many members for: JsonObject");
+
+    const char* copy;
+    if (m_arena!=nullptr) {
+        copy = m_arena->copyString(key.data(), key.size());
+    }
+    else {
+        char* heapCopy = new char[key.size()+1];
+        memcpy(heapCopy, key.data(), key.size());
+        heapCopy[key.size()] = '\0';
+        copy = heapCopy;
+    }
+    if (members.capacity()==0)
+        members.reserve(4);
+    members.emplace_back(JsonStringView(copy, key.size()), value);
+
+    if (slots!=nullptr || members.size()>HASH_THRESHOLD) {
+        // Keep the index at most half full
+        if (members.size()*2>slotCount) {
+            size_t count = 64;
+            while (count<members.size()*4)
+                count *= 2;
+            rehash(count);
+        }
+        else {
+            size_t mask = slotCount-1;
+            size_t slot = hash(members.back().first) & mask;
+            while (slots[slot]!=0)
+                slot = (slot+1) & mask;
+            slots[slot] = static_cast<uint32_t>(members.size());
+        }
+    }
+
+    if (m_arena!=nullptr && value!=nullptr && !value->hasFlag(JsonValue::IN_ARENA))
+        m_arena->own(value);
+    return true;
 }
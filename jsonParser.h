@@ -2,38 +2,270 @@
 #define JSONPARSER_JSONPARSER_H
 
 #include <string>
-#include <map>
+#include <utility>
 #include <vector>
 #include <stack>
+#include <memory>
+#include <cstdint>
+#include "mappedFile.h"
+#include "jsonArena.h"
+#include "jsonStructural.h"
+#include "jsonNumber.h"
+#include "jsonStringView.h"
+#include "jsonError.h"
+#include "jsonHandler.h"
+#include "jsonReader.h"
+#include "jsonPushParser.h"
 
 // Forward declaration to make using statements valid
 class JsonValue;
+class JsonCursor;
+class JsonFrozenDocument;
 
 /**
  * Some easy names for 'larger' data structures
  */
-//using JsonObject = std::map<std::string, JsonValue*>;
-using JsonArray = std::vector<JsonValue*>;
+using JsonArray = std::vector<JsonValue*, ArenaAllocator<JsonValue*>>;
+
+/**
+ * Deletes the value of a JsonValuePtr. Values that live in an arena are not deleted, the arena owns them.
+ */
+struct JsonValueDeleter {
+    void operator()(JsonValue* value) const;
+};
+
+/**
+ * Owning handle of a JsonValue on the heap, with the size of a pointer. The value and all values in it are
+ * freed with the handle. A handle can be moved, not copied.
+ */
+using JsonValuePtr = std::unique_ptr<JsonValue, JsonValueDeleter>;
 
 /**
  * Represents a JSON object
+ * Members are kept in insertion order in one contiguous array. Small objects are searched linearly,
+ * objects with more than HASH_THRESHOLD members get an open addressing hash index on top of the array.
+ * Iterating works like iterating a std::map: member.first is the key, member.second the value.
+ * Keys can be read without copying them, ex. JsonStringView key = member.first
  */
-class JsonObject : public std::map<std::string, JsonValue*>{
+class JsonObject {
+public:
+    using key_type = JsonStringView;
+    using mapped_type = JsonValue*;
+    using value_type = std::pair<const JsonStringView, JsonValue*>;
+    using size_type = size_t;
+
+private:
+    using Members = std::vector<value_type, ArenaAllocator<value_type>>;
+
+    static const size_t HASH_THRESHOLD = 16;    /**< Objects with more members than this get a hash index*/
+
+    JsonArena* m_arena;     /**< Arena that owns the keys and the index, nullptr if they are on the heap*/
+    Members members;        /**< Members in insertion order*/
+    uint32_t* slots;        /**< Hash index, position+1 of a member or 0 if the slot is empty*/
+    size_t slotCount;       /**< Amount of slots of the hash index, a power of two or 0 without index*/
+
+    /**
+     * Find the position of a key.
+     * @param key Key to look for.
+     * @return Position in the member array, size() if the key does not exist.
+     */
+    size_t position(JsonStringView key) const;
+
+    /**
+     * Find the position of a key whose hash is known.
+     * @param key Key to look for.
+     * @param keyHash hash(key), only used if the object has a hash index.
+     * @return Position in the member array, size() if the key does not exist.
+     */
+    size_t position(JsonStringView key, size_t keyHash) const;
+
+    /**
+     * Rebuild the hash index with a given amount of slots.
+     * @param count Amount of slots, a power of two.
+     */
+    void rehash(size_t count);
+
 public:
+    using iterator = Members::iterator;
+    using const_iterator = Members::const_iterator;
+
+    /**
+     * Default constructor, creates an empty object that allocates from the heap.
+     */
+    JsonObject();
+
+    /**
+     * Creates an empty object that allocates its keys and members from an arena.
+     * @param arena Arena to allocate from, nullptr to use the heap.
+     */
+    explicit JsonObject(JsonArena* arena);
+
+    /**
+     * Destructor, frees the keys and the index if they are on the heap. The values are not destructed.
+     */
+    ~JsonObject();
+
+    /**
+     * Deleted copy constructor. Copying is not allowed.
+     */
+    JsonObject(const JsonObject&) = delete;
+
     /**
-     * IMPORTANT: this function hides the basic operator[]() of the std::map container!
-     * That means that adding to the map is no longer possible through operator[](key) = value
+     * Deleted assignment operator. Assigning is not allowed.
+     */
+    JsonObject& operator=(const JsonObject&) = delete;
+
+    iterator begin()
+    {
+        return members.begin();
+    }
+
+    iterator end()
+    {
+        return members.end();
+    }
+
+    const_iterator begin() const
+    {
+        return members.begin();
+    }
+
+    const_iterator end() const
+    {
+        return members.end();
+    }
+
+    size_t size() const
+    {
+        return members.size();
+    }
+
+    bool empty() const
+    {
+        return members.empty();
+    }
+
+    /**
+     * Find a member.
+     * @param key Key to look for.
+     * @return Iterator to the member, end() if the key does not exist.
+     */
+    iterator find(JsonStringView key)
+    {
+        return members.begin()+static_cast<std::ptrdiff_t>(position(key));
+    }
+
+    /**
+     * Find a member.
+     * @param key Key to look for.
+     * @return Iterator to the member, end() if the key does not exist.
+     */
+    const_iterator find(JsonStringView key) const
+    {
+        return members.begin()+static_cast<std::ptrdiff_t>(position(key));
+    }
+
+    /**
+     * Find a member with a hash that was computed before, ex. by a JsonPointer that looks up the same key
+     * in many objects.
+     * @param key Key to look for.
+     * @param keyHash hash(key).
+     * @return Iterator to the member, end() if the key does not exist.
+     */
+    const_iterator find(JsonStringView key, size_t keyHash) const
+    {
+        return members.begin()+static_cast<std::ptrdiff_t>(position(key, keyHash));
+    }
+
+    /**
+     * Hash of a key, as used by the hash index of large objects.
+     * @param key The key.
+     * @return The hash.
+     */
+    static size_t hash(JsonStringView key);
+
+    /**
+     * Count the members with a key.
+     * @param key Key to look for.
+     * @return 1 if the key exists, else 0.
+     */
+    size_t count(JsonStringView key) const
+    {
+        return position(key)<members.size() ? 1 : 0;
+    }
+
+    /**
+     * Get the value of a key, like std::map::at.
+     * @throw out of range if the key does not exist.
+     * @param key Key to look for.
+     * @return Reference to the value.
+     */
+    JsonValue*& at(JsonStringView key);
+
+    /**
+     * Get the value of a key, like std::map::at.
+     * @throw out of range if the key does not exist.
+     * @param key Key to look for.
+     * @return Reference to the value.
+     */
+    JsonValue* const& at(JsonStringView key) const;
+
+    /**
+     * IMPORTANT: adding to the object is not possible through operator[](key) = value, use add.
      * @param key Key to get the value for
      * @return Reference to the JsonObject
      */
-    JsonValue& operator[](const std::string& key);
+    JsonValue& operator[](JsonStringView key);
 
     /**
-     * Add a value to the map.
+     * Add a value to the object.
+     * If the object lives in an arena and the value does not, the arena takes ownership of the value.
+     * @throw invalid argument if the key already exists.
      * @param value
      * @param key
      */
-    void add(JsonValue* value, const std::string& key);
+    void add(JsonValue* value, JsonStringView key);
+
+    /**
+     * Add a value to the object if the key does not exist yet.
+     * If the object lives in an arena and the value does not, the arena takes ownership of the value.
+     * @param value Value to add.
+     * @param key Key of the value.
+     * @return False if the key already exists, nothing is added in that case.
+     */
+    bool insert(JsonValue* value, JsonStringView key);
+
+    /**
+     * Make room for members, ex. when the amount of members is known before they are added.
+     * Objects with more than HASH_THRESHOLD members get their hash index right away.
+     * @param count Amount of members.
+     */
+    void reserve(size_t count);
+
+    /**
+     * Build the hash index now, also if the object has fewer members than HASH_THRESHOLD.
+     * Lookups then hash the key instead of comparing it with every member, which pays off for objects that are
+     * read many times and not changed anymore. Members added afterwards are added to the index.
+     */
+    void buildIndex();
+
+    /**
+     * Check whether the object has a hash index.
+     * @return True if lookups use the hash index.
+     */
+    bool hasIndex() const
+    {
+        return slots!=nullptr;
+    }
+
+    /**
+     * Get the arena of the object.
+     * @return The arena, nullptr if the object uses the heap.
+     */
+    JsonArena* arena() const
+    {
+        return m_arena;
+    }
 };
 
 
@@ -46,7 +278,9 @@ enum ValueType {
     JSON_ARRAY,
     JSON_OBJ,
     JSON_STRING,
-    JSON_BOOL
+    JSON_BOOL,
+    JSON_INT,
+    JSON_UINT
 };
 
 /**
@@ -54,32 +288,164 @@ enum ValueType {
  */
 class JsonValue {
 private:
-    ValueType type;                 /**< Type of the value*/
-    bool copied;                    /**< Copied flag, flag is set in copy constructor, default false*/
-    union {                         /**< Union of possible Json types*/
-        bool bool_value;            /**< Container if value is boolean type*/
-        double number_value;        /**< Container if value is number type*/
-        std::string* string_value;  /**< Container if value is string type*/
-        JsonObject* object_value;   /**< Container if value is JsonObject type*/
-        JsonArray* array_value;     /**< Container if value is JsonArray type*/
+    static const size_t SMALL_STRING_CAPACITY = 14;     /**< Longest string that is stored inside the value*/
+
+    /**
+     * Bits of the tag, the lower bits hold the ValueType.
+     */
+    enum TagBits : uint8_t {
+        TYPE_MASK = 0x0F,       /**< Bits of the ValueType*/
+        BORROWED = 0x10,        /**< Set if the storage was moved from a value of an arena, it belongs to the arena*/
+        IN_ARENA = 0x20,        /**< Arena flag, set if the value and its storage belong to a JsonArena*/
+        SMALL_STRING = 0x40     /**< Set if the characters of the string are stored inside the value*/
+    };
+
+    /**
+     * Layout of all values, except strings of at most SMALL_STRING_CAPACITY characters.
+     */
+    struct Large {
+        uint8_t tag;                    /**< Type and flags of the value*/
+        uint32_t length;                /**< Length of the string if value is string type*/
+        union {                         /**< Union of possible Json types*/
+            bool bool_value;            /**< Container if value is boolean type*/
+            double number_value;        /**< Container if value is number type*/
+            int64_t int_value;          /**< Container if value is integer type*/
+            uint64_t uint_value;        /**< Container if value is unsigned integer type*/
+            char* string_value;         /**< Null terminated characters if value is string type*/
+            JsonObject* object_value;   /**< Container if value is JsonObject type*/
+            JsonArray* array_value;     /**< Container if value is JsonArray type*/
+        };
+    };
+
+    /**
+     * Layout of strings of at most SMALL_STRING_CAPACITY characters.
+     */
+    struct Small {
+        uint8_t tag;                            /**< Type and flags of the value*/
+        char data[SMALL_STRING_CAPACITY];       /**< Characters of the string*/
+        uint8_t remaining;                      /**< Unused characters, is the null terminator of a full string*/
     };
 
+    /**
+     * Both layouts start with the tag, so it can always be read through large.
+     */
+    union {
+        Large large;
+        Small small;
+    };
+
+    /**
+     * Get the type of the value.
+     * @return Type stored in the tag.
+     */
+    ValueType type() const
+    {
+        return static_cast<ValueType>(large.tag & TYPE_MASK);
+    }
+
+    /**
+     * Check a flag of the tag.
+     * @param flag Flag to check.
+     * @return True if the flag is set.
+     */
+    bool hasFlag(TagBits flag) const
+    {
+        return (large.tag & flag)!=0;
+    }
+
+    /**
+     * Set the type of the value, the flags are kept.
+     * @param valueType Type of the value.
+     */
+    void setType(ValueType valueType)
+    {
+        large.tag = static_cast<uint8_t>((large.tag & ~TYPE_MASK) | valueType);
+    }
+
+    /**
+     * Store a parsed number with the matching type.
+     * @param number Number to store.
+     */
+    void setNumber(const JsonNumber& number);
+
+    /**
+     * Store a string. Short strings are stored inside the value, longer ones are copied
+     * to the arena, or to the heap if there is no arena.
+     * @param data Characters of the string.
+     * @param length Amount of characters.
+     * @param arena Arena to copy long strings to, nullptr to use the heap.
+     */
+    void setString(const char* data, size_t length, JsonArena* arena);
+
+    /**
+     * Get the characters of a string value.
+     * @return Null terminated characters.
+     */
+    const char* stringData() const
+    {
+        return hasFlag(SMALL_STRING) ? small.data : large.string_value;
+    }
+
+    /**
+     * Get the length of a string value.
+     * @return Amount of characters.
+     */
+    size_t stringLength() const
+    {
+        return hasFlag(SMALL_STRING) ? SMALL_STRING_CAPACITY-small.remaining : large.length;
+    }
+
+    /**
+     * Check whether the value frees its storage, an object, array or long string on the heap.
+     * @return True if the destructor frees memory.
+     */
+    bool ownsHeapMemory() const;
+
+    /**
+     * Free the storage the value owns, the value is left in an invalid state.
+     */
+    void destroy() noexcept;
+
+    /**
+     * Take the storage of another value, the other value becomes null.
+     * @param other Value to take the storage from.
+     */
+    void take(JsonValue& other) noexcept;
+
 public:
 
     /**
-     * Copy constructor. First created object keeps delete rights.
-     * The new object's copied flag will be set to true.
-     * @param other Original JsonValue object.
+     * Deleted copy constructor. Values own their storage, use clone() for a deep copy.
+     */
+    JsonValue(const JsonValue&) = delete;
+
+    /**
+     * Deleted assignment operator. Values own their storage, use clone() for a deep copy.
+     */
+    JsonValue& operator=(const JsonValue&) = delete;
+
+    /**
+     * Move constructor, takes the storage of the other value without copying it. The other value becomes null.
+     * Storage that belongs to an arena stays in the arena, the new value is only valid as long as the arena.
+     * @param other Value to move.
+     */
+    JsonValue(JsonValue&& other) noexcept;
+
+    /**
+     * Move assignment, frees the storage of this value and takes the storage of the other value.
+     * The other value becomes null.
+     * @throw invalid argument if this value lives in an arena and the other value owns heap memory, the arena
+     * would never free it.
+     * @param other Value to move.
+     * @return Reference to this value.
      */
-    JsonValue(const JsonValue& other);
+    JsonValue& operator=(JsonValue&& other);
 
     /**
-     * Assignment operator. First created object keeps delete rights.
-     * The new object's copied flag will be set to true.
-     * @param other Original JsonValue object.
-     * @return reference to this object.
+     * Create a deep copy on the heap, that does not depend on the arena of this value.
+     * @return The copy.
      */
-    JsonValue& operator=(const JsonValue& other);
+    JsonValue clone() const;
 
     /**
      * Default constructor. Sets value type to null.
@@ -91,19 +457,37 @@ public:
      * This constructor should be used to create an empty json array structure, or an
      * empty json object structure
      * @throws invalid argument error if type is other than JsonArray or JsonObject
+     * @param arena Arena that owns the storage of the value, nullptr to use the heap.
      */
-    explicit JsonValue(const ValueType&);
+    explicit JsonValue(const ValueType&, JsonArena* arena = nullptr);
 
     /**
      * Constructor taking a value type and key (as string) as input parameters.
+     * JSON_NUM values that are integers fitting in 64 bits are stored as JSON_INT or JSON_UINT.
+     * @throws invalid argument error if a number is formatted incorrectly, or does not fit in JSON_INT or JSON_UINT
      * @param type Type of the value (ValueType)
      * @param key Key for the value (string)
+     * @param arena Arena that owns the storage of the value, nullptr to use the heap.
+     */
+    JsonValue(const ValueType& type, const std::string& key, JsonArena* arena = nullptr);
+
+    /**
+     * Constructor taking a parsed number.
+     * @param number Number, stored as JSON_INT, JSON_UINT or JSON_NUM depending on its kind.
+     * @param arena Arena that owns the value, nullptr if it is allocated on the heap.
      */
-    JsonValue(const ValueType& type, const std::string& key);
+    explicit JsonValue(const JsonNumber& number, JsonArena* arena = nullptr);
 
     /**
-     * Destructor of the JsonValue class.
-     * If the copied flag is set, no destruction will happen.
+     * Constructor taking the characters of a string.
+     * @param string String value, copied into the value.
+     * @param arena Arena that owns the value, nullptr if it is allocated on the heap.
+     */
+    explicit JsonValue(JsonStringView string, JsonArena* arena = nullptr);
+
+    /**
+     * Destructor of the JsonValue class, frees the heap memory of the value and of the values in it.
+     * Values that live in an arena are never destructed, their memory is freed by the arena.
      */
     ~JsonValue();
 
@@ -139,10 +523,17 @@ public:
 
     /**
      * Check whether the JsonValue is of JsonNum type.
+     * Integers (JSON_INT and JSON_UINT) are numbers as well.
      * @return True if the type is JsonNum.
      */
     bool isNumber() const;
 
+    /**
+     * Check whether the JsonValue is a number stored as an exact 64-bit integer.
+     * @return True if the type is JSON_INT or JSON_UINT.
+     */
+    bool isInteger() const;
+
     /**
      * Get the boolean value of the JsonValue.
      * If the type is JsonNum, it will check whether it's 0 or 1, and it converts those
@@ -159,6 +550,22 @@ public:
      */
     double getNumberValue() const;
 
+    /**
+     * Get the exact value of an integer.
+     * @throw invalid argument if the type is not JSON_INT or JSON_UINT.
+     * @throw invalid argument if the value does not fit in an int64_t.
+     * @return the integer value of the JsonValue.
+     */
+    int64_t getInt64Value() const;
+
+    /**
+     * Get the exact value of a non-negative integer.
+     * @throw invalid argument if the type is not JSON_INT or JSON_UINT.
+     * @throw invalid argument if the value is negative.
+     * @return the integer value of the JsonValue.
+     */
+    uint64_t getUInt64Value() const;
+
     /**
      * Get the string value of the JsonValue
      * @throw invalid argument if the type is not JsonString
@@ -166,6 +573,32 @@ public:
      */
     std::string getStringValue() const;
 
+    /**
+     * Get the string value of the JsonValue without copying it.
+     * The view is valid as long as the JsonValue, short strings are stored inside the JsonValue itself.
+     * @throw invalid argument if the type is not JsonString
+     * @return View of the characters of the string value
+     */
+    JsonStringView getStringView() const
+    {
+        if (!isString())
+            throw std::invalid_argument("Invalid type for: JsonString");
+        return JsonStringView(stringData(), stringLength());
+    }
+
+    /**
+     * Get the string value of the JsonValue without copying it.
+     * The pointer is valid as long as the JsonValue, short strings are stored inside the JsonValue itself.
+     * @throw invalid argument if the type is not JsonString
+     * @return Null terminated characters of the string value
+     */
+    const char* c_str() const
+    {
+        if (!isString())
+            throw std::invalid_argument("Invalid type for: JsonString");
+        return stringData();
+    }
+
     /**
      * Get the null value of the JsonValue
      * @return nullptr of type JsonObject
@@ -188,11 +621,19 @@ public:
 
     /**
      * Adds a value to the array value.
+     * If the array lives in an arena and the value does not, the arena takes ownership of the value.
      * @throw invalid argument if the type is not JsonArray.
      * @param value Value to add to the array.
      */
     void addToArray(JsonValue* value);
 
+    /**
+     * Adds a value to the array value, the array takes ownership of it.
+     * @throw invalid argument if the type is not JsonArray.
+     * @param value Value to add to the array.
+     */
+    void addToArray(JsonValuePtr value);
+
     /**
      * Adds a key and associated value to the JsonObject.
      * @throw invalid argument if the type is not JsonObject.
@@ -200,7 +641,16 @@ public:
      * @param value Value to add to the object.
      * @param key Key to reference the value with.
      */
-    void addToObject(JsonValue* value, const std::string& key);
+    void addToObject(JsonValue* value, JsonStringView key);
+
+    /**
+     * Adds a key and associated value to the JsonObject, the object takes ownership of the value.
+     * @throw invalid argument if the type is not JsonObject.
+     * @throw invalid argument if the key already exists, the value is freed in that case.
+     * @param value Value to add to the object.
+     * @param key Key to reference the value with.
+     */
+    void addToObject(JsonValuePtr value, JsonStringView key);
 
     /**
      * Index operator which can be used if the ValueType is JsonArray.
@@ -218,7 +668,7 @@ public:
      * @param key Key associated to the value we want to get.
      * @return Reference to the JsonValue associated with key in the JsonObject.
      */
-    JsonValue& operator[](const std::string& key);
+    JsonValue& operator[](JsonStringView key);
 
     /**
      * Check wheter a key exists if the ValueType is JsonObject.
@@ -226,56 +676,37 @@ public:
      * @param key Key to check
      * @return True if the key can be found
      */
-    bool hasKey(const std::string& key);
-};
-
-/**
- * Simple error class for Parsing errors.
- */
-class ParseError : public std::exception {
-private:
-    std::string message;    /**< Message to show*/
-public:
+    bool hasKey(JsonStringView key) const;
 
     /**
-     * Constructor for parse errors.
-     * @param line Line of the file where the error happened.
-     * @param content Contents of the line where the error happened.
-     * @param message Additional message.
+     * Find the value of a key if the ValueType is JsonObject.
+     * Unlike operator[], a missing key is not an error. The key is looked up once.
+     * @throw invalid argument if the type is not JsonObject
+     * @param key Key to look for
+     * @return Pointer to the JsonValue associated with key, nullptr if the key can not be found
      */
-    ParseError(int line, const std::string& content, const std::string& message)
-            :ParseError(line, message)
-    {
-        if (content.empty())
-            return;
-        this->message = "Error at line "+std::to_string(line)+":\n|\n"+content+"\n"+message;
-    }
+    JsonValue* find(JsonStringView key) const;
 
     /**
-     * Constructor for parse errors.
-     * @param line Line of the file where the error happened.
-     * @param message Additional message.
+     * Write the value as json text.
+     * Use a JsonSerializer to reuse its buffer when many values are written, or to write to a file descriptor.
+     * @param indent Amount of spaces per level of nesting, 0 for compact text on a single line.
+     * @return The text.
      */
-    ParseError(int line, const std::string& message)
-    {
-        this->message = "Error at line "+std::to_string(line)+": "+message;
-    }
+    std::string dump(int indent = 0) const;
 
-    /**
-     * Overridden what function. Displays the message.
-     * @return Error message.
-     */
-    const char* what() const noexcept override
-    {
-        return message.c_str();
-    }
+    friend class JsonObject;
+    friend class JsonSerializer;
+    friend class JsonBinary;
+    friend class JsonImage;
+    friend struct JsonValueDeleter;
 };
 
 /**
  * Class that parses a file and builds a Json structure which can be accessed
  * from within the code.
  */
-class JsonParser {
+class JsonParser : private JsonHandler {
 public:
 
     /**
@@ -295,7 +726,14 @@ public:
      * @param key Key to check
      * @return True if the key exists
      */
-    bool hasKey(const std::string& key);
+    bool hasKey(JsonStringView key) const;
+
+    /**
+     * Find the value of a key of the root JsonObject.
+     * @param key Key to look for
+     * @return Pointer to the JsonValue associated with the key, nullptr if the key does not exist
+     */
+    JsonValue* find(JsonStringView key) const;
 
     /**
      * Destructor for the JsonParser.
@@ -309,12 +747,156 @@ public:
      */
     void parse(const std::string& file_name);
 
+    /**
+     * Parses a json file and creates a data structure with only the values of a projection.
+     * All other values are skipped without creating JsonValues, and without validating them.
+     * @throw invalid argument if the file can not be opened.
+     * @throw ParseError if the file is not valid json.
+     * @param file_name Path to input file.
+     * @param projection Values to keep.
+     */
+    void parse(const std::string& file_name, const JsonProjection& projection);
+
+    /**
+     * Parses a json file by memory mapping it and creates a data structure.
+     * The file is parsed straight from the mapping, without copying it first.
+     * The mapping stays alive until the data structure is cleared or another file is parsed.
+     * @throw invalid argument if the file can not be opened.
+     * @throw ParseError if the file is not valid json.
+     * @param file_name Path to input file.
+     */
+    void parseMapped(const std::string& file_name);
+
+    /**
+     * Parses json text from a buffer and creates a data structure.
+     * The buffer is only read, it does not need to be null terminated and is
+     * not used anymore after parsing.
+     * @throw ParseError if the text is not valid json.
+     * @param data Start of the json text.
+     * @param length Amount of characters in the buffer.
+     */
+    void parse(const char* data, size_t length);
+
+    /**
+     * Parses json text from a buffer with the buffers of another reader.
+     * Parsing many small documents with one reader per thread reuses its buffers and structural index,
+     * instead of growing new ones in every parser.
+     * @throw ParseError if the text is not valid json.
+     * @param data Start of the json text.
+     * @param length Amount of characters in the buffer.
+     * @param reader Tokenizer to use, only used during this call.
+     */
+    void parse(const char* data, size_t length, JsonReader& reader);
+
+    /**
+     * Parses json text from a buffer and creates a data structure with only the values of a projection.
+     * @throw ParseError if the text is not valid json.
+     * @param data Start of the json text.
+     * @param length Amount of characters in the buffer.
+     * @param projection Values to keep.
+     */
+    void parse(const char* data, size_t length, const JsonProjection& projection);
+
+    /**
+     * Parses json text from a string and creates a data structure.
+     * @throw ParseError if the text is not valid json.
+     * @param json String containing the json text.
+     */
+    void parseString(const std::string& json);
+
+    /**
+     * Parses json text from a string and creates a data structure with only the values of a projection.
+     * @throw ParseError if the text is not valid json.
+     * @param json String containing the json text.
+     * @param projection Values to keep.
+     */
+    void parseString(const std::string& json, const JsonProjection& projection);
+
+    /**
+     * Loads a binary snapshot written by save(), without parsing json text.
+     * @throw invalid argument if the file can not be opened or is not a valid snapshot.
+     * @param file_name Path to the snapshot.
+     */
+    void loadBinary(const std::string& file_name);
+
+    /**
+     * Writes the data structure as a binary snapshot, see JsonBinary for the layout.
+     * Loading the snapshot with loadBinary() is much faster than parsing the json text again.
+     * @throw invalid argument if nothing was parsed or the file can not be written.
+     * @param file_name Path of the snapshot, an existing file is overwritten.
+     */
+    void save(const std::string& file_name) const;
+
+    /**
+     * Writes the data structure as an image that JsonImage reads in place, without parsing or decoding it.
+     * @throw invalid argument if nothing was parsed or the file can not be written.
+     * @param file_name Path of the image, an existing file is overwritten.
+     */
+    void saveImage(const std::string& file_name) const;
+
+    /**
+     * Parses the next chunk of json text that arrives in pieces, ex. from a socket.
+     * The first chunk of a document clears the data structure. Values are added as soon as they are read,
+     * so the data structure is only complete after finish(). Strings, numbers and literals may be cut off
+     * anywhere by the end of a chunk. After an error, the next chunk starts a new document.
+     * @throw ParseError if the text is not valid json.
+     * @throw invalid argument if an object has a duplicate key.
+     * @param data Start of the chunk, the chunk is not used anymore after this call.
+     * @param length Amount of characters in the chunk.
+     */
+    void feed(const char* data, size_t length);
+
+    /**
+     * Parses the next chunk of json text that arrives in pieces.
+     * @throw ParseError if the text is not valid json.
+     * @param chunk The chunk.
+     */
+    void feed(const std::string& chunk)
+    {
+        feed(chunk.data(), chunk.size());
+    }
+
+    /**
+     * Ends the document that was fed in chunks.
+     * @throw ParseError if the document is not complete.
+     */
+    void finish();
+
     /**
      * Index operator used to access the root JsonObject easily.
      * @param key Key to access.
      * @return Reference to JsonValue associated with the key.
      */
-    JsonValue& operator[](const std::string& key);
+    JsonValue& operator[](JsonStringView key);
+
+    /**
+     * Write the root JsonObject as json text.
+     * @throw invalid argument if nothing was parsed.
+     * @param indent Amount of spaces per level of nesting, 0 for compact text on a single line.
+     * @return The text.
+     */
+    std::string dump(int indent = 0) const;
+
+    /**
+     * Turn the parsed data structure into an immutable document that threads can share without locks.
+     * The document takes over the arena, nothing is copied. The parser is empty afterwards and can parse
+     * the next document. Include jsonFrozenDocument.h to use the result.
+     * @throw invalid argument if nothing was parsed or a fed document is not finished.
+     * @param indexKeys True to build a key index for every object with more than
+     * JsonFrozenDocument::INDEX_THRESHOLD members, so lookups of the frozen document hash the key instead
+     * of comparing it with every member.
+     * @return The frozen document.
+     */
+    JsonFrozenDocument freeze(bool indexKeys = false);
+
+    /**
+     * Get the amount of memory the parsed data structure uses.
+     * @return Amount of bytes allocated from the arena of the data structure.
+     */
+    size_t memoryUsage() const
+    {
+        return arena.bytesUsed();
+    }
 
     /**
      * Deleted copy constructor. Copying is not allowed.
@@ -342,49 +924,49 @@ private:
     std::stack<std::pair<std::string, JsonValue*>> unfinishedObjects;   /**< Stack of unfinished JsonObjects*/
     std::stack<std::pair<std::string, JsonValue*>> unfinishedArrays;    /**< Stack of unfinished JsonArrays*/
 
-    JsonObject root;        /**< Root JsonObject*/
-    int m_curlyCount;       /**< Count of curly brackets '{}'*/
-    int m_straightCount;    /**< Count of straight brackets '[]'*/
-    int currentLine;        /**< Current line in the file*/
-    bool canCreateValue;    /**< Flag to determine wheter we can create a new JsonValue*/
+    JsonArena arena;        /**< Arena that owns all values of the data structure*/
+    JsonObject* root;       /**< Root JsonObject, allocated in the arena*/
+    MappedFile source;      /**< Mapped input file, kept alive as long as the data structure*/
+    JsonReader reader;      /**< Tokenizer of the input, its buffers are reused between parses*/
+    JsonStringView pendingKey;  /**< Key of the next member of the current object, in the buffer of the reader*/
+    JsonPushParser pushParser;  /**< Tokenizer of chunked input, keeps its state between chunks*/
 
     /**
-     * Skip whitespaces in front of a line.
-     * @param line Line where we need to skip the whitespaces in.
+     * Events of the reader, they build the data structure.
+     * The first object that starts is the root object.
      */
-    static void skipWhiteSpace(std::string& line);
+    void startObject() override;
+    void key(JsonStringView key) override;
+    void endObject() override;
+    void startArray() override;
+    void endArray() override;
+    void string(JsonStringView value) override;
+    void number(const JsonNumber& value) override;
+    void boolean(bool value) override;
+    void null() override;
 
-    /**
-     * Read the quoted string.
-     * Also erases the quoted string from the line.
-     * The first character of the line should be a quoteChar.
-     * @param line String that contains a quoted substring.
-     * @param quoteChar Determine what the quote character is (' or ")
-     * @return The quoted substring. If there is none, an empty string will be returned.
-     */
-    static std::string getQuotedString(std::string& line, char quoteChar);
+    friend class JsonReader;
+    friend class JsonSerializer;
+    friend class JsonPointer;
+    friend class JsonQuery;
+    friend class JsonProjection;
+    friend class JsonFrozenDocument;
 
     /**
-     * Check whether the next char in the line is c.
-     * If the expected character is found, it will be removed.
-     * @param line String wherein we need to check for the next char.
-     * @param c Character we need to check for.
-     * @return True if the first character of the string is c, else false.
+     * Pops the innermost unfinished object or array and adds it to its parent.
      */
-    static bool expectChar(std::string& line, char c);
+    void finishValue();
 
     /**
-     * Read a number from a string.
-     * The first character of the input should be a digit.
-     * @throw Parse error if the number is formatted incorrectly (ex. two dots)
-     * @param line Line to read the number from.
-     * @return std::string containing the number.
+     * Adds a finished value to the current object or array.
+     * @param value Value to add, will be deleted if it can not be added.
+     * @param key Key of the value, ignored if the value is added to an array.
      */
-    std::string readNumberValue(std::string& line);
+    void attachValue(JsonValue* value, JsonStringView key);
 
     /**
      * Clears and resets the object.
-     * Removes all JsonValues. This function is also used in @see parse()
+     * Removes all JsonValues by releasing the arena at once. This function is also used in @see parse()
      * A new file can be parsed with the same object, but older data will be destructed
      * and can not be used anymore. In case you want to parse multiple files at the same time, you should
      * use multiple JsonParsers.
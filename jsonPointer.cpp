@@ -0,0 +1,119 @@
+#include <stdexcept>
+#include "jsonPointer.h"
+
+JsonPointer::JsonPointer(JsonStringView pointer)
+        :pointer(pointer)
+{
+    if (pointer.empty())
+        return;
+    if (pointer[0]!='/')
+        throw std::invalid_argument("Invalid JSON pointer '"+this->pointer+"', it must start with '/'");
+
+    Token token{};
+    for (size_t i = 1; i<=pointer.size(); i++) {
+        if (i==pointer.size() || pointer[i]=='/') {
+            tokens.push_back(std::move(token));
+            token = Token{};
+            continue;
+        }
+        char c = pointer[i];
+        if (c=='~') {
+            char next = i+1<pointer.size() ? pointer[i+1] : '\0';
+            if (next!='0' && next!='1')
+                throw std::invalid_argument("Invalid escape sequence in JSON pointer '"+this->pointer+"'");
+            c = next=='0' ? '~' : '/';
+            i++;
+        }
+        token.key += c;
+    }
+
+    for (Token& current : tokens) {
+        current.hash = JsonObject::hash(current.key);
+        // Array indices have no leading zeros, "-" is the element after the last one and never exists
+        current.index = NO_INDEX;
+        const std::string& key = current.key;
+        if (key.empty() || key.size()>18 || (key[0]=='0' && key.size()>1))
+            continue;
+        size_t index = 0;
+        for (char digit : key) {
+            if (digit<'0' || digit>'9') {
+                index = NO_INDEX;
+                break;
+            }
+            index = index*10+static_cast<size_t>(digit-'0');
+        }
+        current.index = index;
+    }
+}
+
+const JsonValue* JsonPointer::resolve(const JsonValue& root) const
+{
+    return tokens.empty() ? &root : walk(root, 0);
+}
+
+JsonValue* JsonPointer::resolve(JsonValue& root) const
+{
+    return tokens.empty() ? &root : walk(root, 0);
+}
+
+const JsonValue* JsonPointer::resolve(const JsonParser& parser) const
+{
+    if (parser.root==nullptr)
+        return nullptr;
+    return find(*parser.root);
+}
+
+JsonValue* JsonPointer::resolve(JsonParser& parser) const
+{
+    if (parser.root==nullptr)
+        return nullptr;
+    return find(*parser.root);
+}
+
+const JsonValue* JsonPointer::resolve(const JsonObject& root) const
+{
+    return find(root);
+}
+
+JsonValue* JsonPointer::resolve(JsonObject& root) const
+{
+    return find(root);
+}
+
+JsonValue* JsonPointer::find(const JsonObject& root) const
+{
+    if (tokens.empty())
+        return nullptr;
+    const Token& token = tokens[0];
+    auto found = root.find(token.key, token.hash);
+    if (found==root.end())
+        return nullptr;
+    return tokens.size()==1 ? found->second : walk(*found->second, 1);
+}
+
+JsonValue* JsonPointer::walk(const JsonValue& root, size_t first) const
+{
+    const JsonValue* value = &root;
+    JsonValue* found = nullptr;
+    for (size_t i = first; i<tokens.size(); i++) {
+        const Token& token = tokens[i];
+        if (value->isObject()) {
+            const JsonObject& object = value->getObjectValue();
+            auto member = object.find(token.key, token.hash);
+            if (member==object.end())
+                return nullptr;
+            found = member->second;
+        }
+        else if (value->isArray()) {
+            const JsonArray& array = value->getArrayValue();
+            if (token.index>=array.size())
+                return nullptr;
+            found = array[token.index];
+        }
+        else {
+            return nullptr;
+        }
+        value = found;
+    }
+    return found;
+}
@@ -0,0 +1,122 @@
+#ifndef JSONPARSER_JSONPOINTER_H
+#define JSONPARSER_JSONPOINTER_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include "jsonParser.h"
+
+/**
+ * Path to a value in a document, as defined by RFC 6901, ex. "/animations/1/frame_time".
+ * The path is parsed once: escape sequences are resolved, the hashes of the keys and the array indices are
+ * computed when the pointer is created. Resolving the pointer is a single walk that never throws and never
+ * allocates, so one pointer can be resolved against many documents in a tight loop, also from several threads.
+ * A token is an array index if the value it is applied to is an array, else it is a key.
+ */
+class JsonPointer {
+public:
+
+    /**
+     * Parses a pointer.
+     * @throw invalid argument if the pointer is not empty and does not start with '/', or has an invalid escape sequence.
+     * @param pointer The pointer, "" for the root and "/" for the key "" of the root.
+     */
+    explicit JsonPointer(JsonStringView pointer);
+
+    /**
+     * Find the value a pointer refers to.
+     * @param root Value to start from.
+     * @return The value, nullptr if it does not exist.
+     */
+    const JsonValue* resolve(const JsonValue& root) const;
+
+    /**
+     * Find the value a pointer refers to, the value can be changed.
+     * @param root Value to start from.
+     * @return The value, nullptr if it does not exist.
+     */
+    JsonValue* resolve(JsonValue& root) const;
+
+    /**
+     * Find the value a pointer refers to, starting from the root object of a parser.
+     * @param parser Parser to start from.
+     * @return The value, nullptr if it does not exist or if the pointer is empty: the root is not a JsonValue.
+     */
+    const JsonValue* resolve(const JsonParser& parser) const;
+
+    /**
+     * Find the value a pointer refers to, starting from the root object of a parser, the value can be changed.
+     * @param parser Parser to start from.
+     * @return The value, nullptr if it does not exist or if the pointer is empty: the root is not a JsonValue.
+     */
+    JsonValue* resolve(JsonParser& parser) const;
+
+    /**
+     * Find the value a pointer refers to, starting from a root object, ex. of a JsonFrozenDocument.
+     * @param root Object to start from.
+     * @return The value, nullptr if it does not exist or if the pointer is empty: the root is not a JsonValue.
+     */
+    const JsonValue* resolve(const JsonObject& root) const;
+
+    /**
+     * Find the value a pointer refers to, starting from a root object, the value can be changed.
+     * @param root Object to start from.
+     * @return The value, nullptr if it does not exist or if the pointer is empty: the root is not a JsonValue.
+     */
+    JsonValue* resolve(JsonObject& root) const;
+
+    /**
+     * Get the amount of reference tokens.
+     * @return Amount of tokens, 0 for the root.
+     */
+    size_t size() const
+    {
+        return tokens.size();
+    }
+
+    /**
+     * Get the pointer as it was parsed.
+     * @return The pointer.
+     */
+    const std::string& str() const
+    {
+        return pointer;
+    }
+
+private:
+
+    static const size_t NO_INDEX = static_cast<size_t>(-1);    /**< Index of tokens that are no array index*/
+
+    /**
+     * One reference token of the pointer.
+     */
+    struct Token {
+        std::string key;    /**< The token with its escape sequences resolved*/
+        size_t hash;        /**< JsonObject::hash(key)*/
+        size_t index;       /**< Array index of the token, NO_INDEX if it is not a valid index*/
+    };
+
+    std::string pointer;        /**< The pointer as it was parsed*/
+    std::vector<Token> tokens;  /**< Reference tokens, in order*/
+
+    /**
+     * Walk the tokens from the members of a root object.
+     * The containers hold their values as JsonValue*, the public overloads give the result the constness of
+     * their root.
+     * @param root Object the first token is applied to.
+     * @return The value, nullptr if it does not exist or if the pointer is empty.
+     */
+    JsonValue* find(const JsonObject& root) const;
+
+    /**
+     * Walk the tokens from a value.
+     * @param root Value the first token is applied to.
+     * @param first First token to apply, there must be at least one token left.
+     * @return The value, nullptr if it does not exist.
+     */
+    JsonValue* walk(const JsonValue& root, size_t first) const;
+
+    friend class JsonProjection;
+};
+
+#endif //JSONPARSER_JSONPOINTER_H
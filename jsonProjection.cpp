@@ -0,0 +1,101 @@
+#include <stdexcept>
+#include "jsonProjection.h"
+#include "jsonPointer.h"
+
+const uint32_t JsonProjection::ALL;
+const uint32_t JsonProjection::NONE;
+
+JsonProjection::JsonProjection()
+        :nodes(2), root(1)
+{
+}
+
+JsonProjection::JsonProjection(std::initializer_list<JsonStringView> pointers)
+        :JsonProjection()
+{
+    for (JsonStringView pointer : pointers)
+        add(pointer);
+}
+
+JsonProjection::JsonProjection(const std::vector<std::string>& pointers)
+        :JsonProjection()
+{
+    for (const std::string& pointer : pointers)
+        add(pointer);
+}
+
+JsonProjection::JsonProjection(const JsonParser& tree)
+        :JsonProjection()
+{
+    if (tree.root!=nullptr)
+        addTree(root, *tree.root);
+}
+
+JsonProjection& JsonProjection::add(JsonStringView pointer)
+{
+    JsonPointer parsed(pointer);
+    if (parsed.tokens.empty()) {
+        root = ALL;
+        return *this;
+    }
+    uint32_t node = root;
+    for (size_t i = 0; i+1<parsed.tokens.size(); i++)
+        node = descend(node, parsed.tokens[i].key, parsed.tokens[i].hash);
+    keep(node, parsed.tokens.back().key, parsed.tokens.back().hash);
+    return *this;
+}
+
+uint32_t JsonProjection::descend(uint32_t node, const std::string& key, size_t hash)
+{
+    if (node==ALL)
+        return ALL;
+    for (const Child& current : nodes[node]) {
+        if (current.hash==hash && current.key==key)
+            return current.node;
+    }
+    auto created = static_cast<uint32_t>(nodes.size());
+    nodes.emplace_back();
+    nodes[node].push_back(Child{key, hash, created});
+    return created;
+}
+
+void JsonProjection::keep(uint32_t node, const std::string& key, size_t hash)
+{
+    if (node==ALL)
+        return;
+    for (Child& current : nodes[node]) {
+        if (current.hash==hash && current.key==key) {
+            // The keys that were added below it before are kept as part of the whole value
+            current.node = ALL;
+            return;
+        }
+    }
+    nodes[node].push_back(Child{key, hash, ALL});
+}
+
+void JsonProjection::addTree(uint32_t node, const JsonObject& tree)
+{
+    for (const auto& member : tree) {
+        std::string key(member.first);
+        size_t hash = JsonObject::hash(key);
+        const JsonValue& value = *member.second;
+        if (value.isObject())
+            addTree(descend(node, key, hash), value.getObjectValue());
+        else if (value.isBool() && !value.isNumber() && value.getBoolValue())
+            keep(node, key, hash);
+        else
+            throw std::invalid_argument("Invalid projection of '"+key+"', expected true or an object");
+    }
+}
+
+uint32_t JsonProjection::child(uint32_t node, JsonStringView key) const
+{
+    if (node==ALL)
+        return ALL;
+    size_t hash = JsonObject::hash(key);
+    for (const Child& current : nodes[node]) {
+        if (current.hash==hash && JsonStringView(current.key)==key)
+            return current.node;
+    }
+    return NONE;
+}
@@ -0,0 +1,127 @@
+#ifndef JSONPARSER_JSONPROJECTION_H
+#define JSONPARSER_JSONPROJECTION_H
+
+#include <string>
+#include <vector>
+#include <initializer_list>
+#include <cstdint>
+#include <cstddef>
+#include "jsonStringView.h"
+
+class JsonParser;
+class JsonObject;
+
+/**
+ * Field mask for parsing only a part of a document, ex. a dozen fields of objects with hundreds of fields.
+ * The mask is a tree of keys, built from JSON pointers or from a nested object of keys. A path keeps the whole
+ * value it ends at, the objects on the way keep only the members that are in the mask. Arrays are transparent:
+ * the mask of an array applies to every element, so "/animations/name" keeps the name of every animation.
+ * Objects on the way are kept even if none of their members match, so the elements of an array keep their
+ * indices. Scalars where the mask expects an object are dropped.
+ * A JsonParser that parses with a projection skips all other values by matching brackets, without creating
+ * JsonValues for them. Like a JsonDocument, the skipped values are not validated.
+ * JsonProjection projection{"/file", "/animations/name", "/animations/frame_time"};
+ * parser.parse("cool_file.json", projection);
+ */
+class JsonProjection {
+public:
+
+    /**
+     * Creates an empty projection, it keeps an empty root object.
+     */
+    JsonProjection();
+
+    /**
+     * Creates a projection from JSON pointers.
+     * @throw invalid argument if a pointer is not valid.
+     * @param pointers Paths of the values to keep, "" keeps everything.
+     */
+    JsonProjection(std::initializer_list<JsonStringView> pointers);
+
+    /**
+     * Creates a projection from JSON pointers.
+     * @throw invalid argument if a pointer is not valid.
+     * @param pointers Paths of the values to keep, "" keeps everything.
+     */
+    explicit JsonProjection(const std::vector<std::string>& pointers);
+
+    /**
+     * Creates a projection from a nested object of keys, ex. {"file": true, "animations": {"name": true}}.
+     * True keeps the whole value of a key, an object keeps only its keys of the value.
+     * @throw invalid argument if a value is not true or an object.
+     * @param tree Parsed object of keys.
+     */
+    explicit JsonProjection(const JsonParser& tree);
+
+    /**
+     * Add a path to the projection.
+     * @throw invalid argument if the pointer is not valid.
+     * @param pointer Path of the value to keep, "" keeps everything.
+     * @return Reference to this projection.
+     */
+    JsonProjection& add(JsonStringView pointer);
+
+private:
+
+    static const uint32_t ALL = 0;              /**< Node that keeps everything*/
+    static const uint32_t NONE = UINT32_MAX;    /**< No node, the value is skipped*/
+
+    /**
+     * Key of an object in the mask.
+     */
+    struct Child {
+        std::string key;    /**< The key*/
+        size_t hash;        /**< JsonObject::hash(key)*/
+        uint32_t node;      /**< Mask of the value of the key*/
+    };
+
+    std::vector<std::vector<Child>> nodes;  /**< Keys of every node, nodes[ALL] is never used*/
+    uint32_t root;                          /**< Node of the root object*/
+
+    /**
+     * Get the child node of a key, creating it if it does not exist yet.
+     * @param node Parent node.
+     * @param key The key.
+     * @param hash JsonObject::hash(key).
+     * @return The child node, ALL if the parent or the child keeps everything.
+     */
+    uint32_t descend(uint32_t node, const std::string& key, size_t hash);
+
+    /**
+     * Keep the whole value of a key.
+     * @param node Parent node.
+     * @param key The key.
+     * @param hash JsonObject::hash(key).
+     */
+    void keep(uint32_t node, const std::string& key, size_t hash);
+
+    /**
+     * Add the keys of a nested object of keys.
+     * @param node Node of the object.
+     * @param tree The object of keys.
+     */
+    void addTree(uint32_t node, const JsonObject& tree);
+
+    /**
+     * Get the node of a member.
+     * @param node Node of the object.
+     * @param key Key of the member.
+     * @return Node of the value of the member, NONE if it is skipped.
+     */
+    uint32_t child(uint32_t node, JsonStringView key) const;
+
+    /**
+     * Check whether a value is read.
+     * @param node Node of the value.
+     * @param first First character of the value.
+     * @return True if the node keeps everything, or the value is an object or array the node can apply to.
+     */
+    static bool selects(uint32_t node, char first)
+    {
+        return node==ALL || (node!=NONE && (first=='{' || first=='['));
+    }
+
+    friend class JsonReader;
+};
+
+#endif //JSONPARSER_JSONPROJECTION_H
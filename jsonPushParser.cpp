@@ -0,0 +1,257 @@
+#include <algorithm>
+#include <cctype>
+#include "jsonPushParser.h"
+#include "jsonCursor.h"
+
+namespace {
+
+bool isClosing(char c)
+{
+    return c=='}' || c==']';
+}
+
+bool isScalarStart(char c)
+{
+    return c=='t' || c=='f' || c=='n' || c=='-' || isdigit(static_cast<unsigned char>(c));
+}
+
+}
+
+JsonPushParser::JsonPushParser(JsonHandler& handler)
+        :handler(handler), state(START), emptyValue(true), tokenEscaped(false), tokenLine(1), line(1)
+{
+
+}
+
+void JsonPushParser::reset()
+{
+    state = START;
+    emptyValue = true;
+    open.clear();
+    token.clear();
+    tokenEscaped = false;
+    tokenLine = 1;
+    line = 1;
+}
+
+void JsonPushParser::feed(const char* data, size_t length)
+{
+    const char* end = data+length;
+    JsonCursor cursor(data, length, line);
+
+    if (!token.empty()) {
+        // Continue the token that was cut off by the previous chunk
+        const char* found = tokenEnd(token[0], data, end);
+        token.append(data, found==nullptr ? end : found);
+        if (found==nullptr) {
+            line += static_cast<int>(std::count(data, end, '\n'));
+            return;
+        }
+        JsonCursor tokenCursor(token.data(), token.size(), tokenLine);
+        readToken(tokenCursor);
+        token.clear();
+        cursor.advance(static_cast<size_t>(found-data));
+    }
+
+    while (true) {
+        cursor.skipWhiteSpace();
+        if (cursor.atEnd())
+            break;
+        char current = cursor.peek();
+        bool isString = current=='"' || current=='\'';
+        if (!(state==KEY && isString) && !(state==VALUE && (isString || isScalarStart(current)))) {
+            step(cursor);
+            continue;
+        }
+
+        tokenEscaped = false;
+        if (tokenEnd(current, cursor.position()+1, end)==nullptr) {
+            // Keep the start of the token until the next chunk
+            tokenLine = cursor.line();
+            token.assign(cursor.position(), end);
+            break;
+        }
+        readToken(cursor);
+    }
+    line += static_cast<int>(std::count(data, end, '\n'));
+}
+
+void JsonPushParser::step(JsonCursor& cursor)
+{
+    char current = cursor.peek();
+    switch (state) {
+    case START:
+        if (!cursor.expectChar('{'))
+            throw cursor.error("Missing root '{'");
+        open.push_back('{');
+        handler.startObject();
+        state = KEY;
+        emptyValue = true;
+        return;
+    case COLON:
+        if (!cursor.expectChar(':'))
+            throw cursor.error("Missing ':' after \""+key+"\"");
+        state = VALUE;
+        return;
+    case NEXT:
+        if (current==(open.back()=='[' ? ']' : '}')) {
+            close(cursor);
+            return;
+        }
+        if (isClosing(current))
+            throw cursor.error("Unexpected token: '"+std::string(1, current)+"'");
+        if (!cursor.expectChar(','))
+            throw cursor.error("Missing ','");
+        state = open.back()=='{' ? KEY : VALUE;
+        emptyValue = false;
+        return;
+    case END:
+        throw cursor.error("Unexpected token: '"+std::string(1, current)+"'");
+    default:
+        break;
+    }
+
+    // A key or value that is not a token: the end of the current value, or the start of a new one
+    bool inArray = open.back()=='[';
+    bool afterColon = state==VALUE && !inArray;
+    if (!afterColon && current==(inArray ? ']' : '}')) {
+        if (!emptyValue)
+            throw ParseError(cursor.line(), "Expected new object after ','");
+        close(cursor);
+        return;
+    }
+    if (state==VALUE && (current=='{' || current=='[')) {
+        cursor.advance();
+        open.push_back(current);
+        if (current=='{')
+            handler.startObject();
+        else
+            handler.startArray();
+        state = current=='{' ? KEY : VALUE;
+        emptyValue = true;
+        return;
+    }
+    throw cursor.error("Unexpected token: '"+std::string(1, current)+"'");
+}
+
+void JsonPushParser::readToken(JsonCursor& cursor)
+{
+    char current = cursor.peek();
+    if (current=='"' || current=='\'') {
+        if (state==KEY) {
+            cursor.readQuotedString(key);
+            handler.key(key);
+            state = COLON;
+            return;
+        }
+        cursor.readQuotedString(scratch);
+        handler.string(scratch);
+        state = NEXT;
+        return;
+    }
+    if (state==KEY)
+        throw cursor.error("Unexpected token: '"+std::string(1, current)+"'");
+
+    switch (current) {
+    case 't':
+        if (cursor.expectLiteral("true", 4) && cursor.atValueEnd()) {
+            handler.boolean(true);
+            state = NEXT;
+            return;
+        }
+        break;
+    case 'f':
+        if (cursor.expectLiteral("false", 5) && cursor.atValueEnd()) {
+            handler.boolean(false);
+            state = NEXT;
+            return;
+        }
+        break;
+    case 'n':
+        if (cursor.expectLiteral("null", 4) && cursor.atValueEnd()) {
+            handler.null();
+            state = NEXT;
+            return;
+        }
+        break;
+    default:
+        if (isdigit(static_cast<unsigned char>(current)) || current=='-') {
+            JsonNumber number{};
+            cursor.readNumber(number);
+            handler.number(number);
+            state = NEXT;
+            return;
+        }
+        break;
+    }
+    throw cursor.error("Unexpected token: '"+std::string(1, cursor.peek())+"'");
+}
+
+void JsonPushParser::close(JsonCursor& cursor)
+{
+    cursor.advance();
+    bool inArray = open.back()=='[';
+    open.pop_back();
+    if (inArray)
+        handler.endArray();
+    else
+        handler.endObject();
+    state = open.empty() ? END : NEXT;
+}
+
+const char* JsonPushParser::tokenEnd(char first, const char* position, const char* end)
+{
+    if (first=='"' || first=='\'') {
+        for (; position<end; ++position) {
+            if (tokenEscaped) {
+                tokenEscaped = false;
+                continue;
+            }
+            char c = *position;
+            if (c=='\\')
+                tokenEscaped = true;
+            else if (c==first)
+                return position+1;
+            else if (c=='\n')
+                return position;
+        }
+        return nullptr;
+    }
+    for (; position<end; ++position) {
+        char c = *position;
+        if (c==' ' || c=='\t' || c=='\n' || c=='\r' || c==',' || isClosing(c))
+            return position;
+    }
+    return nullptr;
+}
+
+void JsonPushParser::finish()
+{
+    if (!token.empty()) {
+        // The end of the input ends numbers and literals, strings are missing their closing quote
+        std::string last;
+        last.swap(token);
+        JsonCursor tokenCursor(last.data(), last.size(), tokenLine);
+        readToken(tokenCursor);
+    }
+
+    switch (state) {
+    case END:
+        reset();
+        return;
+    case START:
+        throw ParseError(line, "Missing root '{'");
+    case COLON:
+        throw ParseError(line, "Missing ':' after \""+key+"\"");
+    case KEY:
+    case VALUE:
+        if (!emptyValue && !(state==VALUE && open.back()=='{'))
+            throw ParseError(line, "Expected new object after ','");
+        break;
+    default:
+        break;
+    }
+    if (open.back()=='[')
+        throw ParseError(line, "END OF FILE", "Unbalanced []");
+    throw ParseError(line, "END OF FILE", "Unbalanced {}");
+}
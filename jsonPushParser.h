@@ -0,0 +1,132 @@
+#ifndef JSONPARSER_JSONPUSHPARSER_H
+#define JSONPARSER_JSONPUSHPARSER_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include "jsonHandler.h"
+
+class JsonCursor;
+
+/**
+ * Resumable parser for json text that arrives in chunks, ex. from a socket.
+ * Every chunk is read as soon as it is fed and passed to a JsonHandler as events, a string, number or
+ * literal that is cut off by the end of a chunk is kept until its end arrives. The memory of the parser
+ * only depends on the nesting depth and the longest string, number or literal, not on the size of the input.
+ * The input and the errors are the same as those of JsonReader, the root must be an object.
+ * Line numbers count over all chunks, error messages show the rest of the line within the current chunk.
+ */
+class JsonPushParser {
+public:
+
+    /**
+     * Creates a parser at the start of a document.
+     * @param handler Receives the events, must stay alive as long as the parser.
+     */
+    explicit JsonPushParser(JsonHandler& handler);
+
+    /**
+     * Read the next chunk of the document.
+     * After a ParseError, the parser must be reset before it is used again.
+     * @throw ParseError if the text is not valid json.
+     * @param data Start of the chunk, the chunk is not used anymore after this call.
+     * @param length Amount of characters in the chunk.
+     */
+    void feed(const char* data, size_t length);
+
+    /**
+     * Read the next chunk of the document.
+     * @throw ParseError if the text is not valid json.
+     * @param chunk The chunk.
+     */
+    void feed(const std::string& chunk)
+    {
+        feed(chunk.data(), chunk.size());
+    }
+
+    /**
+     * End the document, the parser is ready for the next document afterwards.
+     * @throw ParseError if the document is not complete.
+     */
+    void finish();
+
+    /**
+     * Forget the current document and start a new one.
+     */
+    void reset();
+
+    /**
+     * Check whether a document has been started.
+     * @return True if the root object was opened and the document is not finished.
+     */
+    bool started() const
+    {
+        return state!=START;
+    }
+
+    /**
+     * Get the amount of characters of a cut off string, number or literal that are kept until its end arrives.
+     * @return Amount of kept characters.
+     */
+    size_t pendingBytes() const
+    {
+        return token.size();
+    }
+
+private:
+
+    /**
+     * What the parser expects next
+     */
+    enum State {
+        START,  /**< The root '{'*/
+        KEY,    /**< A key, or the end of the object right after its '{'*/
+        COLON,  /**< The ':' after a key*/
+        VALUE,  /**< A value, or the end of the array right after its '['*/
+        NEXT,   /**< A ',' or the end of the current object or array*/
+        END     /**< Nothing but whitespace, the root object is finished*/
+    };
+
+    JsonHandler& handler;   /**< Receives the events*/
+    State state;            /**< What the parser expects next*/
+    bool emptyValue;        /**< True right after '{' or '[', closing the value is allowed*/
+    std::vector<char> open; /**< '{' or '[' of every unfinished object and array*/
+    std::string key;        /**< Last key, stays valid until the next key event*/
+    std::string scratch;    /**< Reused buffer for the string value that is being read*/
+    std::string token;      /**< Start of a string, number or literal that was cut off by the end of a chunk*/
+    bool tokenEscaped;      /**< True if the next character of a cut off string is escaped*/
+    int tokenLine;          /**< Line where the cut off token starts*/
+    int line;               /**< Line of the first character of the next chunk*/
+
+    /**
+     * Handle the character at the cursor according to the state.
+     * @param cursor Cursor at a character that is not whitespace.
+     */
+    void step(JsonCursor& cursor);
+
+    /**
+     * Read a complete string, number or literal and pass it on.
+     * @throw ParseError if the token is not valid.
+     * @param cursor Cursor at the first character of the token.
+     */
+    void readToken(JsonCursor& cursor);
+
+    /**
+     * Close the innermost object or array.
+     * @param cursor Cursor at the closing character.
+     */
+    void close(JsonCursor& cursor);
+
+    /**
+     * Find the end of a token.
+     * Strings end after their closing quote or at a newline, numbers and literals at the first character
+     * that may follow a value.
+     * @param first First character of the token.
+     * @param position First character to look at.
+     * @param end End of the chunk.
+     * @return Pointer past the token, nullptr if the chunk ends first.
+     */
+    const char* tokenEnd(char first, const char* position, const char* end);
+};
+
+#endif //JSONPARSER_JSONPUSHPARSER_H
@@ -0,0 +1,757 @@
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include "jsonQuery.h"
+
+namespace {
+
+/**
+ * Order of an operand against a literal, stored in the mask before the operator is applied.
+ */
+enum Order : char {
+    UNORDERED,      /**< Unequal and not comparable, ex. of a different type or missing*/
+    ORDER_LESS,
+    ORDER_EQUAL,
+    ORDER_GREATER
+};
+
+/**
+ * Get the order of two values.
+ * @param a First value.
+ * @param b Second value.
+ * @return Order of a against b.
+ */
+template<class T>
+Order order(const T& a, const T& b)
+{
+    return a<b ? ORDER_LESS : (b<a ? ORDER_GREATER : ORDER_EQUAL);
+}
+
+/**
+ * Compare a number value with a literal number, integers are compared exactly.
+ * @param value The number value.
+ * @param number The literal.
+ * @return Order of the value against the literal.
+ */
+Order compareNumber(const JsonValue& value, const JsonNumber& number)
+{
+    if (!value.isInteger() || number.kind==JsonNumber::DOUBLE)
+        return order(value.getNumberValue(), number.toDouble());
+    // A negative integer is always smaller than a non-negative one
+    bool negative = value.getNumberValue()<0;
+    bool literalNegative = number.kind==JsonNumber::INT && number.int_value<0;
+    if (negative!=literalNegative)
+        return negative ? ORDER_LESS : ORDER_GREATER;
+    if (negative)
+        return order(value.getInt64Value(), number.int_value);
+    uint64_t literal = number.kind==JsonNumber::INT ? static_cast<uint64_t>(number.int_value) : number.uint_value;
+    return order(value.getUInt64Value(), literal);
+}
+
+/**
+ * Check whether a character can be part of a key in dot notation.
+ * @param c The character.
+ * @return True for letters, digits, '_', '-' and all bytes of UTF-8 sequences.
+ */
+bool isNameCharacter(char c)
+{
+    auto byte = static_cast<unsigned char>(c);
+    return (byte>='a' && byte<='z') || (byte>='A' && byte<='Z') || (byte>='0' && byte<='9') || byte=='_'
+           || byte=='-' || byte>=0x80;
+}
+
+}
+
+/**
+ * Compiles the text of a query into steps and filter expressions.
+ * Filters are parsed with recursive descent, || binds weaker than && and ! binds strongest.
+ */
+class JsonQuery::Compiler {
+public:
+
+    /**
+     * Creates a compiler.
+     * @param query Query that receives the steps, its text is compiled.
+     */
+    explicit Compiler(JsonQuery& query)
+            :query(query), text(query.query), position(0)
+    {
+    }
+
+    /**
+     * Compile the whole text.
+     * @throw invalid argument if the query is not valid.
+     */
+    void compile()
+    {
+        expect('$');
+        while (position<text.size()) {
+            if (consume('.')) {
+                if (consume('.')) {
+                    if (peek()=='[')
+                        bracket(true);
+                    else if (consume('*'))
+                        addStep(WILDCARD, true);
+                    else
+                        addChild(name(), true);
+                }
+                else if (consume('*')) {
+                    addStep(WILDCARD, false);
+                }
+                else {
+                    addChild(name(), false);
+                }
+            }
+            else if (peek()=='[') {
+                bracket(false);
+            }
+            else {
+                fail("expected '.' or '['");
+            }
+        }
+    }
+
+private:
+    JsonQuery& query;           /**< Query that receives the steps*/
+    const std::string& text;    /**< Text of the query*/
+    size_t position;            /**< Position of the next character*/
+
+    /**
+     * Throw an error for the current position.
+     * @throw invalid argument always.
+     * @param what What is wrong.
+     */
+    [[noreturn]] void fail(const std::string& what) const
+    {
+        throw std::invalid_argument("Invalid query '"+text+"' at position "+std::to_string(position)+": "+what);
+    }
+
+    char peek() const
+    {
+        return position<text.size() ? text[position] : '\0';
+    }
+
+    bool consume(char c)
+    {
+        if (peek()!=c)
+            return false;
+        position++;
+        return true;
+    }
+
+    bool consume(const char* word)
+    {
+        size_t length = strlen(word);
+        if (text.compare(position, length, word)!=0)
+            return false;
+        position += length;
+        return true;
+    }
+
+    void expect(char c)
+    {
+        if (!consume(c))
+            fail(std::string("expected '")+c+"'");
+    }
+
+    void skipSpaces()
+    {
+        while (peek()==' ')
+            position++;
+    }
+
+    void addStep(StepKind kind, bool descendants)
+    {
+        Step step{};
+        step.kind = kind;
+        step.descendants = descendants;
+        query.steps.push_back(std::move(step));
+    }
+
+    void addChild(std::string key, bool descendants)
+    {
+        addStep(CHILD, descendants);
+        Step& step = query.steps.back();
+        step.hash = JsonObject::hash(key);
+        step.key = std::move(key);
+    }
+
+    /**
+     * Parse a key in dot notation.
+     * @return The key.
+     */
+    std::string name()
+    {
+        size_t begin = position;
+        while (isNameCharacter(peek()))
+            position++;
+        if (position==begin)
+            fail("expected a key");
+        return text.substr(begin, position-begin);
+    }
+
+    /**
+     * Parse a string between single or double quotes, with the escape sequences \\, \', \", \/, \b, \f, \n, \r
+     * and \t.
+     * @return The string.
+     */
+    std::string quoted()
+    {
+        char quote = peek();
+        position++;
+        std::string result;
+        while (position<text.size() && text[position]!=quote) {
+            char c = text[position++];
+            if (c=='\\') {
+                switch (peek()) {
+                case '\\': case '\'': case '"': case '/': c = peek(); break;
+                case 'b': c = '\b'; break;
+                case 'f': c = '\f'; break;
+                case 'n': c = '\n'; break;
+                case 'r': c = '\r'; break;
+                case 't': c = '\t'; break;
+                default: fail("invalid escape sequence");
+                }
+                position++;
+            }
+            result += c;
+        }
+        expect(quote);
+        return result;
+    }
+
+    /**
+     * Parse an integer of at most 18 digits.
+     * @param allowNegative True if the integer may have a '-'.
+     * @return The integer.
+     */
+    long long integer(bool allowNegative)
+    {
+        bool negative = allowNegative && consume('-');
+        size_t begin = position;
+        long long result = 0;
+        while (peek()>='0' && peek()<='9' && position-begin<18)
+            result = result*10+(text[position++]-'0');
+        if (position==begin)
+            fail("expected an index");
+        if (peek()>='0' && peek()<='9')
+            fail("index out of range");
+        return negative ? -result : result;
+    }
+
+    /**
+     * Parse a selector between brackets.
+     * @param descendants True if the selector follows "..".
+     */
+    void bracket(bool descendants)
+    {
+        expect('[');
+        skipSpaces();
+        char c = peek();
+        if (c=='\'' || c=='"') {
+            addChild(quoted(), descendants);
+        }
+        else if (consume('*')) {
+            addStep(WILDCARD, descendants);
+        }
+        else if (consume('?')) {
+            skipSpaces();
+            size_t filter = disjunction();
+            addStep(FILTER, descendants);
+            query.steps.back().filter = filter;
+        }
+        else {
+            long long index = integer(true);
+            addStep(INDEX, descendants);
+            query.steps.back().index = index;
+        }
+        skipSpaces();
+        expect(']');
+    }
+
+    size_t add(Expression expression)
+    {
+        query.expressions.push_back(std::move(expression));
+        return query.expressions.size()-1;
+    }
+
+    size_t combine(ExpressionKind kind, size_t left, size_t right)
+    {
+        Expression expression(kind);
+        expression.left = left;
+        expression.right = right;
+        return add(std::move(expression));
+    }
+
+    size_t disjunction()
+    {
+        size_t left = conjunction();
+        while (consume("||")) {
+            skipSpaces();
+            left = combine(OR, left, conjunction());
+        }
+        return left;
+    }
+
+    size_t conjunction()
+    {
+        size_t left = unary();
+        while (consume("&&")) {
+            skipSpaces();
+            left = combine(AND, left, unary());
+        }
+        return left;
+    }
+
+    size_t unary()
+    {
+        if (consume('!')) {
+            skipSpaces();
+            return combine(NOT, unary(), 0);
+        }
+        size_t result;
+        if (consume('(')) {
+            skipSpaces();
+            result = disjunction();
+            expect(')');
+        }
+        else {
+            result = comparison();
+        }
+        skipSpaces();
+        return result;
+    }
+
+    /**
+     * Parse a path alone, or a comparison of a path with a literal in any order.
+     * @return The expression.
+     */
+    size_t comparison()
+    {
+        if (peek()=='@') {
+            Expression expression(EXISTS);
+            expression.path = path();
+            skipSpaces();
+            if (!comparisonOperator(expression.op, false))
+                return add(std::move(expression));
+            expression.kind = COMPARE;
+            skipSpaces();
+            literal(expression);
+            return add(std::move(expression));
+        }
+        Expression expression(COMPARE);
+        literal(expression);
+        skipSpaces();
+        if (!comparisonOperator(expression.op, true))
+            fail("expected a comparison operator");
+        skipSpaces();
+        if (peek()!='@')
+            fail("expected a path starting with '@'");
+        expression.path = path();
+        return add(std::move(expression));
+    }
+
+    /**
+     * Parse a path relative to the element, translated to a JSON pointer.
+     * @return The pointer.
+     */
+    JsonPointer path()
+    {
+        expect('@');
+        std::string pointer;
+        while (true) {
+            std::string key;
+            if (consume('.')) {
+                key = name();
+            }
+            else if (peek()=='[') {
+                position++;
+                skipSpaces();
+                if (peek()=='\'' || peek()=='"')
+                    key = quoted();
+                else
+                    key = std::to_string(integer(false));
+                skipSpaces();
+                expect(']');
+            }
+            else {
+                break;
+            }
+            pointer += '/';
+            for (char c : key) {
+                if (c=='~')
+                    pointer += "~0";
+                else if (c=='/')
+                    pointer += "~1";
+                else
+                    pointer += c;
+            }
+        }
+        return JsonPointer(pointer);
+    }
+
+    /**
+     * Parse a comparison operator.
+     * @param op Receives the operator.
+     * @param swapped True if the literal is on the left, the operator is turned around.
+     * @return False if there is no operator.
+     */
+    bool comparisonOperator(Operator& op, bool swapped)
+    {
+        if (consume("=="))
+            op = EQUAL;
+        else if (consume("!="))
+            op = NOT_EQUAL;
+        else if (consume("<="))
+            op = swapped ? GREATER_EQUAL : LESS_EQUAL;
+        else if (consume(">="))
+            op = swapped ? LESS_EQUAL : GREATER_EQUAL;
+        else if (consume('<'))
+            op = swapped ? GREATER : LESS;
+        else if (consume('>'))
+            op = swapped ? LESS : GREATER;
+        else
+            return false;
+        return true;
+    }
+
+    /**
+     * Parse a number, string, true, false or null.
+     * @param expression Receives the literal.
+     */
+    void literal(Expression& expression)
+    {
+        char c = peek();
+        if (c=='\'' || c=='"') {
+            expression.literalType = LITERAL_STRING;
+            expression.string = quoted();
+        }
+        else if (c=='-' || (c>='0' && c<='9')) {
+            const char* begin = text.data()+position;
+            const char* end = JsonNumber::parse(begin, text.data()+text.size(), expression.number);
+            if (end==nullptr)
+                fail("invalid number");
+            expression.literalType = LITERAL_NUMBER;
+            position += static_cast<size_t>(end-begin);
+        }
+        else if (consume("true")) {
+            expression.literalType = LITERAL_BOOL;
+            expression.boolean = true;
+        }
+        else if (consume("false")) {
+            expression.literalType = LITERAL_BOOL;
+            expression.boolean = false;
+        }
+        else if (consume("null")) {
+            expression.literalType = LITERAL_NULL;
+        }
+        else {
+            fail("expected a literal");
+        }
+        if (isNameCharacter(peek()))
+            fail("expected a literal");
+    }
+};
+
+const size_t JsonQuery::BATCH_SIZE;
+
+JsonQuery::JsonQuery(JsonStringView query)
+        :query(query)
+{
+    Compiler(*this).compile();
+}
+
+std::vector<const JsonValue*> JsonQuery::evaluate(const JsonValue& root) const
+{
+    if (steps.empty())
+        return {&root};
+    std::vector<JsonValue*> selected = selectFrom(root);
+    return std::vector<const JsonValue*>(selected.begin(), selected.end());
+}
+
+std::vector<JsonValue*> JsonQuery::evaluate(JsonValue& root) const
+{
+    if (steps.empty())
+        return {&root};
+    return selectFrom(root);
+}
+
+std::vector<const JsonValue*> JsonQuery::evaluate(const JsonParser& parser) const
+{
+    if (parser.root==nullptr)
+        return {};
+    std::vector<JsonValue*> selected = selectFrom(*parser.root);
+    return std::vector<const JsonValue*>(selected.begin(), selected.end());
+}
+
+std::vector<JsonValue*> JsonQuery::evaluate(JsonParser& parser) const
+{
+    if (parser.root==nullptr)
+        return {};
+    return selectFrom(*parser.root);
+}
+
+std::vector<const JsonValue*> JsonQuery::evaluate(const JsonObject& root) const
+{
+    std::vector<JsonValue*> selected = selectFrom(root);
+    return std::vector<const JsonValue*>(selected.begin(), selected.end());
+}
+
+std::vector<JsonValue*> JsonQuery::evaluate(JsonObject& root) const
+{
+    return selectFrom(root);
+}
+
+std::vector<JsonValue*> JsonQuery::selectFrom(const JsonValue& root) const
+{
+    std::vector<JsonValue*> current;
+    if (root.isObject())
+        selectFirst(steps[0], root.getObjectValue(), current);
+    else if (root.isArray())
+        selectFirst(steps[0], root.getArrayValue(), current);
+    run(1, current);
+    return current;
+}
+
+std::vector<JsonValue*> JsonQuery::selectFrom(const JsonObject& root) const
+{
+    std::vector<JsonValue*> current;
+    if (steps.empty())
+        return current;
+    selectFirst(steps[0], root, current);
+    run(1, current);
+    return current;
+}
+
+void JsonQuery::selectFirst(const Step& step, const JsonObject& object, std::vector<JsonValue*>& results) const
+{
+    select(step, object, results);
+    if (step.descendants) {
+        for (const auto& member : object)
+            selectNested(step, member.second, results);
+    }
+}
+
+void JsonQuery::selectFirst(const Step& step, const JsonArray& array, std::vector<JsonValue*>& results) const
+{
+    select(step, array, results);
+    if (step.descendants) {
+        for (JsonValue* element : array)
+            selectNested(step, element, results);
+    }
+}
+
+void JsonQuery::run(size_t first, std::vector<JsonValue*>& current) const
+{
+    std::vector<JsonValue*> next;
+    for (size_t i = first; i<steps.size() && !current.empty(); i++) {
+        const Step& step = steps[i];
+        next.clear();
+        for (JsonValue* value : current) {
+            if (step.descendants)
+                selectNested(step, value, next);
+            else
+                select(step, value, next);
+        }
+        current.swap(next);
+    }
+}
+
+void JsonQuery::select(const Step& step, JsonValue* value, std::vector<JsonValue*>& results) const
+{
+    if (value->isObject())
+        select(step, value->getObjectValue(), results);
+    else if (value->isArray())
+        select(step, value->getArrayValue(), results);
+}
+
+void JsonQuery::select(const Step& step, const JsonObject& object, std::vector<JsonValue*>& results) const
+{
+    switch (step.kind) {
+    case CHILD: {
+        auto found = object.find(step.key, step.hash);
+        if (found!=object.end())
+            results.push_back(found->second);
+        break;
+    }
+    case WILDCARD:
+        for (const auto& member : object)
+            results.push_back(member.second);
+        break;
+    case FILTER: {
+        std::vector<JsonValue*> candidates;
+        candidates.reserve(object.size());
+        for (const auto& member : object)
+            candidates.push_back(member.second);
+        filter(step.filter, candidates.data(), candidates.size(), results);
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+void JsonQuery::select(const Step& step, const JsonArray& array, std::vector<JsonValue*>& results) const
+{
+    switch (step.kind) {
+    case INDEX: {
+        long long index = step.index<0 ? static_cast<long long>(array.size())+step.index : step.index;
+        if (index>=0 && static_cast<size_t>(index)<array.size())
+            results.push_back(array[static_cast<size_t>(index)]);
+        break;
+    }
+    case WILDCARD:
+        results.insert(results.end(), array.begin(), array.end());
+        break;
+    case FILTER:
+        filter(step.filter, array.data(), array.size(), results);
+        break;
+    default:
+        break;
+    }
+}
+
+void JsonQuery::selectNested(const Step& step, JsonValue* value, std::vector<JsonValue*>& results) const
+{
+    select(step, value, results);
+    if (value->isObject()) {
+        for (const auto& member : value->getObjectValue())
+            selectNested(step, member.second, results);
+    }
+    else if (value->isArray()) {
+        for (JsonValue* element : value->getArrayValue())
+            selectNested(step, element, results);
+    }
+}
+
+void JsonQuery::filter(size_t filter, JsonValue* const* candidates, size_t count,
+                       std::vector<JsonValue*>& results) const
+{
+    // Batches are small enough that the elements are still in the cache for every comparison of the filter
+    std::vector<char> mask;
+    for (size_t begin = 0; begin<count; begin += BATCH_SIZE) {
+        size_t size = std::min(count-begin, BATCH_SIZE);
+        evaluate(filter, candidates+begin, size, mask);
+        for (size_t i = 0; i<size; i++) {
+            if (mask[i])
+                results.push_back(candidates[begin+i]);
+        }
+    }
+}
+
+void JsonQuery::evaluate(size_t expression, JsonValue* const* candidates, size_t count, std::vector<char>& mask) const
+{
+    const Expression& node = expressions[expression];
+    mask.resize(count);
+    switch (node.kind) {
+    case COMPARE:
+    case EXISTS: {
+        std::vector<JsonValue*> operands(count);
+        for (size_t i = 0; i<count; i++)
+            operands[i] = node.path.resolve(*candidates[i]);
+        if (node.kind==COMPARE) {
+            compare(node, operands, mask);
+            break;
+        }
+        for (size_t i = 0; i<count; i++)
+            mask[i] = operands[i]!=nullptr;
+        break;
+    }
+    case AND:
+    case OR: {
+        // The right operand is only evaluated for the candidates the left one does not decide
+        evaluate(node.left, candidates, count, mask);
+        const char undecided = node.kind==AND ? 1 : 0;
+        std::vector<JsonValue*> remaining;
+        std::vector<size_t> positions;
+        remaining.reserve(count);
+        positions.reserve(count);
+        for (size_t i = 0; i<count; i++) {
+            if (mask[i]==undecided) {
+                remaining.push_back(candidates[i]);
+                positions.push_back(i);
+            }
+        }
+        if (remaining.empty())
+            break;
+        std::vector<char> right;
+        evaluate(node.right, remaining.data(), remaining.size(), right);
+        for (size_t i = 0; i<remaining.size(); i++)
+            mask[positions[i]] = right[i];
+        break;
+    }
+    case NOT:
+        evaluate(node.left, candidates, count, mask);
+        for (size_t i = 0; i<count; i++)
+            mask[i] ^= 1;
+        break;
+    }
+}
+
+void JsonQuery::compare(const Expression& expression, const std::vector<JsonValue*>& operands,
+                        std::vector<char>& mask)
+{
+    // First the order of every operand against the literal, one loop per type of literal
+    const size_t count = operands.size();
+    switch (expression.literalType) {
+    case LITERAL_NUMBER:
+        for (size_t i = 0; i<count; i++) {
+            const JsonValue* value = operands[i];
+            mask[i] = value!=nullptr && value->isNumber() ? compareNumber(*value, expression.number) : UNORDERED;
+        }
+        break;
+    case LITERAL_STRING: {
+        JsonStringView literal(expression.string);
+        for (size_t i = 0; i<count; i++) {
+            const JsonValue* value = operands[i];
+            if (value==nullptr || !value->isString()) {
+                mask[i] = UNORDERED;
+                continue;
+            }
+            mask[i] = order(value->getStringView().compare(literal), 0);
+        }
+        break;
+    }
+    case LITERAL_BOOL:
+        // Numbers 0 and 1 are bools as well, so they are excluded
+        for (size_t i = 0; i<count; i++) {
+            const JsonValue* value = operands[i];
+            bool equal = value!=nullptr && value->isBool() && !value->isNumber()
+                         && value->getBoolValue()==expression.boolean;
+            mask[i] = equal ? ORDER_EQUAL : UNORDERED;
+        }
+        break;
+    case LITERAL_NULL:
+        for (size_t i = 0; i<count; i++)
+            mask[i] = operands[i]!=nullptr && operands[i]->isNull() ? ORDER_EQUAL : UNORDERED;
+        break;
+    }
+
+    // Then the operator, one loop over all orders
+    switch (expression.op) {
+    case EQUAL:
+        for (size_t i = 0; i<count; i++)
+            mask[i] = mask[i]==ORDER_EQUAL;
+        break;
+    case NOT_EQUAL:
+        for (size_t i = 0; i<count; i++)
+            mask[i] = mask[i]!=ORDER_EQUAL;
+        break;
+    case LESS:
+        for (size_t i = 0; i<count; i++)
+            mask[i] = mask[i]==ORDER_LESS;
+        break;
+    case LESS_EQUAL:
+        for (size_t i = 0; i<count; i++)
+            mask[i] = mask[i]==ORDER_LESS || mask[i]==ORDER_EQUAL;
+        break;
+    case GREATER:
+        for (size_t i = 0; i<count; i++)
+            mask[i] = mask[i]==ORDER_GREATER;
+        break;
+    case GREATER_EQUAL:
+        for (size_t i = 0; i<count; i++)
+            mask[i] = mask[i]==ORDER_EQUAL || mask[i]==ORDER_GREATER;
+        break;
+    }
+}
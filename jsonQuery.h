@@ -0,0 +1,281 @@
+#ifndef JSONPARSER_JSONQUERY_H
+#define JSONPARSER_JSONQUERY_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include "jsonParser.h"
+#include "jsonPointer.h"
+
+/**
+ * Query that selects values from a document with a subset of JSONPath, ex. "$.animations[?(@.loop == true)].name".
+ * Supported are:
+ * - $                  the root, every query starts with it
+ * - .key ['key']       a member of an object
+ * - [2] [-1]           an element of an array, negative indices count from the end
+ * - .* [*]             all members or elements
+ * - ..key ..[...]      the selector after the .. applied to the value and all values nested in it
+ * - [?(filter)]        the members or elements for which a filter is true. Filters compare a path relative to
+ *                      the element (@, @.key, @['key'], @[0]) with a number, 'string', "string", true, false
+ *                      or null using == != < <= > >=, a path alone checks that it exists. They are combined with
+ *                      &&, || and ! and grouped with parentheses.
+ * The query is compiled once. Filters are evaluated for a batch of elements of an array at once: every
+ * comparison is one loop over the batch, instead of walking the filter for every element. The right operand
+ * of && and || is only evaluated for the elements the left operand does not decide.
+ * Values that do not exist compare unequal to everything, < <= > >= only compare numbers with numbers and
+ * strings with strings.
+ */
+class JsonQuery {
+public:
+
+    /**
+     * Compiles a query.
+     * @throw invalid argument if the query is not valid.
+     * @param query The query.
+     */
+    explicit JsonQuery(JsonStringView query);
+
+    /**
+     * Select the values of the query.
+     * @param root Value the query starts from, the $.
+     * @return The selected values, in the order of the document.
+     */
+    std::vector<const JsonValue*> evaluate(const JsonValue& root) const;
+
+    /**
+     * Select the values of the query, the values can be changed.
+     * @param root Value the query starts from, the $.
+     * @return The selected values, in the order of the document.
+     */
+    std::vector<JsonValue*> evaluate(JsonValue& root) const;
+
+    /**
+     * Select the values of the query, starting from the root object of a parser.
+     * @param parser Parser with the root object, the $.
+     * @return The selected values, in the order of the document. "$" itself selects nothing, the root object
+     * is not a JsonValue.
+     */
+    std::vector<const JsonValue*> evaluate(const JsonParser& parser) const;
+
+    /**
+     * Select the values of the query, starting from the root object of a parser, the values can be changed.
+     * @param parser Parser with the root object, the $.
+     * @return The selected values, in the order of the document. "$" itself selects nothing.
+     */
+    std::vector<JsonValue*> evaluate(JsonParser& parser) const;
+
+    /**
+     * Select the values of the query, starting from a root object, ex. of a JsonFrozenDocument.
+     * @param root Object the query starts from, the $.
+     * @return The selected values, in the order of the document. "$" itself selects nothing.
+     */
+    std::vector<const JsonValue*> evaluate(const JsonObject& root) const;
+
+    /**
+     * Select the values of the query, starting from a root object, the values can be changed.
+     * @param root Object the query starts from, the $.
+     * @return The selected values, in the order of the document. "$" itself selects nothing.
+     */
+    std::vector<JsonValue*> evaluate(JsonObject& root) const;
+
+    /**
+     * Get the query as it was compiled.
+     * @return The query.
+     */
+    const std::string& str() const
+    {
+        return query;
+    }
+
+private:
+
+    static const size_t BATCH_SIZE = 1024;  /**< Most elements a filter is evaluated for at once*/
+
+    /**
+     * What a step selects.
+     */
+    enum StepKind {
+        CHILD,      /**< The member with a key*/
+        INDEX,      /**< The element at an index*/
+        WILDCARD,   /**< All members or elements*/
+        FILTER      /**< The members or elements for which a filter is true*/
+    };
+
+    /**
+     * One selector of the query.
+     */
+    struct Step {
+        StepKind kind;      /**< What the step selects*/
+        bool descendants;   /**< True if the step applies to the value and all values nested in it*/
+        std::string key;    /**< Key of a CHILD step*/
+        size_t hash;        /**< JsonObject::hash(key)*/
+        long long index;    /**< Index of an INDEX step*/
+        size_t filter;      /**< Root expression of a FILTER step*/
+    };
+
+    /**
+     * Kind of a node of a filter expression.
+     */
+    enum ExpressionKind {
+        COMPARE,    /**< Compare a path with a literal*/
+        EXISTS,     /**< Check that a path exists*/
+        AND,
+        OR,
+        NOT
+    };
+
+    /**
+     * Comparison operators.
+     */
+    enum Operator {
+        EQUAL,
+        NOT_EQUAL,
+        LESS,
+        LESS_EQUAL,
+        GREATER,
+        GREATER_EQUAL
+    };
+
+    /**
+     * Type of the literal of a comparison.
+     */
+    enum LiteralType {
+        LITERAL_NUMBER,
+        LITERAL_STRING,
+        LITERAL_BOOL,
+        LITERAL_NULL
+    };
+
+    /**
+     * Node of a filter expression.
+     */
+    struct Expression {
+        ExpressionKind kind;        /**< Kind of the node*/
+        size_t left;                /**< First operand of AND, OR and NOT*/
+        size_t right;               /**< Second operand of AND and OR*/
+        JsonPointer path;           /**< Path relative to the element for COMPARE and EXISTS*/
+        Operator op;                /**< Operator of COMPARE*/
+        LiteralType literalType;    /**< Type of the literal of COMPARE*/
+        JsonNumber number;          /**< Literal number*/
+        std::string string;         /**< Literal string*/
+        bool boolean;               /**< Literal bool*/
+
+        /**
+         * Creates a node without operands.
+         * @param kind Kind of the node.
+         */
+        explicit Expression(ExpressionKind kind)
+                :kind(kind), left(0), right(0), path(""), op(EQUAL), literalType(LITERAL_NULL), number(),
+                 boolean(false)
+        {
+        }
+    };
+
+    std::string query;                  /**< The query as it was compiled*/
+    std::vector<Step> steps;            /**< Selectors in order*/
+    std::vector<Expression> expressions;    /**< Nodes of all filters*/
+
+    class Compiler;
+
+    /**
+     * Apply all steps to the values nested in a root value, there must be at least one step.
+     * The containers hold their values as JsonValue*, the public overloads give the results the constness of
+     * their root.
+     * @param root Value the query starts from.
+     * @return The selected values.
+     */
+    std::vector<JsonValue*> selectFrom(const JsonValue& root) const;
+
+    /**
+     * Apply all steps to the members of a root object.
+     * @param root Object the query starts from.
+     * @return The selected values, none if there are no steps.
+     */
+    std::vector<JsonValue*> selectFrom(const JsonObject& root) const;
+
+    /**
+     * Apply the first step to the members of the root object, and to all values nested in them if the step
+     * selects descendants.
+     * @param step The first step.
+     * @param object The root object.
+     * @param results Receives the selected values.
+     */
+    void selectFirst(const Step& step, const JsonObject& object, std::vector<JsonValue*>& results) const;
+
+    /**
+     * Apply the first step to the elements of the root array, and to all values nested in them if the step
+     * selects descendants.
+     * @param step The first step.
+     * @param array The root array.
+     * @param results Receives the selected values.
+     */
+    void selectFirst(const Step& step, const JsonArray& array, std::vector<JsonValue*>& results) const;
+
+    /**
+     * Apply a step to a value.
+     * @param step The step.
+     * @param value Value to select from.
+     * @param results Receives the selected values.
+     */
+    void select(const Step& step, JsonValue* value, std::vector<JsonValue*>& results) const;
+
+    /**
+     * Apply a step to an object.
+     * @param step The step.
+     * @param object Object to select from.
+     * @param results Receives the selected values.
+     */
+    void select(const Step& step, const JsonObject& object, std::vector<JsonValue*>& results) const;
+
+    /**
+     * Apply a step to an array.
+     * @param step The step.
+     * @param array Array to select from.
+     * @param results Receives the selected values.
+     */
+    void select(const Step& step, const JsonArray& array, std::vector<JsonValue*>& results) const;
+
+    /**
+     * Apply a step to a value and all values nested in it, in the order of the document.
+     * @param step The step.
+     * @param value The value.
+     * @param results Receives the selected values.
+     */
+    void selectNested(const Step& step, JsonValue* value, std::vector<JsonValue*>& results) const;
+
+    /**
+     * Apply the remaining steps to a set of values.
+     * @param first First step to apply.
+     * @param current The values, replaced by the selected values.
+     */
+    void run(size_t first, std::vector<JsonValue*>& current) const;
+
+    /**
+     * Keep the candidates for which a filter is true.
+     * @param filter Root expression of the filter.
+     * @param candidates Elements or member values to filter.
+     * @param count Amount of candidates.
+     * @param results Receives the candidates for which the filter is true.
+     */
+    void filter(size_t filter, JsonValue* const* candidates, size_t count, std::vector<JsonValue*>& results) const;
+
+    /**
+     * Evaluate an expression for all candidates at once.
+     * @param expression The expression.
+     * @param candidates The candidates.
+     * @param count Amount of candidates.
+     * @param mask Receives 1 for every candidate for which the expression is true, else 0.
+     */
+    void evaluate(size_t expression, JsonValue* const* candidates, size_t count, std::vector<char>& mask) const;
+
+    /**
+     * Compare values with the literal of a COMPARE expression, all at once.
+     * @param expression The COMPARE expression.
+     * @param operands Values to compare, nullptr for values that do not exist.
+     * @param mask Receives 1 for every operand for which the comparison is true, else 0.
+     */
+    static void compare(const Expression& expression, const std::vector<JsonValue*>& operands,
+                        std::vector<char>& mask);
+};
+
+#endif //JSONPARSER_JSONQUERY_H
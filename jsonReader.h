@@ -0,0 +1,312 @@
+#ifndef JSONPARSER_JSONREADER_H
+#define JSONPARSER_JSONREADER_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cctype>
+#include "jsonHandler.h"
+#include "jsonCursor.h"
+#include "jsonProjection.h"
+#include "mappedFile.h"
+
+/**
+ * Tokenizer that reads json text and passes every value to a handler as events.
+ * The reader does not build anything itself, its memory only depends on the nesting depth and the
+ * longest string. JsonParser and JsonTape are handlers of this reader, so all of them accept
+ * the same json syntax and report the same ParseErrors. What a handler does with valid text is up to it:
+ * JsonParser rejects duplicate keys with an invalid argument error, JsonTape keeps them.
+ * The handler is a template parameter: a JsonHandler reference dispatches the events virtually, a concrete
+ * handler type has its events inlined into the tokenizer loop.
+ * A reader can be reused, its buffers are kept between parses.
+ */
+class JsonReader {
+public:
+
+    /**
+     * Reads a json file by memory mapping it.
+     * @throw invalid argument if the file can not be opened.
+     * @throw ParseError if the file is not valid json.
+     * @param file_name Path to input file.
+     * @param handler Receives the events.
+     */
+    template<class Handler>
+    void parse(const std::string& file_name, Handler& handler);
+
+    /**
+     * Reads json text from a buffer, the root must be an object.
+     * @throw ParseError if the text is not valid json.
+     * @param data Start of the json text, does not need to be null terminated.
+     * @param length Amount of characters in the buffer.
+     * @param handler Receives the events.
+     * @param firstLine Line of the first character in errors, for buffers that are a part of a larger text.
+     */
+    template<class Handler>
+    void parse(const char* data, size_t length, Handler& handler, int firstLine = 1);
+
+    /**
+     * Reads json text from a buffer, the root must be an object. Only the values of a projection are passed
+     * to the handler, all other values are skipped without validating them.
+     * @throw ParseError if the text is not valid json.
+     * @param data Start of the json text, does not need to be null terminated.
+     * @param length Amount of characters in the buffer.
+     * @param handler Receives the events of the values of the projection.
+     * @param projection Values to read, must stay alive during the call.
+     */
+    template<class Handler>
+    void parse(const char* data, size_t length, Handler& handler, const JsonProjection& projection);
+
+    /**
+     * Reads json text from a string.
+     * @throw ParseError if the text is not valid json.
+     * @param json String containing the json text.
+     * @param handler Receives the events.
+     */
+    template<class Handler>
+    void parseString(const std::string& json, Handler& handler);
+
+    /**
+     * Reads one complete value of any type at the cursor, the cursor is left after the value.
+     * @throw ParseError if there is no valid value at the cursor.
+     * @param cursor Cursor at the first character of the value.
+     * @param handler Receives the events.
+     */
+    template<class Handler>
+    void readValue(JsonCursor& cursor, Handler& handler);
+
+private:
+    std::vector<char> open;         /**< '{' or '[' of every unfinished object and array*/
+    std::string key;                /**< Reused buffer for the key that is being read*/
+    std::string scratch;            /**< Reused buffer for the string value that is being read*/
+    JsonStructuralIndex structuralIndex;    /**< Structural index of the input, reused between parses*/
+    const JsonProjection* projection = nullptr; /**< Projection of the last parse with a projection*/
+    std::vector<uint32_t> nodes;            /**< Projection node of every unfinished object and array*/
+    uint32_t nextNode = 0;                  /**< Projection node of the value that is read next*/
+
+    /**
+     * Reads json text from a buffer, the root must be an object.
+     * @throw ParseError if the text is not valid json.
+     * @param Projected True if only the values of the projection are read.
+     * @param data Start of the json text.
+     * @param length Amount of characters in the buffer.
+     * @param handler Receives the events.
+     * @param firstLine Line of the first character in errors.
+     */
+    template<bool Projected, class Handler>
+    void parseRoot(const char* data, size_t length, Handler& handler, int firstLine);
+
+    /**
+     * Read the members and elements of the unfinished objects and arrays until all of them are closed.
+     * @throw ParseError if the text is not valid json.
+     * @param Projected True if only the values of the projection are read.
+     * @param cursor Cursor after the '{' or '[' of the outermost value.
+     * @param handler Receives the events.
+     */
+    template<bool Projected, class Handler>
+    void readNested(JsonCursor& cursor, Handler& handler);
+
+    /**
+     * Read a value at the cursor. Objects and arrays are only started and pushed on the open stack.
+     * @throw ParseError if there is no valid value at the cursor.
+     * @param Projected True if the projection node of a started object or array is pushed as well.
+     * @param cursor Cursor positioned at the first character of the value.
+     * @param handler Receives the events.
+     * @return True if an object or array was started.
+     */
+    template<bool Projected, class Handler>
+    bool readScalarOrStart(JsonCursor& cursor, Handler& handler);
+
+    /**
+     * Find the projection node of the next value and check whether it is read.
+     * @param cursor Cursor at the first character of the value.
+     * @param inArray True if the value is an element of an array, false if it is the value of the current key.
+     * @return False if the value is skipped.
+     */
+    bool project(const JsonCursor& cursor, bool inArray)
+    {
+        uint32_t node = nodes.back();
+        nextNode = inArray || node==JsonProjection::ALL ? node : projection->child(node, key);
+        return JsonProjection::selects(nextNode, cursor.peek());
+    }
+};
+
+template<class Handler>
+void JsonReader::parse(const std::string& file_name, Handler& handler)
+{
+    MappedFile file(file_name);
+    parse(file.data(), file.size(), handler);
+}
+
+template<class Handler>
+void JsonReader::parseString(const std::string& json, Handler& handler)
+{
+    parse(json.data(), json.size(), handler);
+}
+
+template<class Handler>
+void JsonReader::parse(const char* data, size_t length, Handler& handler, int firstLine)
+{
+    parseRoot<false>(data, length, handler, firstLine);
+}
+
+template<class Handler>
+void JsonReader::parse(const char* data, size_t length, Handler& handler, const JsonProjection& projection)
+{
+    this->projection = &projection;
+    nodes.clear();
+    nodes.push_back(projection.root);
+    parseRoot<true>(data, length, handler, 1);
+}
+
+template<bool Projected, class Handler>
+void JsonReader::parseRoot(const char* data, size_t length, Handler& handler, int firstLine)
+{
+    JsonCursor cursor(data, length, firstLine);
+    if (structuralIndex.build(data, length))
+        cursor.useStructuralIndex(structuralIndex);
+    cursor.skipWhiteSpace();
+    if (!cursor.expectChar('{'))
+        throw cursor.error("Missing root '{'");
+
+    open.clear();
+    open.push_back('{');
+    handler.startObject();
+    readNested<Projected>(cursor, handler);
+
+    // Root object is finished, only whitespace may follow
+    cursor.skipWhiteSpace();
+    if (!cursor.atEnd())
+        throw cursor.error("Unexpected token: '"+std::string(1, cursor.peek())+"'");
+}
+
+template<class Handler>
+void JsonReader::readValue(JsonCursor& cursor, Handler& handler)
+{
+    open.clear();
+    if (readScalarOrStart<false>(cursor, handler))
+        readNested<false>(cursor, handler);
+}
+
+template<bool Projected, class Handler>
+void JsonReader::readNested(JsonCursor& cursor, Handler& handler)
+{
+    bool canCreateValue = true;
+    // True right after '{' or '[', closing the value is allowed even though canCreateValue is set
+    bool emptyValue = true;
+    while (true) {
+        cursor.skipWhiteSpace();
+        if (cursor.atEnd())
+            break;
+
+        char current = cursor.peek();
+        bool inArray = open.back()=='[';
+        if (current==(inArray ? ']' : '}')) {
+            if (canCreateValue && !emptyValue)
+                throw ParseError(cursor.line(), "Expected new object after ','");
+            cursor.advance();
+            open.pop_back();
+            if (Projected)
+                nodes.pop_back();
+            if (inArray)
+                handler.endArray();
+            else
+                handler.endObject();
+            if (open.empty())
+                return;
+        }
+        else {
+            if (current=='}' || current==']')
+                throw cursor.error("Unexpected token: '"+std::string(1, current)+"'");
+            if (!canCreateValue)
+                throw cursor.error("Missing ','");
+
+            if (!inArray) {
+                if (current!='"' && current!='\'')
+                    throw cursor.error("Unexpected token: '"+std::string(1, current)+"'");
+                cursor.readQuotedString(key);
+                cursor.skipWhiteSpace();
+                if (!cursor.expectChar(':'))
+                    throw cursor.error("Missing ':' after \""+key+"\"");
+                cursor.skipWhiteSpace();
+            }
+            if (Projected && !project(cursor, inArray)) {
+                cursor.skipValue();
+            }
+            else {
+                if (!inArray)
+                    handler.key(key);
+                if (readScalarOrStart<Projected>(cursor, handler)) {
+                    canCreateValue = true;
+                    emptyValue = true;
+                    continue;
+                }
+            }
+        }
+
+        cursor.skipWhiteSpace();
+        canCreateValue = cursor.expectChar(',');
+        emptyValue = false;
+    }
+
+    if (canCreateValue && !emptyValue)
+        throw ParseError(cursor.line(), "Expected new object after ','");
+    if (open.back()=='[')
+        throw ParseError(cursor.line(), "END OF FILE", "Unbalanced []");
+    throw ParseError(cursor.line(), "END OF FILE", "Unbalanced {}");
+}
+
+template<bool Projected, class Handler>
+bool JsonReader::readScalarOrStart(JsonCursor& cursor, Handler& handler)
+{
+    char current = cursor.peek();
+    switch (current) {
+    case '{':
+        cursor.advance();
+        open.push_back('{');
+        if (Projected)
+            nodes.push_back(nextNode);
+        handler.startObject();
+        return true;
+    case '[':
+        cursor.advance();
+        open.push_back('[');
+        if (Projected)
+            nodes.push_back(nextNode);
+        handler.startArray();
+        return true;
+    case '"':
+    case '\'':
+        cursor.readQuotedString(scratch);
+        handler.string(scratch);
+        return false;
+    case 't':
+        if (cursor.expectLiteral("true", 4) && cursor.atValueEnd()) {
+            handler.boolean(true);
+            return false;
+        }
+        break;
+    case 'f':
+        if (cursor.expectLiteral("false", 5) && cursor.atValueEnd()) {
+            handler.boolean(false);
+            return false;
+        }
+        break;
+    case 'n':
+        if (cursor.expectLiteral("null", 4) && cursor.atValueEnd()) {
+            handler.null();
+            return false;
+        }
+        break;
+    default:
+        if (isdigit(static_cast<unsigned char>(current)) || current=='-') {
+            JsonNumber number{};
+            cursor.readNumber(number);
+            handler.number(number);
+            return false;
+        }
+        break;
+    }
+    throw cursor.error("Unexpected token: '"+std::string(1, cursor.peek())+"'");
+}
+
+#endif //JSONPARSER_JSONREADER_H
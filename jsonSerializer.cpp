@@ -0,0 +1,169 @@
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include "jsonSerializer.h"
+#include "jsonWriter.h"
+
+const size_t JsonSerializer::BLOCK_SIZE;
+
+JsonSerializer::JsonSerializer(int indent)
+        :indent(std::max(0, indent)), used(0), fd(-1)
+{
+
+}
+
+JsonStringView JsonSerializer::serialize(const JsonValue& value)
+{
+    used = 0;
+    fd = -1;
+    writeValue(value, 0);
+    return JsonStringView(buffer.data(), used);
+}
+
+JsonStringView JsonSerializer::serialize(const JsonParser& parser)
+{
+    return serialize(rootOf(parser));
+}
+
+JsonStringView JsonSerializer::serialize(const JsonObject& object)
+{
+    used = 0;
+    fd = -1;
+    writeObject(object, 0);
+    return JsonStringView(buffer.data(), used);
+}
+
+void JsonSerializer::serialize(const JsonValue& value, int fd)
+{
+    used = 0;
+    this->fd = fd;
+    writeValue(value, 0);
+    flush();
+    this->fd = -1;
+}
+
+void JsonSerializer::serialize(const JsonParser& parser, int fd)
+{
+    const JsonObject& root = rootOf(parser);
+    used = 0;
+    this->fd = fd;
+    writeObject(root, 0);
+    flush();
+    this->fd = -1;
+}
+
+const JsonObject& JsonSerializer::rootOf(const JsonParser& parser)
+{
+    if (parser.root==nullptr)
+        throw std::invalid_argument("JsonParser is empty");
+    return *parser.root;
+}
+
+void JsonSerializer::grow(size_t length)
+{
+    if (fd>=0) {
+        flush();
+        if (buffer.size()<BLOCK_SIZE)
+            buffer.resize(BLOCK_SIZE);
+        if (length<=buffer.size())
+            return;
+    }
+    buffer.resize(std::max(buffer.size()*2, used+length));
+}
+
+void JsonSerializer::flush()
+{
+    size_t length = used;
+    used = 0;
+    try {
+        JsonWriter::writeAll(fd, buffer.data(), length);
+    }
+    catch (...) {
+        fd = -1;
+        throw;
+    }
+}
+
+void JsonSerializer::writeValue(const JsonValue& value, int depth)
+{
+    switch (value.type()) {
+    case JSON_NULL:
+        writeText("null", 4);
+        return;
+    case JSON_BOOL:
+        if (value.getBoolValue())
+            writeText("true", 4);
+        else
+            writeText("false", 5);
+        return;
+    case JSON_INT:
+        commit(JsonFormat::writeInt64(value.getInt64Value(), reserve(JsonFormat::MAX_NUMBER_LENGTH)));
+        return;
+    case JSON_UINT:
+        commit(JsonFormat::writeUInt64(value.getUInt64Value(), reserve(JsonFormat::MAX_NUMBER_LENGTH)));
+        return;
+    case JSON_NUM:
+        commit(JsonFormat::writeDouble(value.getNumberValue(), reserve(JsonFormat::MAX_NUMBER_LENGTH)));
+        return;
+    case JSON_STRING: {
+        JsonStringView string = value.getStringView();
+        commit(JsonFormat::writeString(string, reserve(JsonFormat::maxStringLength(string.size()))));
+        return;
+    }
+    case JSON_ARRAY:
+        writeArray(value.getArrayValue(), depth);
+        return;
+    case JSON_OBJ:
+        writeObject(value.getObjectValue(), depth);
+        return;
+    }
+}
+
+void JsonSerializer::writeObject(const JsonObject& object, int depth)
+{
+    writeChar('{');
+    bool first = true;
+    for (const auto& member : object) {
+        if (!first)
+            writeChar(',');
+        first = false;
+        writeNewLine(depth+1);
+        size_t length = JsonFormat::maxStringLength(member.first.size())+2;
+        char* position = JsonFormat::writeString(member.first, reserve(length));
+        *position++ = ':';
+        if (indent>0)
+            *position++ = ' ';
+        commit(position);
+        writeValue(*member.second, depth+1);
+    }
+    if (!first)
+        writeNewLine(depth);
+    writeChar('}');
+}
+
+void JsonSerializer::writeArray(const JsonArray& array, int depth)
+{
+    writeChar('[');
+    bool first = true;
+    for (const JsonValue* element : array) {
+        if (!first)
+            writeChar(',');
+        first = false;
+        writeNewLine(depth+1);
+        writeValue(*element, depth+1);
+    }
+    if (!first)
+        writeNewLine(depth);
+    writeChar(']');
+}
+
+void JsonSerializer::writeNewLine(int depth)
+{
+    if (indent==0)
+        return;
+    size_t spaces = static_cast<size_t>(indent)*static_cast<size_t>(depth);
+    char* position = reserve(spaces+1);
+    *position++ = '\n';
+    memset(position, ' ', spaces);
+    commit(position+spaces);
+}
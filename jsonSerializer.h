@@ -0,0 +1,154 @@
+#ifndef JSONPARSER_JSONSERIALIZER_H
+#define JSONPARSER_JSONSERIALIZER_H
+
+#include <string>
+#include <cstddef>
+#include <cstring>
+#include "jsonParser.h"
+#include "jsonFormat.h"
+
+/**
+ * Writes JsonValues back to json text, compact or indented.
+ * The text is built in a buffer that is reused by every call, so serializing many values with one serializer
+ * only allocates while the buffer grows. Text for a file descriptor is written in blocks of BLOCK_SIZE characters,
+ * so the buffer does not grow with the size of the value. Members of objects keep their order.
+ */
+class JsonSerializer {
+public:
+
+    static const size_t BLOCK_SIZE = 64*1024;   /**< Amount of characters that are written to a file descriptor at once*/
+
+    /**
+     * Creates a serializer.
+     * @param indent Amount of spaces per level of nesting, 0 for compact text on a single line.
+     */
+    explicit JsonSerializer(int indent = 0);
+
+    /**
+     * Deleted copy constructor. Copying is not allowed.
+     */
+    JsonSerializer(const JsonSerializer&) = delete;
+
+    /**
+     * Deleted assignment operator. Assigning is not allowed.
+     */
+    JsonSerializer& operator=(const JsonSerializer&) = delete;
+
+    /**
+     * Write a value to the buffer of the serializer.
+     * @param value The value.
+     * @return View of the text, valid until the next call.
+     */
+    JsonStringView serialize(const JsonValue& value);
+
+    /**
+     * Write the root object of a parser to the buffer of the serializer.
+     * @throw invalid argument if nothing was parsed.
+     * @param parser The parser.
+     * @return View of the text, valid until the next call.
+     */
+    JsonStringView serialize(const JsonParser& parser);
+
+    /**
+     * Write an object to the buffer of the serializer, ex. the root object of a JsonFrozenDocument.
+     * @param object The object.
+     * @return View of the text, valid until the next call.
+     */
+    JsonStringView serialize(const JsonObject& object);
+
+    /**
+     * Write a value to a file descriptor.
+     * @throw invalid argument if writing fails.
+     * @param value The value.
+     * @param fd Open file descriptor, ex. of a file, pipe or socket.
+     */
+    void serialize(const JsonValue& value, int fd);
+
+    /**
+     * Write the root object of a parser to a file descriptor.
+     * @throw invalid argument if nothing was parsed or writing fails.
+     * @param parser The parser.
+     * @param fd Open file descriptor.
+     */
+    void serialize(const JsonParser& parser, int fd);
+
+private:
+    int indent;             /**< Spaces per level of nesting, 0 for compact text*/
+    std::string buffer;     /**< Text that is not written yet, its capacity is reused*/
+    size_t used;            /**< Amount of characters of the buffer that are in use*/
+    int fd;                 /**< File descriptor the buffer is flushed to, -1 to keep the text in the buffer*/
+
+    /**
+     * Get room at the end of the text, flushing or growing the buffer if needed.
+     * @param length Amount of characters that will be written.
+     * @return Position of the first character.
+     */
+    char* reserve(size_t length)
+    {
+        if (used+length>buffer.size())
+            grow(length);
+        return &buffer[used];
+    }
+
+    /**
+     * Add the characters written after a reserve to the text.
+     * @param end Position after the last written character.
+     */
+    void commit(const char* end)
+    {
+        used = static_cast<size_t>(end-buffer.data());
+    }
+
+    /**
+     * Add one character to the text.
+     * @param c The character.
+     */
+    void writeChar(char c)
+    {
+        *reserve(1) = c;
+        used++;
+    }
+
+    /**
+     * Add characters to the text as they are.
+     * @param text First character.
+     * @param length Amount of characters.
+     */
+    void writeText(const char* text, size_t length)
+    {
+        memcpy(reserve(length), text, length);
+        used += length;
+    }
+
+    /**
+     * Make room for more characters than are left in the buffer.
+     * @param length Amount of characters that will be written.
+     */
+    void grow(size_t length);
+
+    /**
+     * Write the text in the buffer to the file descriptor and empty the buffer.
+     * @throw invalid argument if writing fails.
+     */
+    void flush();
+
+    void writeValue(const JsonValue& value, int depth);
+    void writeObject(const JsonObject& object, int depth);
+    void writeArray(const JsonArray& array, int depth);
+
+    /**
+     * Start a new line that is indented for a level of nesting, nothing is written for compact text.
+     * @param depth Level of nesting.
+     */
+    void writeNewLine(int depth);
+
+    /**
+     * Get the root object of a parser.
+     * @throw invalid argument if nothing was parsed.
+     * @param parser The parser.
+     * @return The root object.
+     */
+    static const JsonObject& rootOf(const JsonParser& parser);
+};
+
+#endif //JSONPARSER_JSONSERIALIZER_H
@@ -0,0 +1,212 @@
+#ifndef JSONPARSER_JSONSTRINGVIEW_H
+#define JSONPARSER_JSONSTRINGVIEW_H
+
+#include <string>
+#include <cstring>
+#include <ostream>
+#include <stdexcept>
+#include <algorithm>
+
+#if __cplusplus>=201703L
+
+#include <string_view>
+
+/**
+ * Non-owning view of the characters of a string.
+ */
+using JsonStringView = std::string_view;
+
+#else
+
+/**
+ * Non-owning view of the characters of a string, for compilers without std::string_view.
+ * Only the part of the std::string_view interface that is needed to read strings is provided,
+ * code using it keeps compiling when std::string_view is used instead.
+ */
+class JsonStringView {
+private:
+    const char* m_data;     /**< First character*/
+    size_t m_size;          /**< Amount of characters*/
+
+public:
+    using const_iterator = const char*;
+    using iterator = const_iterator;
+    // An enumerator instead of a static member, so it never needs a definition in a translation unit
+    enum : size_t {
+        npos = static_cast<size_t>(-1)
+    };
+
+    /**
+     * Creates an empty view.
+     */
+    JsonStringView() noexcept
+            :m_data(""), m_size(0)
+    {
+
+    }
+
+    /**
+     * Creates a view of a range of characters.
+     * @param data First character.
+     * @param size Amount of characters.
+     */
+    JsonStringView(const char* data, size_t size) noexcept
+            :m_data(data), m_size(size)
+    {
+
+    }
+
+    /**
+     * Creates a view of a null terminated string.
+     * @param data Null terminated string.
+     */
+    JsonStringView(const char* data) noexcept // NOLINT
+            :m_data(data), m_size(strlen(data))
+    {
+
+    }
+
+    /**
+     * Creates a view of a string, the view is invalidated when the string changes.
+     * @param string String to view.
+     */
+    template<class Allocator>
+    JsonStringView(const std::basic_string<char, std::char_traits<char>, Allocator>& string) noexcept // NOLINT
+            :m_data(string.data()), m_size(string.size())
+    {
+
+    }
+
+    /**
+     * Copy the characters to a std::string.
+     */
+    explicit operator std::string() const
+    {
+        return std::string(m_data, m_size);
+    }
+
+    const char* data() const noexcept
+    {
+        return m_data;
+    }
+
+    size_t size() const noexcept
+    {
+        return m_size;
+    }
+
+    size_t length() const noexcept
+    {
+        return m_size;
+    }
+
+    bool empty() const noexcept
+    {
+        return m_size==0;
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return m_data;
+    }
+
+    const_iterator end() const noexcept
+    {
+        return m_data+m_size;
+    }
+
+    char operator[](size_t index) const noexcept
+    {
+        return m_data[index];
+    }
+
+    char front() const noexcept
+    {
+        return m_data[0];
+    }
+
+    char back() const noexcept
+    {
+        return m_data[m_size-1];
+    }
+
+    /**
+     * Get a part of the view.
+     * @throw out of range if position is larger than the size.
+     * @param position First character of the part.
+     * @param count Maximum amount of characters of the part.
+     * @return View of the part.
+     */
+    JsonStringView substr(size_t position = 0, size_t count = npos) const
+    {
+        if (position>m_size)
+            throw std::out_of_range("JsonStringView::substr");
+        return JsonStringView(m_data+position, std::min(count, m_size-position));
+    }
+
+    /**
+     * Compare the characters of two views lexicographically.
+     * @param other View to compare with.
+     * @return Negative, zero or positive, like std::string::compare.
+     */
+    int compare(JsonStringView other) const noexcept
+    {
+        int result = m_size==0 || other.m_size==0 ? 0 : memcmp(m_data, other.m_data, std::min(m_size, other.m_size));
+        if (result!=0)
+            return result;
+        return m_size<other.m_size ? -1 : m_size>other.m_size ? 1 : 0;
+    }
+
+    /**
+     * Find the first occurrence of a character.
+     * @param c Character to look for.
+     * @param position First position to look at.
+     * @return Position of the character, npos if it is not found.
+     */
+    size_t find(char c, size_t position = 0) const noexcept
+    {
+        if (position>=m_size)
+            return npos;
+        const void* found = memchr(m_data+position, c, m_size-position);
+        return found==nullptr ? npos : static_cast<size_t>(static_cast<const char*>(found)-m_data);
+    }
+
+    friend bool operator==(JsonStringView a, JsonStringView b) noexcept
+    {
+        return a.m_size==b.m_size && a.compare(b)==0;
+    }
+
+    friend bool operator!=(JsonStringView a, JsonStringView b) noexcept
+    {
+        return !(a==b);
+    }
+
+    friend bool operator<(JsonStringView a, JsonStringView b) noexcept
+    {
+        return a.compare(b)<0;
+    }
+
+    friend bool operator>(JsonStringView a, JsonStringView b) noexcept
+    {
+        return b<a;
+    }
+
+    friend bool operator<=(JsonStringView a, JsonStringView b) noexcept
+    {
+        return !(b<a);
+    }
+
+    friend bool operator>=(JsonStringView a, JsonStringView b) noexcept
+    {
+        return !(a<b);
+    }
+
+    friend std::ostream& operator<<(std::ostream& stream, JsonStringView view)
+    {
+        return stream.write(view.m_data, static_cast<std::streamsize>(view.m_size));
+    }
+};
+
+#endif
+
+#endif //JSONPARSER_JSONSTRINGVIEW_H
@@ -0,0 +1,370 @@
+#include <cstring>
+#include "jsonStructural.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define JSONPARSER_X86_SIMD
+#include <immintrin.h>
+#endif
+
+namespace {
+
+/**
+ * Characters of one 64 character block, one bit per character.
+ */
+struct BlockMasks {
+    uint64_t quote;         /**< '"'*/
+    uint64_t singleQuote;   /**< '\''*/
+    uint64_t backslash;     /**< '\\'*/
+    uint64_t structural;    /**< '{', '}', '[', ']', ':' and ','*/
+    uint64_t open;          /**< '{' and '[', only if brackets are classified*/
+    uint64_t close;         /**< '}' and ']', only if brackets are classified*/
+    uint64_t whiteSpace;    /**< ' ', '\t', '\r' and '\n'*/
+    uint64_t newLine;       /**< '\n'*/
+};
+
+using Classifier = void (*)(const uint8_t* block, BlockMasks& masks);
+
+/**
+ * The classifiers are templates, so the index does not pay for the opening and closing brackets it does not need.
+ */
+template<bool Brackets>
+void classifyScalar(const uint8_t* block, BlockMasks& masks)
+{
+    masks = BlockMasks{};
+    for (int i = 0; i<64; i++) {
+        uint64_t bit = uint64_t(1) << i;
+        switch (block[i]) {
+        case '"':
+            masks.quote |= bit;
+            break;
+        case '\'':
+            masks.singleQuote |= bit;
+            break;
+        case '\\':
+            masks.backslash |= bit;
+            break;
+        case '{':
+        case '[':
+            if (Brackets)
+                masks.open |= bit;
+            masks.structural |= bit;
+            break;
+        case '}':
+        case ']':
+            if (Brackets)
+                masks.close |= bit;
+            masks.structural |= bit;
+            break;
+        case ':':
+        case ',':
+            masks.structural |= bit;
+            break;
+        case '\n':
+            masks.newLine |= bit;
+            masks.whiteSpace |= bit;
+            break;
+        case ' ':
+        case '\t':
+        case '\r':
+            masks.whiteSpace |= bit;
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+#ifdef JSONPARSER_X86_SIMD
+
+/**
+ * SSE2 is part of x86-64, so it does not need a target attribute or a runtime check.
+ */
+template<bool Brackets>
+void classifySse2(const uint8_t* block, BlockMasks& masks)
+{
+    masks = BlockMasks{};
+    for (int i = 0; i<4; i++) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block+16*i));
+        auto match = [&](char c) {
+            return static_cast<uint64_t>(static_cast<uint16_t>(
+                    _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, _mm_set1_epi8(c))))) << (16*i);
+        };
+        // '[' and ']' only differ from '{' and '}' in bit 0x20
+        __m128i folded = _mm_or_si128(chunk, _mm_set1_epi8(0x20));
+        auto matchFolded = [&](char c) {
+            return static_cast<uint64_t>(static_cast<uint16_t>(
+                    _mm_movemask_epi8(_mm_cmpeq_epi8(folded, _mm_set1_epi8(c))))) << (16*i);
+        };
+        uint64_t newLine = match('\n');
+        uint64_t open = matchFolded('{');
+        uint64_t close = matchFolded('}');
+        masks.quote |= match('"');
+        masks.singleQuote |= match('\'');
+        masks.backslash |= match('\\');
+        masks.structural |= open | close | match(':') | match(',');
+        if (Brackets) {
+            masks.open |= open;
+            masks.close |= close;
+        }
+        masks.whiteSpace |= match(' ') | match('\t') | match('\r') | newLine;
+        masks.newLine |= newLine;
+    }
+}
+
+__attribute__((target("avx2")))
+inline uint64_t matchAvx2(__m256i chunk, char c)
+{
+    return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(c))));
+}
+
+template<bool Brackets>
+__attribute__((target("avx2")))
+void classifyAvx2(const uint8_t* block, BlockMasks& masks)
+{
+    masks = BlockMasks{};
+    for (int i = 0; i<2; i++) {
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block+32*i));
+        __m256i folded = _mm256_or_si256(chunk, _mm256_set1_epi8(0x20));
+        int shift = 32*i;
+        uint64_t newLine = matchAvx2(chunk, '\n') << shift;
+        uint64_t open = matchAvx2(folded, '{') << shift;
+        uint64_t close = matchAvx2(folded, '}') << shift;
+        masks.quote |= matchAvx2(chunk, '"') << shift;
+        masks.singleQuote |= matchAvx2(chunk, '\'') << shift;
+        masks.backslash |= matchAvx2(chunk, '\\') << shift;
+        masks.structural |= open | close | ((matchAvx2(chunk, ':') | matchAvx2(chunk, ',')) << shift);
+        if (Brackets) {
+            masks.open |= open;
+            masks.close |= close;
+        }
+        masks.whiteSpace |= ((matchAvx2(chunk, ' ') | matchAvx2(chunk, '\t') | matchAvx2(chunk, '\r')) << shift)
+                | newLine;
+        masks.newLine |= newLine;
+    }
+}
+
+#endif
+
+int countTrailingZeros(uint64_t value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(value);
+#else
+    int count = 0;
+    while ((value & 1)==0) {
+        value >>= 1;
+        count++;
+    }
+    return count;
+#endif
+}
+
+int countOnes(uint64_t value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(value);
+#else
+    int count = 0;
+    for (; value!=0; value &= value-1)
+        count++;
+    return count;
+#endif
+}
+
+/**
+ * Find the characters of a block that are escaped by a backslash.
+ * Backslashes are rare, so they are resolved one at a time.
+ * @param backslash Backslashes of the block.
+ * @param carry 1 if the first character of the block is escaped, set for the next block.
+ * @return Escaped characters.
+ */
+uint64_t escapedCharacters(uint64_t backslash, uint64_t& carry)
+{
+    uint64_t result = carry;
+    backslash &= ~carry;
+    carry = 0;
+    while (backslash!=0) {
+        int i = countTrailingZeros(backslash);
+        if (i==63) {
+            carry = 1;
+            break;
+        }
+        uint64_t next = uint64_t(1) << (i+1);
+        result |= next;
+        backslash &= ~next;
+        backslash &= backslash-1;
+    }
+    return result;
+}
+
+/**
+ * Prefix xor of the unescaped quotes of a block: 1 from an opening quote up to, but not including,
+ * the closing quote.
+ * @param quote Unescaped quotes of the block.
+ * @return Characters inside strings, if the block does not start inside a string.
+ */
+uint64_t stringCharacters(uint64_t quote)
+{
+    uint64_t inString = quote;
+    inString ^= inString << 1;
+    inString ^= inString << 2;
+    inString ^= inString << 4;
+    inString ^= inString << 8;
+    inString ^= inString << 16;
+    inString ^= inString << 32;
+    return inString;
+}
+
+/**
+ * Turns the character masks of consecutive blocks into structural positions.
+ */
+class BlockScanner {
+private:
+    uint64_t escapedCarry = 0;      /**< 1 if the first character of the next block is escaped*/
+    uint64_t inStringCarry = 0;     /**< All ones if the next block starts inside a string*/
+    uint64_t boundaryCarry = 1;     /**< 1 if the last character of the previous block ends a token*/
+    bool usable = true;             /**< False if the text can not be indexed*/
+
+public:
+
+    void scan(const BlockMasks& masks, uint32_t offset, std::vector<uint32_t>& positions)
+    {
+        uint64_t quote = masks.quote & ~escapedCharacters(masks.backslash, escapedCarry);
+        uint64_t inString = stringCharacters(quote) ^ inStringCarry;
+        inStringCarry = static_cast<uint64_t>(static_cast<int64_t>(inString) >> 63);
+
+        if ((masks.singleQuote & ~inString)!=0 || (masks.newLine & inString)!=0)
+            usable = false;
+
+        uint64_t structural = masks.structural & ~inString;
+        uint64_t boundary = (structural | masks.whiteSpace | quote) & ~inString;
+        uint64_t other = ~(masks.structural | masks.whiteSpace | quote | inString);
+        uint64_t tokenStart = other & ((boundary << 1) | boundaryCarry);
+        boundaryCarry = boundary >> 63;
+
+        uint64_t bits = structural | quote | tokenStart;
+        while (bits!=0) {
+            positions.push_back(offset+static_cast<uint32_t>(countTrailingZeros(bits)));
+            bits &= bits-1;
+        }
+    }
+
+    bool finish() const
+    {
+        return usable && inStringCarry==0;
+    }
+};
+
+bool buildWith(Classifier classify, const char* data, size_t length, std::vector<uint32_t>& positions)
+{
+    BlockScanner scanner;
+    BlockMasks masks{};
+    auto* bytes = reinterpret_cast<const uint8_t*>(data);
+
+    size_t offset = 0;
+    for (; offset+64<=length; offset += 64) {
+        classify(bytes+offset, masks);
+        scanner.scan(masks, static_cast<uint32_t>(offset), positions);
+    }
+    if (offset<length) {
+        // Pad the last block with whitespace
+        uint8_t block[64];
+        memset(block, ' ', sizeof(block));
+        memcpy(block, bytes+offset, length-offset);
+        classify(block, masks);
+        scanner.scan(masks, static_cast<uint32_t>(offset), positions);
+    }
+    return scanner.finish();
+}
+
+template<bool Brackets>
+Classifier classifierFor(JsonStructuralIndex::Implementation implementation)
+{
+    if (implementation==JsonStructuralIndex::AUTO || !JsonStructuralIndex::isSupported(implementation))
+        implementation = JsonStructuralIndex::bestImplementation();
+#ifdef JSONPARSER_X86_SIMD
+    if (implementation==JsonStructuralIndex::AVX2)
+        return classifyAvx2<Brackets>;
+    if (implementation==JsonStructuralIndex::SSE2)
+        return classifySse2<Brackets>;
+#endif
+    return classifyScalar<Brackets>;
+}
+
+}
+
+bool JsonStructuralIndex::build(const char* data, size_t length, Implementation implementation)
+{
+    m_positions.clear();
+    if (length>=UINT32_MAX)
+        return false;
+    // Most json has a structural position every few characters
+    m_positions.reserve(length/4+1);
+    return buildWith(classifierFor<false>(implementation), data, length, m_positions);
+}
+
+JsonStructuralIndex::Summary JsonStructuralIndex::summarize(const char* text, const char* begin, const char* end,
+                                                            Implementation implementation)
+{
+    Classifier classify = classifierFor<true>(implementation);
+    Summary result{};
+    // Backslashes only occur in strings, so whether the first character is escaped does not depend on the start
+    const char* backslashes = begin;
+    while (backslashes>text && backslashes[-1]=='\\')
+        --backslashes;
+    uint64_t escapedCarry = (begin-backslashes)%2;
+    uint64_t inStringCarry = 0;
+
+    auto summarizeBlock = [&](const uint8_t* block) {
+        BlockMasks masks{};
+        classify(block, masks);
+        uint64_t quote = masks.quote & ~escapedCharacters(masks.backslash, escapedCarry);
+        // Characters inside strings if the part starts outside a string, the others if it starts inside one
+        uint64_t inString = stringCharacters(quote) ^ inStringCarry;
+        inStringCarry = static_cast<uint64_t>(static_cast<int64_t>(inString) >> 63);
+        result.depthChange[0] += countOnes(masks.open & ~inString)-countOnes(masks.close & ~inString);
+        result.depthChange[1] += countOnes(masks.open & inString)-countOnes(masks.close & inString);
+        result.singleQuotes[0] |= (masks.singleQuote & ~inString)!=0;
+        result.singleQuotes[1] |= (masks.singleQuote & inString)!=0;
+        result.newLines += static_cast<size_t>(countOnes(masks.newLine));
+    };
+
+    auto* bytes = reinterpret_cast<const uint8_t*>(begin);
+    auto length = static_cast<size_t>(end-begin);
+    size_t offset = 0;
+    for (; offset+64<=length; offset += 64)
+        summarizeBlock(bytes+offset);
+    if (offset<length) {
+        // Pad the last block with whitespace
+        uint8_t block[64];
+        memset(block, ' ', sizeof(block));
+        memcpy(block, bytes+offset, length-offset);
+        summarizeBlock(block);
+    }
+    result.oddQuotes = inStringCarry!=0;
+    return result;
+}
+
+JsonStructuralIndex::Implementation JsonStructuralIndex::bestImplementation()
+{
+    static const Implementation best = isSupported(AVX2) ? AVX2 : isSupported(SSE2) ? SSE2 : SCALAR;
+    return best;
+}
+
+bool JsonStructuralIndex::isSupported(Implementation implementation)
+{
+    switch (implementation) {
+    case SCALAR:
+    case AUTO:
+        return true;
+#ifdef JSONPARSER_X86_SIMD
+    case SSE2:
+        return true;
+    case AVX2:
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2")!=0;
+#endif
+    default:
+        return false;
+    }
+}
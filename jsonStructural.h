@@ -0,0 +1,92 @@
+#ifndef JSONPARSER_JSONSTRUCTURAL_H
+#define JSONPARSER_JSONSTRUCTURAL_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * Index of the structural positions of a json text.
+ * The text is classified in blocks of 64 characters with SIMD instructions (AVX2 or SSE2, chosen at runtime)
+ * or a scalar fallback. The index contains the positions of:
+ *  - the structural characters '{', '}', '[', ']', ':' and ',' outside of strings
+ *  - every unescaped '"', so the opening and closing quote of each string
+ *  - the first character of every other token (numbers and literals)
+ * Everything between two positions is either whitespace, the inside of a string or the rest of a token,
+ * which lets the parser jump from token to token.
+ */
+class JsonStructuralIndex {
+public:
+
+    /**
+     * Available implementations of the classification.
+     */
+    enum Implementation {
+        AUTO,       /**< Best implementation supported by the CPU*/
+        SCALAR,     /**< Portable implementation, one character at a time*/
+        SSE2,       /**< 16 characters at a time, x86-64 only*/
+        AVX2        /**< 32 characters at a time, x86-64 CPUs with AVX2 only*/
+    };
+
+    /**
+     * Summary of a part of a json text, for splitting a text between threads.
+     * A part does not know whether it starts inside a string, so the summary covers both cases.
+     */
+    struct Summary {
+        long depthChange[2];    /**< Change of the nesting depth if the part starts outside [0] or inside [1] a string*/
+        bool singleQuotes[2];   /**< True if a single quote occurs outside a string, for both starts*/
+        bool oddQuotes;         /**< True if the part has an odd amount of unescaped double quotes*/
+        size_t newLines;        /**< Amount of newlines*/
+    };
+
+    /**
+     * Build the index of a json text.
+     * The index can not be used for texts with single quoted strings, strings containing newlines
+     * or unterminated strings, build returns false for those and the text should be parsed without index.
+     * @param data Start of the json text.
+     * @param length Amount of characters, must be smaller than 4GB.
+     * @param implementation Implementation to use, AUTO selects the fastest one the CPU supports.
+     * @return True if the index is usable.
+     */
+    bool build(const char* data, size_t length, Implementation implementation = AUTO);
+
+    /**
+     * Summarize a part of a json text with the same classification as the index.
+     * Parts of a text can be summarized in parallel, a prefix over the summaries tells every part whether it
+     * starts inside a string and at which nesting depth.
+     * @param text Start of the complete text, to check whether the first character of the part is escaped.
+     * @param begin First character of the part.
+     * @param end End of the part.
+     * @param implementation Implementation to use, AUTO selects the fastest one the CPU supports.
+     * @return The summary.
+     */
+    static Summary summarize(const char* text, const char* begin, const char* end,
+                             Implementation implementation = AUTO);
+
+    /**
+     * Get the structural positions, in increasing order.
+     * @return The positions.
+     */
+    const std::vector<uint32_t>& positions() const
+    {
+        return m_positions;
+    }
+
+    /**
+     * Get the fastest implementation the CPU supports.
+     * @return The implementation used for AUTO.
+     */
+    static Implementation bestImplementation();
+
+    /**
+     * Check whether the CPU supports an implementation.
+     * @param implementation Implementation to check.
+     * @return True if the implementation can be used.
+     */
+    static bool isSupported(Implementation implementation);
+
+private:
+    std::vector<uint32_t> m_positions;  /**< Structural positions*/
+};
+
+#endif //JSONPARSER_JSONSTRUCTURAL_H
@@ -0,0 +1,392 @@
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+#include "jsonTape.h"
+
+namespace {
+
+const uint64_t MAX_TAPE_COUNT = 0xFFFFFF;   /**< Largest count that fits in a start word*/
+const uint64_t MAX_TAPE_INDEX = 0xFFFFFFFF; /**< Largest end index that fits in a start word*/
+
+}
+
+JsonTape::JsonTape(const std::string& file_name)
+{
+    parse(file_name);
+}
+
+void JsonTape::parse(const std::string& file_name)
+{
+    MappedFile file(file_name);
+    parse(file.data(), file.size());
+}
+
+void JsonTape::parseString(const std::string& json)
+{
+    parse(json.data(), json.size());
+}
+
+void JsonTape::clear()
+{
+    tape.clear();
+    strings.clear();
+    unfinished.clear();
+    counts.clear();
+}
+
+void JsonTape::parse(const char* data, size_t length)
+{
+    clear();
+    // A word per 8 characters is a cheap estimate that avoids most reallocations
+    tape.reserve(length/8+2);
+    counts.push_back(0);
+    try {
+        reader.parse(data, length, *this);
+    }
+    catch (...) {
+        // A half built tape has start words without end index, queries would walk past its end
+        clear();
+        throw;
+    }
+}
+
+void JsonTape::startValue(char type)
+{
+    countValue();
+    unfinished.push_back(tape.size());
+    counts.push_back(0);
+    append(type);
+}
+
+void JsonTape::endValue(char type)
+{
+    size_t start = unfinished.back();
+    uint64_t count = std::min(counts.back(), MAX_TAPE_COUNT);
+    unfinished.pop_back();
+    counts.pop_back();
+    append(type, start);
+    if (tape.size()>MAX_TAPE_INDEX)
+        throw std::length_error("Too many values for: JsonTape");
+    tape[start] |= (count << 32) | tape.size();
+}
+
+void JsonTape::countValue()
+{
+    counts.back()++;
+}
+
+void JsonTape::startObject()
+{
+    startValue('{');
+}
+
+void JsonTape::key(JsonStringView key)
+{
+    appendString(key);
+}
+
+void JsonTape::endObject()
+{
+    endValue('}');
+}
+
+void JsonTape::startArray()
+{
+    startValue('[');
+}
+
+void JsonTape::endArray()
+{
+    endValue(']');
+}
+
+void JsonTape::string(JsonStringView value)
+{
+    countValue();
+    appendString(value);
+}
+
+void JsonTape::number(const JsonNumber& value)
+{
+    countValue();
+    uint64_t bits;
+    memcpy(&bits, &value.uint_value, sizeof(bits));
+    append(value.kind==JsonNumber::INT ? 'l' : value.kind==JsonNumber::UINT ? 'u' : 'd');
+    tape.push_back(bits);
+}
+
+void JsonTape::boolean(bool value)
+{
+    countValue();
+    append(value ? 't' : 'f');
+}
+
+void JsonTape::null()
+{
+    countValue();
+    append('n');
+}
+
+void JsonTape::appendString(JsonStringView value)
+{
+    if (value.size()>UINT32_MAX)
+        throw std::length_error("String too long for: JsonTape");
+    size_t offset = strings.size();
+    auto length = static_cast<uint32_t>(value.size());
+    strings.resize(offset+sizeof(length)+value.size()+1);
+    memcpy(&strings[offset], &length, sizeof(length));
+    memcpy(&strings[offset+sizeof(length)], value.data(), value.size());
+    strings.back() = '\0';
+    append('"', offset);
+}
+
+size_t JsonTape::skip(size_t index) const
+{
+    switch (typeAt(index)) {
+    case '{':
+    case '[':
+        return static_cast<size_t>(tape[index] & 0xFFFFFFFFu);
+    case 'd':
+    case 'l':
+    case 'u':
+        return index+2;
+    default:
+        return index+1;
+    }
+}
+
+const char* JsonTape::stringAt(size_t index) const
+{
+    return &strings[payloadAt(index)+sizeof(uint32_t)];
+}
+
+uint32_t JsonTape::stringLengthAt(size_t index) const
+{
+    uint32_t length;
+    memcpy(&length, &strings[payloadAt(index)], sizeof(length));
+    return length;
+}
+
+size_t JsonTape::find(size_t object, JsonStringView key) const
+{
+    if (tape.empty())
+        return 0;
+    size_t end = skip(object)-1;
+    for (size_t i = object+1; i<end; i = skip(i+1)) {
+        if (stringLengthAt(i)==key.size() && memcmp(stringAt(i), key.data(), key.size())==0)
+            return i+1;
+    }
+    return 0;
+}
+
+JsonTapeValue JsonTape::root() const
+{
+    if (tape.empty())
+        throw std::invalid_argument("JsonTape is empty");
+    return JsonTapeValue(this, 0);
+}
+
+bool JsonTape::hasKey(JsonStringView key) const
+{
+    return find(0, key)!=0;
+}
+
+JsonTapeValue JsonTape::operator[](JsonStringView key) const
+{
+    size_t found = find(0, key);
+    if (found==0)
+        throw std::invalid_argument("There is no such key '"+std::string(key)+"'");
+    return JsonTapeValue(this, found);
+}
+
+bool JsonTapeValue::isBool() const
+{
+    char type = tape->typeAt(index);
+    return type=='t' || type=='f';
+}
+
+bool JsonTapeValue::isNull() const
+{
+    return tape->typeAt(index)=='n';
+}
+
+bool JsonTapeValue::isString() const
+{
+    return tape->typeAt(index)=='"';
+}
+
+bool JsonTapeValue::isArray() const
+{
+    return tape->typeAt(index)=='[';
+}
+
+bool JsonTapeValue::isObject() const
+{
+    return tape->typeAt(index)=='{';
+}
+
+bool JsonTapeValue::isNumber() const
+{
+    char type = tape->typeAt(index);
+    return type=='d' || type=='l' || type=='u';
+}
+
+bool JsonTapeValue::isInteger() const
+{
+    char type = tape->typeAt(index);
+    return type=='l' || type=='u';
+}
+
+bool JsonTapeValue::getBoolValue() const
+{
+    if (!isBool())
+        throw std::invalid_argument("Unexpected value for JsonBool");
+    return tape->typeAt(index)=='t';
+}
+
+double JsonTapeValue::getNumberValue() const
+{
+    if (!isNumber())
+        throw std::invalid_argument("Invalid type for: JsonNumber");
+    const uint64_t& bits = tape->tape[index+1];
+    switch (tape->typeAt(index)) {
+    case 'l':
+        return static_cast<double>(static_cast<int64_t>(bits));
+    case 'u':
+        return static_cast<double>(bits);
+    default:
+        double number;
+        memcpy(&number, &bits, sizeof(number));
+        return number;
+    }
+}
+
+int64_t JsonTapeValue::getInt64Value() const
+{
+    if (!isInteger())
+        throw std::invalid_argument("Invalid type for: JsonInt");
+    uint64_t bits = tape->tape[index+1];
+    if (tape->typeAt(index)=='u')
+        throw std::invalid_argument("Value out of range for: JsonInt");
+    return static_cast<int64_t>(bits);
+}
+
+uint64_t JsonTapeValue::getUInt64Value() const
+{
+    if (!isInteger())
+        throw std::invalid_argument("Invalid type for: JsonUInt");
+    uint64_t bits = tape->tape[index+1];
+    if (tape->typeAt(index)=='l' && static_cast<int64_t>(bits)<0)
+        throw std::invalid_argument("Value out of range for: JsonUInt");
+    return bits;
+}
+
+std::string JsonTapeValue::getStringValue() const
+{
+    if (!isString())
+        throw std::invalid_argument("Invalid type for: JsonString");
+    return std::string(tape->stringAt(index), tape->stringLengthAt(index));
+}
+
+const char* JsonTapeValue::c_str() const
+{
+    if (!isString())
+        throw std::invalid_argument("Invalid type for: JsonString");
+    return tape->stringAt(index);
+}
+
+JsonStringView JsonTapeValue::getStringView() const
+{
+    if (!isString())
+        throw std::invalid_argument("Invalid type for: JsonString");
+    return JsonStringView(tape->stringAt(index), tape->stringLengthAt(index));
+}
+
+size_t JsonTapeValue::size() const
+{
+    if (!isArray() && !isObject())
+        throw std::invalid_argument("Invalid type for: JsonArray or JsonObject");
+    uint64_t count = (tape->payloadAt(index) >> 32) & MAX_TAPE_COUNT;
+    if (count<MAX_TAPE_COUNT)
+        return static_cast<size_t>(count);
+
+    // Saturated count, count the values instead
+    size_t result = 0;
+    for (auto it = begin(); it!=end(); ++it)
+        result++;
+    return result;
+}
+
+JsonTapeValue JsonTapeValue::operator[](int i) const
+{
+    if (!isArray())
+        throw std::invalid_argument("Object is not of type JsonArray");
+    if (i>=0) {
+        int current = 0;
+        for (auto it = begin(); it!=end(); ++it, ++current) {
+            if (current==i)
+                return it.value();
+        }
+    }
+    size_t count = size();
+    if (count==0)
+        throw std::invalid_argument("Index out of range, got ["+std::to_string(i)+"], but JsonArray is empty");
+    throw std::invalid_argument(
+            "Index out of range, got ["+std::to_string(i)+"], max is ["+std::to_string(count-1)+"]");
+}
+
+JsonTapeValue JsonTapeValue::operator[](JsonStringView key) const
+{
+    if (!isObject())
+        throw std::invalid_argument("Object is not of type JsonObject");
+    size_t found = tape->find(index, key);
+    if (found==0)
+        throw std::invalid_argument("Did not find key '"+std::string(key)+"' in JsonObject");
+    return JsonTapeValue(tape, found);
+}
+
+bool JsonTapeValue::hasKey(JsonStringView key) const
+{
+    if (!isObject())
+        throw std::invalid_argument("JsonValue is not of type 'JsonObject'");
+    return tape->find(index, key)!=0;
+}
+
+JsonTapeValue::Iterator JsonTapeValue::begin() const
+{
+    if (!isArray() && !isObject())
+        throw std::invalid_argument("Invalid type for: JsonArray or JsonObject");
+    return Iterator(tape, index+1, isObject());
+}
+
+JsonTapeValue::Iterator JsonTapeValue::end() const
+{
+    if (!isArray() && !isObject())
+        throw std::invalid_argument("Invalid type for: JsonArray or JsonObject");
+    return Iterator(tape, tape->skip(index)-1, isObject());
+}
+
+const char* JsonTapeValue::Iterator::key() const
+{
+    if (!object)
+        throw std::invalid_argument("Object is not of type JsonObject");
+    return tape->stringAt(index);
+}
+
+JsonStringView JsonTapeValue::Iterator::keyView() const
+{
+    if (!object)
+        throw std::invalid_argument("Object is not of type JsonObject");
+    return JsonStringView(tape->stringAt(index), tape->stringLengthAt(index));
+}
+
+JsonTapeValue JsonTapeValue::Iterator::value() const
+{
+    return JsonTapeValue(tape, object ? index+1 : index);
+}
+
+JsonTapeValue::Iterator& JsonTapeValue::Iterator::operator++()
+{
+    index = tape->skip(object ? index+1 : index);
+    return *this;
+}
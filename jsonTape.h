@@ -0,0 +1,422 @@
+#ifndef JSONPARSER_JSONTAPE_H
+#define JSONPARSER_JSONTAPE_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "jsonParser.h"
+#include "jsonReader.h"
+
+class JsonTape;
+
+/**
+ * Read-only view of a value on a JsonTape.
+ * The view is just a position on the tape, it is cheap to copy and stays valid as long as the tape is not
+ * cleared or parsed again. The accessors mirror the ones of JsonValue.
+ */
+class JsonTapeValue {
+private:
+    const JsonTape* tape;   /**< Tape the value lives on*/
+    size_t index;           /**< Index of the first word of the value*/
+
+public:
+
+    /**
+     * Creates a view of a value on a tape.
+     * @param tape Tape the value lives on.
+     * @param index Index of the first word of the value.
+     */
+    JsonTapeValue(const JsonTape* tape, size_t index)
+            :tape(tape), index(index)
+    {
+
+    }
+
+    /**
+     * Check whether the value is of JsonBool type.
+     * @return true if the type is a JsonBool.
+     */
+    bool isBool() const;
+
+    /**
+     * Check whether the value is of JsonNull type.
+     * @return true if the type is JsonNull.
+     */
+    bool isNull() const;
+
+    /**
+     * Check whether the value is of JsonString type.
+     * @return true if the type is JsonString.
+     */
+    bool isString() const;
+
+    /**
+     * Check whether the value is of JsonArray type.
+     * @return true if the type is JsonArray.
+     */
+    bool isArray() const;
+
+    /**
+     * Check whether the value is of JsonObject type.
+     * @return true if the type is JsonObject.
+     */
+    bool isObject() const;
+
+    /**
+     * Check whether the value is of JsonNum type.
+     * @return True if the type is JsonNum.
+     */
+    bool isNumber() const;
+
+    /**
+     * Check whether the value is a number that is stored as an exact 64-bit integer.
+     * @return True if getInt64Value or getUInt64Value can be used.
+     */
+    bool isInteger() const;
+
+    /**
+     * Get the boolean value.
+     * @throw invalid argument if the type is not JsonBool.
+     * @return the boolean value.
+     */
+    bool getBoolValue() const;
+
+    /**
+     * Get the number value.
+     * @throw invalid argument if the type is not JsonNum.
+     * @return the number value.
+     */
+    double getNumberValue() const;
+
+    /**
+     * Get the exact value of an integer.
+     * @throw invalid argument if the number is not an integer or does not fit in an int64_t.
+     * @return the integer value.
+     */
+    int64_t getInt64Value() const;
+
+    /**
+     * Get the exact value of a non-negative integer.
+     * @throw invalid argument if the number is not an integer or is negative.
+     * @return the integer value.
+     */
+    uint64_t getUInt64Value() const;
+
+    /**
+     * Get the string value.
+     * @throw invalid argument if the type is not JsonString.
+     * @return the string value.
+     */
+    std::string getStringValue() const;
+
+    /**
+     * Get the string value without copying it.
+     * @throw invalid argument if the type is not JsonString.
+     * @return Null terminated string, valid as long as the tape.
+     */
+    const char* c_str() const;
+
+    /**
+     * Get the string value without copying it.
+     * @throw invalid argument if the type is not JsonString.
+     * @return View of the string, valid as long as the tape.
+     */
+    JsonStringView getStringView() const;
+
+    /**
+     * Get the amount of elements of an array or members of an object.
+     * @throw invalid argument if the type is not JsonArray or JsonObject.
+     * @return Amount of elements or members.
+     */
+    size_t size() const;
+
+    /**
+     * Index operator which can be used if the value is a JsonArray.
+     * @throw invalid argument if the type is not JsonArray.
+     * @throw invalid argument if the index is out of bounds.
+     * @param index Index in the array.
+     * @return View of the element.
+     */
+    JsonTapeValue operator[](int index) const;
+
+    /**
+     * Index operator which can be used if the value is a JsonObject.
+     * @throw invalid argument if the type is not JsonObject.
+     * @throw invalid argument if the key cannot be found in the JsonObject.
+     * @param key Key associated to the value we want to get.
+     * @return View of the value associated with key.
+     */
+    JsonTapeValue operator[](JsonStringView key) const;
+
+    /**
+     * Check whether a key exists if the value is a JsonObject.
+     * @throw invalid argument if the type is not JsonObject
+     * @param key Key to check
+     * @return True if the key can be found
+     */
+    bool hasKey(JsonStringView key) const;
+
+    /**
+     * Iterator over the elements of an array or the members of an object.
+     */
+    class Iterator {
+    private:
+        const JsonTape* tape;   /**< Tape the values live on*/
+        size_t index;           /**< Index of the key (objects) or value (arrays)*/
+        bool object;            /**< True if the iterator walks over object members*/
+
+    public:
+        Iterator(const JsonTape* tape, size_t index, bool object)
+                :tape(tape), index(index), object(object)
+        {
+
+        }
+
+        /**
+         * Get the key of the current member.
+         * @throw invalid argument if the iterator walks over an array.
+         * @return Null terminated key.
+         */
+        const char* key() const;
+
+        /**
+         * Get the key of the current member without looking for its end.
+         * @throw invalid argument if the iterator walks over an array.
+         * @return View of the key.
+         */
+        JsonStringView keyView() const;
+
+        /**
+         * Get the current element or member value.
+         * @return View of the value.
+         */
+        JsonTapeValue value() const;
+
+        Iterator& operator++();
+
+        bool operator!=(const Iterator& other) const
+        {
+            return index!=other.index;
+        }
+
+        bool operator==(const Iterator& other) const
+        {
+            return index==other.index;
+        }
+
+        JsonTapeValue operator*() const
+        {
+            return value();
+        }
+    };
+
+    /**
+     * Get an iterator to the first element or member.
+     * @throw invalid argument if the type is not JsonArray or JsonObject.
+     * @return The iterator.
+     */
+    Iterator begin() const;
+
+    /**
+     * Get an iterator past the last element or member.
+     * @throw invalid argument if the type is not JsonArray or JsonObject.
+     * @return The iterator.
+     */
+    Iterator end() const;
+};
+
+/**
+ * Flat representation of a json document.
+ * All values are stored on one contiguous array of 64-bit words in document order. The upper 8 bits of a
+ * word hold the type, the lower 56 bits the payload:
+ *  - '{' object start and '[' array start: bits 0-31 index of the word after the matching end,
+ *    bits 32-55 amount of members or elements (saturated at 0xFFFFFF)
+ *  - '}' object end and ']' array end: index of the matching start
+ *  - '"' string: offset in the string buffer, which holds a 32-bit length, the characters and a '\0'
+ *  - 'd' number: the next word holds the bits of the double
+ *  - 'l' integer and 'u' unsigned integer: the next word holds the int64_t or uint64_t value
+ *  - 't' true, 'f' false, 'n' null: no payload
+ * The root object starts at the first word. Object members are stored as a string word for the key,
+ * followed by the words of the value. Skipping a complete object or array is a single jump, which makes
+ * lookups linear scans over the tape. Duplicate keys are kept, lookups return the first one.
+ */
+class JsonTape : private JsonHandler {
+public:
+
+    /**
+     * Default constructor, creates an empty tape.
+     */
+    JsonTape() = default;
+
+    /**
+     * Creates a JsonTape and immediately parses a file.
+     * @param file_name Name of the file to parse.
+     */
+    explicit JsonTape(const std::string& file_name);
+
+    /**
+     * Parses a json file and fills the tape.
+     * @throw invalid argument if the file can not be opened.
+     * @throw ParseError if the file is not valid json.
+     * @param file_name Path to input file.
+     */
+    void parse(const std::string& file_name);
+
+    /**
+     * Parses json text from a buffer and fills the tape.
+     * @throw ParseError if the text is not valid json.
+     * @throw length error if the tape needs more than 2^32 words or a string is longer than 2^32-1 characters.
+     * @param data Start of the json text.
+     * @param length Amount of characters in the buffer.
+     */
+    void parse(const char* data, size_t length);
+
+    /**
+     * Parses json text from a string and fills the tape.
+     * @throw ParseError if the text is not valid json.
+     * @param json String containing the json text.
+     */
+    void parseString(const std::string& json);
+
+    /**
+     * Get the root object.
+     * @throw invalid argument if nothing was parsed.
+     * @return View of the root object.
+     */
+    JsonTapeValue root() const;
+
+    /**
+     * Check whether a key exists in the root object.
+     * @param key Key to check
+     * @return True if the key exists
+     */
+    bool hasKey(JsonStringView key) const;
+
+    /**
+     * Index operator used to access the root object easily.
+     * @param key Key to access.
+     * @return View of the value associated with the key.
+     */
+    JsonTapeValue operator[](JsonStringView key) const;
+
+    /**
+     * Removes all values from the tape.
+     */
+    void clear();
+
+    /**
+     * Get the words of the tape.
+     * @return The tape.
+     */
+    const std::vector<uint64_t>& words() const
+    {
+        return tape;
+    }
+
+private:
+    std::vector<uint64_t> tape;     /**< Words of the tape*/
+    std::vector<char> strings;      /**< String buffer, referenced by the string words*/
+    JsonReader reader;              /**< Tokenizer of the input, its buffers are reused between parses*/
+    std::vector<size_t> unfinished;     /**< Start words of the unfinished objects and arrays*/
+    std::vector<uint64_t> counts;       /**< Amount of members or elements of the unfinished values*/
+
+    /**
+     * Get the type of a word.
+     * @param index Index of the word.
+     * @return Type character of the word.
+     */
+    char typeAt(size_t index) const
+    {
+        return static_cast<char>(tape[index] >> 56);
+    }
+
+    /**
+     * Get the payload of a word.
+     * @param index Index of the word.
+     * @return Lower 56 bits of the word.
+     */
+    uint64_t payloadAt(size_t index) const
+    {
+        return tape[index] & 0x00FFFFFFFFFFFFFFull;
+    }
+
+    /**
+     * Get the index of the value following a value.
+     * @param index Index of the first word of a value.
+     * @return Index of the word after the value.
+     */
+    size_t skip(size_t index) const;
+
+    /**
+     * Get the null terminated string a string word refers to.
+     * @param index Index of the string word.
+     * @return Null terminated string.
+     */
+    const char* stringAt(size_t index) const;
+
+    /**
+     * Get the length of the string a string word refers to.
+     * @param index Index of the string word.
+     * @return Length of the string.
+     */
+    uint32_t stringLengthAt(size_t index) const;
+
+    /**
+     * Find the value of a member of an object.
+     * @param object Index of the object start word.
+     * @param key Key to look for.
+     * @return Index of the value, 0 if the key does not exist or the tape is empty.
+     */
+    size_t find(size_t object, JsonStringView key) const;
+
+    /**
+     * Append a word to the tape.
+     * @param type Type character of the word.
+     * @param payload Payload of the word.
+     */
+    void append(char type, uint64_t payload = 0)
+    {
+        tape.push_back((static_cast<uint64_t>(static_cast<unsigned char>(type)) << 56) | payload);
+    }
+
+    /**
+     * Append a string word and copy the string to the string buffer.
+     * @param value String to add.
+     */
+    void appendString(JsonStringView value);
+
+    /**
+     * Append the start word of an object or array.
+     * @param type '{' or '['.
+     */
+    void startValue(char type);
+
+    /**
+     * Append the end word of the innermost object or array and complete its start word.
+     * @param type '}' or ']'.
+     */
+    void endValue(char type);
+
+    /**
+     * Count a value as an element if it is added to an array.
+     */
+    void countValue();
+
+    /**
+     * Events of the reader, they append the words of the values.
+     */
+    void startObject() override;
+    void key(JsonStringView key) override;
+    void endObject() override;
+    void startArray() override;
+    void endArray() override;
+    void string(JsonStringView value) override;
+    void number(const JsonNumber& value) override;
+    void boolean(bool value) override;
+    void null() override;
+
+    friend class JsonTapeValue;
+    friend class JsonReader;
+};
+
+#endif //JSONPARSER_JSONTAPE_H
@@ -0,0 +1,128 @@
+#include <algorithm>
+#include "jsonThreadPool.h"
+
+JsonThreadPool::JsonThreadPool(unsigned threads)
+        :current(nullptr), failed(false), generation(0), active(0), stopping(false)
+{
+    if (threads==0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    queues.reset(new Queue[threads]);
+    // The caller is thread 0
+    for (unsigned thread = 1; thread<threads; thread++)
+        this->threads.emplace_back(&JsonThreadPool::loop, this, thread);
+}
+
+JsonThreadPool::~JsonThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& thread : threads)
+        thread.join();
+}
+
+void JsonThreadPool::run(size_t count, const Task& task)
+{
+    if (count==0)
+        return;
+    std::lock_guard<std::mutex> runLock(runMutex);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        current = &task;
+        failed = false;
+        error = nullptr;
+        // A block of consecutive tasks per thread
+        unsigned size = this->size();
+        for (unsigned thread = 0; thread<size; thread++) {
+            std::lock_guard<std::mutex> queueLock(queues[thread].mutex);
+            queues[thread].next = count*thread/size;
+            queues[thread].end = count*(thread+1)/size;
+        }
+        active = static_cast<unsigned>(threads.size());
+        generation++;
+    }
+    wake.notify_all();
+    work(0);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [this] { return active==0; });
+    current = nullptr;
+    if (error!=nullptr) {
+        std::exception_ptr result = error;
+        error = nullptr;
+        std::rethrow_exception(result);
+    }
+}
+
+void JsonThreadPool::loop(unsigned thread)
+{
+    size_t seen = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this, seen] { return stopping || generation!=seen; });
+            if (stopping)
+                return;
+            seen = generation;
+        }
+        work(thread);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--active==0)
+                done.notify_one();
+        }
+    }
+}
+
+void JsonThreadPool::work(unsigned thread)
+{
+    size_t task = 0;
+    while (!failed && (take(thread, task) || steal(thread, task))) {
+        try {
+            (*current)(task, thread);
+        }
+        catch (...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (error==nullptr)
+                error = std::current_exception();
+            failed = true;
+        }
+    }
+}
+
+bool JsonThreadPool::take(unsigned thread, size_t& task)
+{
+    Queue& queue = queues[thread];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.next>=queue.end)
+        return false;
+    task = queue.next++;
+    return true;
+}
+
+bool JsonThreadPool::steal(unsigned thread, size_t& task)
+{
+    unsigned size = this->size();
+    for (unsigned offset = 1; offset<size; offset++) {
+        Queue& victim = queues[(thread+offset)%size];
+        size_t begin;
+        size_t end;
+        {
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (victim.next>=victim.end)
+                continue;
+            end = victim.end;
+            begin = end-(end-victim.next+1)/2;
+            victim.end = begin;
+        }
+        Queue& queue = queues[thread];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.next = begin+1;
+        queue.end = end;
+        task = begin;
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,123 @@
+#ifndef JSONPARSER_JSONTHREADPOOL_H
+#define JSONPARSER_JSONTHREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Fixed set of threads that run numbered tasks in parallel.
+ * The calling thread works along with the threads of the pool, so a pool of one thread runs everything
+ * on the caller. The tasks of a run are split into a block of consecutive tasks per thread, so every thread
+ * works on its own part of the input. A thread that runs out of tasks steals the second half of the remaining
+ * tasks of another thread, so threads that finish early help out and the slowest tasks do not hold up a run.
+ */
+class JsonThreadPool {
+public:
+
+    /**
+     * A task, called with the number of the task and the number of the thread that runs it.
+     * Thread numbers go from 0 to size()-1, a thread never runs two tasks at the same time.
+     */
+    using Task = std::function<void(size_t task, unsigned thread)>;
+
+    /**
+     * Creates a pool and starts its threads.
+     * @param threads Amount of threads including the caller, 0 to use one per hardware thread.
+     */
+    explicit JsonThreadPool(unsigned threads = 0);
+
+    /**
+     * Stops and joins the threads.
+     */
+    ~JsonThreadPool();
+
+    /**
+     * Deleted copy constructor. Copying is not allowed.
+     */
+    JsonThreadPool(const JsonThreadPool&) = delete;
+
+    /**
+     * Deleted assignment operator. Assigning is not allowed.
+     */
+    JsonThreadPool& operator=(const JsonThreadPool&) = delete;
+
+    /**
+     * Get the amount of threads that run tasks, including the caller.
+     * @return Amount of threads.
+     */
+    unsigned size() const
+    {
+        return static_cast<unsigned>(threads.size())+1;
+    }
+
+    /**
+     * Run tasks 0 to count-1 and wait until all of them are finished.
+     * Runs of different callers are done one after the other. A task must not start a run on the same pool.
+     * If a task throws, no new tasks are started and the exception is passed on once the running tasks
+     * are finished.
+     * @param count Amount of tasks.
+     * @param task Function that runs a task.
+     */
+    void run(size_t count, const Task& task);
+
+private:
+
+    /**
+     * Tasks of one thread that are not started yet.
+     */
+    struct Queue {
+        std::mutex mutex;       /**< Protects the range, the owner takes from the front and thieves from the back*/
+        size_t next = 0;        /**< Next task of the owner*/
+        size_t end = 0;         /**< Past the last task of the owner*/
+    };
+
+    std::vector<std::thread> threads;   /**< Threads of the pool, without the caller*/
+    std::unique_ptr<Queue[]> queues;    /**< Tasks of every thread, including the caller*/
+    std::mutex runMutex;                /**< Held during a run, runs do not overlap*/
+    std::mutex mutex;                   /**< Protects the state of the current run*/
+    std::condition_variable wake;       /**< Signals a new run or stopping to the threads*/
+    std::condition_variable done;       /**< Signals the end of the current run to the caller*/
+    const Task* current;                /**< Task of the current run*/
+    std::atomic<bool> failed;           /**< True if a task of the current run threw, no tasks are started anymore*/
+    size_t generation;                  /**< Amount of runs that were started*/
+    unsigned active;                    /**< Threads that are still working on the current run*/
+    std::exception_ptr error;           /**< First exception thrown by a task of the current run*/
+    bool stopping;                      /**< True if the threads should stop*/
+
+    /**
+     * Main loop of a thread of the pool.
+     * @param thread Number of the thread.
+     */
+    void loop(unsigned thread);
+
+    /**
+     * Take and run tasks of the current run until there are none left.
+     * @param thread Number of the thread.
+     */
+    void work(unsigned thread);
+
+    /**
+     * Take the next task of a thread.
+     * @param thread Number of the thread.
+     * @param task Set to the task.
+     * @return False if the thread has no tasks left.
+     */
+    bool take(unsigned thread, size_t& task);
+
+    /**
+     * Move the second half of the remaining tasks of another thread to a thread, and take the first of them.
+     * @param thread Number of the thread that ran out of tasks.
+     * @param task Set to the task.
+     * @return False if no thread has tasks left.
+     */
+    bool steal(unsigned thread, size_t& task);
+};
+
+#endif //JSONPARSER_JSONTHREADPOOL_H
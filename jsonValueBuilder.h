@@ -0,0 +1,137 @@
+#ifndef JSONPARSER_JSONVALUEBUILDER_H
+#define JSONPARSER_JSONVALUEBUILDER_H
+
+#include <vector>
+#include "jsonParser.h"
+
+/**
+ * Handler that builds the JsonValues of the events of a single value in an arena.
+ * The builder has no other state than the value that is being built, so every thread can use its own builder
+ * and arena to build values in parallel. It is final, so a JsonReader inlines its events. Sources that know the
+ * size of an object or array before its values, like JsonBinary, pass it to startObject or startArray.
+ */
+class JsonValueBuilder final : public JsonHandler {
+private:
+    JsonArena& arena;                   /**< Arena of the values*/
+    std::vector<JsonValue*> unfinished; /**< Unfinished objects and arrays*/
+    JsonStringView pendingKey;          /**< Key of the next member of the current object*/
+    JsonValue* result;                  /**< Outermost value, nullptr until it starts*/
+
+    /**
+     * Adds a new value to the current object or array, or makes it the outermost value.
+     * @param value Value to add.
+     */
+    void add(JsonValue* value)
+    {
+        if (unfinished.empty())
+            result = value;
+        else if (unfinished.back()->isArray())
+            unfinished.back()->addToArray(value);
+        else
+            unfinished.back()->addToObject(value, pendingKey);
+    }
+
+public:
+
+    /**
+     * Creates a builder.
+     * @param arena Arena of the values, must stay alive as long as the builder.
+     */
+    explicit JsonValueBuilder(JsonArena& arena)
+            :arena(arena), result(nullptr)
+    {
+
+    }
+
+    /**
+     * Get the value that was built.
+     * @return The outermost value, nullptr if nothing was read.
+     */
+    JsonValue* value() const
+    {
+        return result;
+    }
+
+    /**
+     * Forget the value that was built (ex. after a parse error), so the next value can be built.
+     * The values stay in the arena.
+     */
+    void reset()
+    {
+        unfinished.clear();
+        result = nullptr;
+    }
+
+    void startObject() override
+    {
+        startObject(0);
+    }
+
+    /**
+     * An object starts whose amount of members is known up front, ex. in a binary snapshot.
+     * @param count Amount of members, the object is allocated with its final size.
+     */
+    void startObject(size_t count)
+    {
+        auto* value = arena.create<JsonValue>(ValueType::JSON_OBJ, &arena);
+        if (count>0)
+            value->getObjectValue().reserve(count);
+        add(value);
+        unfinished.push_back(value);
+    }
+
+    void key(JsonStringView key) override
+    {
+        pendingKey = key;
+    }
+
+    void endObject() override
+    {
+        unfinished.pop_back();
+    }
+
+    void startArray() override
+    {
+        startArray(0);
+    }
+
+    /**
+     * An array starts whose amount of elements is known up front.
+     * @param count Amount of elements, the array is allocated with its final size.
+     */
+    void startArray(size_t count)
+    {
+        auto* value = arena.create<JsonValue>(ValueType::JSON_ARRAY, &arena);
+        if (count>0)
+            value->getArrayValue().reserve(count);
+        add(value);
+        unfinished.push_back(value);
+    }
+
+    void endArray() override
+    {
+        unfinished.pop_back();
+    }
+
+    void string(JsonStringView value) override
+    {
+        add(arena.create<JsonValue>(value, &arena));
+    }
+
+    void number(const JsonNumber& value) override
+    {
+        add(arena.create<JsonValue>(value, &arena));
+    }
+
+    void boolean(bool value) override
+    {
+        add(arena.create<JsonValue>(ValueType::JSON_BOOL, value ? "true" : "false", &arena));
+    }
+
+    void null() override
+    {
+        add(arena.create<JsonValue>(ValueType::JSON_NULL, &arena));
+    }
+};
+
+#endif //JSONPARSER_JSONVALUEBUILDER_H
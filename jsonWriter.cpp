@@ -0,0 +1,263 @@
+#include <algorithm>
+#include <cerrno>
+#include <stdexcept>
+#include "jsonWriter.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#define JSONPARSER_WRITE ::write
+#else
+#include <io.h>
+#define JSONPARSER_WRITE ::_write
+#endif
+
+const size_t JsonWriter::DEFAULT_BUFFER_SIZE;
+const size_t JsonWriter::MIN_BUFFER_SIZE;
+
+JsonWriter::JsonWriter(int fd, int indent, size_t bufferSize)
+        :fd(fd), indent(std::max(0, indent)), capacity(std::max(bufferSize, static_cast<size_t>(MIN_BUFFER_SIZE))),
+         used(0), empty(true), afterKey(false), done(false)
+{
+    buffer.reset(new char[capacity]);
+}
+
+JsonWriter::JsonWriter(FlushFunction function, int indent, size_t bufferSize)
+        :JsonWriter(-1, indent, bufferSize)
+{
+    this->function = std::move(function);
+}
+
+JsonWriter::~JsonWriter()
+{
+    try {
+        flush();
+    }
+    catch (...) {
+        // A destructor can not report the error, flush() does
+    }
+}
+
+JsonWriter& JsonWriter::beginObject()
+{
+    beforeValue();
+    writeChar('{');
+    open.push_back('{');
+    empty = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::endObject()
+{
+    if (open.empty() || open.back()!='{')
+        throw std::invalid_argument("endObject without beginObject");
+    if (afterKey)
+        throw std::invalid_argument("Missing value after key");
+    if (!empty)
+        writeNewLine(open.size()-1);
+    writeChar('}');
+    open.pop_back();
+    empty = false;
+    afterValue();
+    return *this;
+}
+
+JsonWriter& JsonWriter::beginArray()
+{
+    beforeValue();
+    writeChar('[');
+    open.push_back('[');
+    empty = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::endArray()
+{
+    if (open.empty() || open.back()!='[')
+        throw std::invalid_argument("endArray without beginArray");
+    if (!empty)
+        writeNewLine(open.size()-1);
+    writeChar(']');
+    open.pop_back();
+    empty = false;
+    afterValue();
+    return *this;
+}
+
+JsonWriter& JsonWriter::key(JsonStringView key)
+{
+    if (open.empty() || open.back()!='{')
+        throw std::invalid_argument("Key outside of an object");
+    if (afterKey)
+        throw std::invalid_argument("Missing value after key");
+    if (!empty)
+        writeChar(',');
+    empty = false;
+    writeNewLine(open.size());
+    writeString(key);
+    writeChar(':');
+    if (indent>0)
+        writeChar(' ');
+    afterKey = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(JsonStringView string)
+{
+    beforeValue();
+    writeString(string);
+    afterValue();
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(bool boolean)
+{
+    beforeValue();
+    if (boolean)
+        writeText("true", 4);
+    else
+        writeText("false", 5);
+    afterValue();
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(double number)
+{
+    beforeValue();
+    commit(JsonFormat::writeDouble(number, reserve(JsonFormat::MAX_NUMBER_LENGTH)));
+    afterValue();
+    return *this;
+}
+
+JsonWriter& JsonWriter::writeInt64(int64_t integer)
+{
+    beforeValue();
+    commit(JsonFormat::writeInt64(integer, reserve(JsonFormat::MAX_NUMBER_LENGTH)));
+    afterValue();
+    return *this;
+}
+
+JsonWriter& JsonWriter::writeUInt64(uint64_t integer)
+{
+    beforeValue();
+    commit(JsonFormat::writeUInt64(integer, reserve(JsonFormat::MAX_NUMBER_LENGTH)));
+    afterValue();
+    return *this;
+}
+
+JsonWriter& JsonWriter::null()
+{
+    beforeValue();
+    writeText("null", 4);
+    afterValue();
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(const JsonValue& value)
+{
+    if (value.isNull())
+        return null();
+    if (value.isString())
+        return this->value(value.getStringView());
+    // Numbers 0 and 1 are bools as well, so numbers are checked first
+    if (value.isInteger())
+        return value.getNumberValue()<0 ? writeInt64(value.getInt64Value()) : writeUInt64(value.getUInt64Value());
+    if (value.isNumber())
+        return this->value(value.getNumberValue());
+    if (value.isBool())
+        return this->value(value.getBoolValue());
+    if (value.isArray()) {
+        beginArray();
+        for (const JsonValue* element : value.getArrayValue())
+            this->value(*element);
+        return endArray();
+    }
+    beginObject();
+    for (const auto& member : value.getObjectValue())
+        key(member.first).value(*member.second);
+    return endObject();
+}
+
+void JsonWriter::beforeValue()
+{
+    if (open.empty()) {
+        if (done)
+            throw std::invalid_argument("The root value is already complete");
+        return;
+    }
+    if (open.back()=='{') {
+        if (!afterKey)
+            throw std::invalid_argument("Missing key before value in object");
+        afterKey = false;
+        return;
+    }
+    if (!empty)
+        writeChar(',');
+    empty = false;
+    writeNewLine(open.size());
+}
+
+void JsonWriter::writeString(JsonStringView string)
+{
+    if (JsonFormat::maxStringLength(string.size())<=capacity) {
+        commit(JsonFormat::writeString(string, reserve(JsonFormat::maxStringLength(string.size()))));
+        return;
+    }
+    // Escape the string in parts that always fit in the buffer
+    const size_t part = capacity/JsonFormat::maxEscapedLength(1);
+    writeChar('"');
+    for (size_t offset = 0; offset<string.size(); offset += part) {
+        JsonStringView piece = string.substr(offset, part);
+        commit(JsonFormat::writeEscaped(piece, reserve(JsonFormat::maxEscapedLength(piece.size()))));
+    }
+    writeChar('"');
+}
+
+void JsonWriter::writeNewLine(size_t depth)
+{
+    if (indent==0)
+        return;
+    writeChar('\n');
+    // Deep nesting may need more spaces than fit in the buffer
+    for (size_t spaces = static_cast<size_t>(indent)*depth; spaces>0;) {
+        size_t length = std::min(spaces, capacity);
+        memset(reserve(length), ' ', length);
+        used += length;
+        spaces -= length;
+    }
+}
+
+void JsonWriter::flush()
+{
+    if (used==0)
+        return;
+    // The buffer is empty before the text is passed on, so a failure does not pass it on twice
+    size_t length = used;
+    used = 0;
+    if (function)
+        function(buffer.get(), length);
+    else
+        writeAll(fd, buffer.get(), length);
+}
+
+void JsonWriter::finish()
+{
+    if (!done) {
+        if (open.empty())
+            throw std::invalid_argument("Nothing was written");
+        throw std::invalid_argument(open.back()=='{' ? "Unfinished object" : "Unfinished array");
+    }
+    flush();
+}
+
+void JsonWriter::writeAll(int fd, const char* data, size_t length)
+{
+    const char* end = data+length;
+    while (data<end) {
+        auto written = JSONPARSER_WRITE(fd, data, static_cast<unsigned>(std::min<size_t>(end-data, 1u << 30)));
+        if (written<0 && errno==EINTR)
+            continue;
+        if (written<=0)
+            throw std::invalid_argument("Can not write to file descriptor "+std::to_string(fd));
+        data += written;
+    }
+}
@@ -0,0 +1,282 @@
+#ifndef JSONPARSER_JSONWRITER_H
+#define JSONPARSER_JSONWRITER_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <type_traits>
+#include <cstdint>
+#include <cstring>
+#include "jsonParser.h"
+#include "jsonFormat.h"
+
+/**
+ * Writes json text call by call, without building JsonValues first, ex. for large responses.
+ * The text is written into a buffer of a fixed size, a full buffer is passed on to a file descriptor or a
+ * function at once. Strings longer than the buffer are written in parts, so the memory of the writer never
+ * depends on the text. The order of the calls is checked with a stack of the open objects and arrays, a wrong
+ * call throws before anything of it is written. The text is the same as JsonSerializer writes for the same values.
+ * writer.beginObject().key("name").value("animation").key("frames").beginArray().value(1).value(2).endArray()
+ *       .endObject();
+ */
+class JsonWriter {
+public:
+
+    /**
+     * Function that receives the text when the buffer is flushed, the text is only valid during the call.
+     */
+    using FlushFunction = std::function<void(const char* data, size_t length)>;
+
+    static const size_t DEFAULT_BUFFER_SIZE = 64*1024;  /**< Default amount of characters that are flushed at once*/
+    static const size_t MIN_BUFFER_SIZE = 256;          /**< Smallest buffer, larger than any number*/
+
+    /**
+     * Creates a writer that writes to a file descriptor.
+     * @param fd Open file descriptor, ex. of a file, pipe or socket.
+     * @param indent Amount of spaces per level of nesting, 0 for compact text on a single line.
+     * @param bufferSize Amount of characters that are written at once.
+     */
+    explicit JsonWriter(int fd, int indent = 0, size_t bufferSize = DEFAULT_BUFFER_SIZE);
+
+    /**
+     * Creates a writer that passes the text to a function.
+     * @param function Receives the text every time the buffer is flushed.
+     * @param indent Amount of spaces per level of nesting, 0 for compact text on a single line.
+     * @param bufferSize Amount of characters that are passed at once.
+     */
+    explicit JsonWriter(FlushFunction function, int indent = 0, size_t bufferSize = DEFAULT_BUFFER_SIZE);
+
+    /**
+     * Destructor, flushes the text that is still in the buffer. Errors are ignored, use flush() to get them.
+     */
+    ~JsonWriter();
+
+    /**
+     * Deleted copy constructor. Copying is not allowed.
+     */
+    JsonWriter(const JsonWriter&) = delete;
+
+    /**
+     * Deleted assignment operator. Assigning is not allowed.
+     */
+    JsonWriter& operator=(const JsonWriter&) = delete;
+
+    /**
+     * Start an object, as the root, an element of an array or the value of a key.
+     * @throw invalid argument if no value is expected.
+     * @return Reference to this writer.
+     */
+    JsonWriter& beginObject();
+
+    /**
+     * End the innermost object.
+     * @throw invalid argument if the innermost object or array is not an object, or a key has no value.
+     * @return Reference to this writer.
+     */
+    JsonWriter& endObject();
+
+    /**
+     * Start an array, as the root, an element of an array or the value of a key.
+     * @throw invalid argument if no value is expected.
+     * @return Reference to this writer.
+     */
+    JsonWriter& beginArray();
+
+    /**
+     * End the innermost array.
+     * @throw invalid argument if the innermost object or array is not an array.
+     * @return Reference to this writer.
+     */
+    JsonWriter& endArray();
+
+    /**
+     * Write the key of the next member of the innermost object.
+     * @throw invalid argument if the innermost object or array is not an object, or the previous key has no value.
+     * @param key The key.
+     * @return Reference to this writer.
+     */
+    JsonWriter& key(JsonStringView key);
+
+    /**
+     * Write a string value.
+     * @throw invalid argument if no value is expected.
+     * @param string The string.
+     * @return Reference to this writer.
+     */
+    JsonWriter& value(JsonStringView string);
+
+    /**
+     * Write a string value, without taking it for a bool.
+     * @throw invalid argument if no value is expected.
+     * @param string Null terminated string.
+     * @return Reference to this writer.
+     */
+    JsonWriter& value(const char* string)
+    {
+        return value(JsonStringView(string));
+    }
+
+    /**
+     * Write a bool value.
+     * @throw invalid argument if no value is expected.
+     * @param boolean The bool.
+     * @return Reference to this writer.
+     */
+    JsonWriter& value(bool boolean);
+
+    /**
+     * Write an integer value of any integer type.
+     * @throw invalid argument if no value is expected.
+     * @param integer The integer.
+     * @return Reference to this writer.
+     */
+    template<class Integer, typename std::enable_if<std::is_integral<Integer>::value
+                                                    && !std::is_same<Integer, bool>::value, int>::type = 0>
+    JsonWriter& value(Integer integer)
+    {
+        if (std::is_signed<Integer>::value)
+            return writeInt64(static_cast<int64_t>(integer));
+        return writeUInt64(static_cast<uint64_t>(integer));
+    }
+
+    /**
+     * Write a number value, with the fewest digits that read back as the same double.
+     * @throw invalid argument if no value is expected.
+     * @param number The number, infinity and NaN are written as null.
+     * @return Reference to this writer.
+     */
+    JsonWriter& value(double number);
+
+    /**
+     * Write a complete JsonValue, ex. a part of a parsed document.
+     * @throw invalid argument if no value is expected.
+     * @param value The value.
+     * @return Reference to this writer.
+     */
+    JsonWriter& value(const JsonValue& value);
+
+    /**
+     * Write a null value.
+     * @throw invalid argument if no value is expected.
+     * @return Reference to this writer.
+     */
+    JsonWriter& null();
+
+    /**
+     * Check whether the root value is complete.
+     * @return True if the root value is written and all objects and arrays are ended.
+     */
+    bool complete() const
+    {
+        return done;
+    }
+
+    /**
+     * Pass the text in the buffer on, the text does not need to be complete.
+     * @throw invalid argument if writing to the file descriptor fails.
+     */
+    void flush();
+
+    /**
+     * Check that the root value is complete and pass the rest of the text on.
+     * @throw invalid argument if the root value is not complete.
+     * @throw invalid argument if writing to the file descriptor fails.
+     */
+    void finish();
+
+    /**
+     * Write characters to a file descriptor, until all of them are written.
+     * @throw invalid argument if writing fails.
+     * @param fd Open file descriptor.
+     * @param data First character.
+     * @param length Amount of characters.
+     */
+    static void writeAll(int fd, const char* data, size_t length);
+
+private:
+    FlushFunction function;         /**< Receives the text, empty to write to the file descriptor*/
+    int fd;                         /**< File descriptor the text is written to*/
+    int indent;                     /**< Spaces per level of nesting, 0 for compact text*/
+    std::unique_ptr<char[]> buffer; /**< Text that is not passed on yet*/
+    size_t capacity;                /**< Size of the buffer*/
+    size_t used;                    /**< Amount of characters of the buffer that are in use*/
+    std::vector<char> open;         /**< '{' or '[' of every open object and array*/
+    bool empty;                     /**< True if the innermost object or array has no members or elements yet*/
+    bool afterKey;                  /**< True if the innermost object has a key without a value*/
+    bool done;                      /**< True if the root value is complete*/
+
+    /**
+     * Get room at the end of the text, flushing the buffer if needed.
+     * @param length Amount of characters that will be written, at most the capacity.
+     * @return Position of the first character.
+     */
+    char* reserve(size_t length)
+    {
+        if (used+length>capacity)
+            flush();
+        return buffer.get()+used;
+    }
+
+    /**
+     * Add the characters written after a reserve to the text.
+     * @param end Position after the last written character.
+     */
+    void commit(const char* end)
+    {
+        used = static_cast<size_t>(end-buffer.get());
+    }
+
+    /**
+     * Add one character to the text.
+     * @param c The character.
+     */
+    void writeChar(char c)
+    {
+        *reserve(1) = c;
+        used++;
+    }
+
+    /**
+     * Add characters to the text as they are, at most the capacity.
+     * @param text First character.
+     * @param length Amount of characters.
+     */
+    void writeText(const char* text, size_t length)
+    {
+        memcpy(reserve(length), text, length);
+        used += length;
+    }
+
+    /**
+     * Check that a value may be written and write the separator in front of it.
+     * @throw invalid argument if no value is expected.
+     */
+    void beforeValue();
+
+    /**
+     * Mark the root value complete if the value that was just written is the root.
+     */
+    void afterValue()
+    {
+        if (open.empty())
+            done = true;
+    }
+
+    JsonWriter& writeInt64(int64_t integer);
+    JsonWriter& writeUInt64(uint64_t integer);
+
+    /**
+     * Write a string with quotes, in parts if it does not fit in the buffer.
+     * @param string The string.
+     */
+    void writeString(JsonStringView string);
+
+    /**
+     * Start a new line that is indented for a level of nesting, nothing is written for compact text.
+     * @param depth Level of nesting.
+     */
+    void writeNewLine(size_t depth);
+};
+
+#endif //JSONPARSER_JSONWRITER_H
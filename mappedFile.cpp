@@ -0,0 +1,114 @@
+#include <stdexcept>
+#include <fstream>
+#include "mappedFile.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define JSONPARSER_USE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile()
+        :m_data(nullptr), m_size(0), m_mapped(false)
+{
+
+}
+
+MappedFile::MappedFile(const std::string& file_name, Access access)
+        :MappedFile()
+{
+    open(file_name, access);
+}
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+        :m_data(other.m_data), m_size(other.m_size), m_mapped(other.m_mapped)
+{
+    other.m_data = nullptr;
+    other.m_size = 0;
+    other.m_mapped = false;
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this==&other)
+        return *this;
+    close();
+    m_data = other.m_data;
+    m_size = other.m_size;
+    m_mapped = other.m_mapped;
+    other.m_data = nullptr;
+    other.m_size = 0;
+    other.m_mapped = false;
+    return *this;
+}
+
+void MappedFile::open(const std::string& file_name, Access access)
+{
+    close();
+
+#ifdef JSONPARSER_USE_MMAP
+    int fd = ::open(file_name.c_str(), O_RDONLY);
+    if (fd<0)
+        throw std::invalid_argument("File not found '"+file_name+'\'');
+
+    struct stat info{};
+    if (fstat(fd, &info)!=0) {
+        ::close(fd);
+        throw std::invalid_argument("Can not read file '"+file_name+'\'');
+    }
+
+    // Mapping an empty file is not allowed, there is nothing to read anyway
+    if (info.st_size>0) {
+        size_t size = static_cast<size_t>(info.st_size);
+        void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping==MAP_FAILED) {
+            ::close(fd);
+            throw std::invalid_argument("Can not map file '"+file_name+'\'');
+        }
+        madvise(mapping, size, access==RANDOM ? MADV_RANDOM : MADV_SEQUENTIAL);
+        m_data = static_cast<const char*>(mapping);
+        m_size = size;
+        m_mapped = true;
+    }
+    // The mapping stays valid after closing the descriptor
+    ::close(fd);
+#else
+    std::ifstream file(file_name, std::ios::binary);
+    if (!file.is_open())
+        throw std::invalid_argument("File not found '"+file_name+'\'');
+
+    file.seekg(0, std::ios::end);
+    std::streamoff size = file.tellg();
+    if (size>0) {
+        char* buffer = new char[static_cast<size_t>(size)];
+        file.seekg(0, std::ios::beg);
+        file.read(buffer, size);
+        m_data = buffer;
+        m_size = static_cast<size_t>(file.gcount());
+    }
+#endif
+}
+
+void MappedFile::close()
+{
+    if (m_data!=nullptr) {
+#ifdef JSONPARSER_USE_MMAP
+        if (m_mapped)
+            munmap(const_cast<char*>(m_data), m_size);
+        else
+            delete[] m_data;
+#else
+        delete[] m_data;
+#endif
+    }
+    m_data = nullptr;
+    m_size = 0;
+    m_mapped = false;
+}
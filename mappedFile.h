@@ -0,0 +1,102 @@
+#ifndef JSONPARSER_MAPPEDFILE_H
+#define JSONPARSER_MAPPEDFILE_H
+
+#include <string>
+#include <cstddef>
+
+/**
+ * Read-only view of a complete file.
+ * On POSIX systems the file is memory mapped, so the contents are never copied and pages are only
+ * loaded when they are read. Other systems fall back to reading the file into memory.
+ * The contents stay valid until the MappedFile is closed or destructed.
+ */
+class MappedFile {
+private:
+    const char* m_data;     /**< Start of the file contents*/
+    size_t m_size;          /**< Size of the file in bytes*/
+    bool m_mapped;          /**< True if m_data is a memory mapping, false if it is a heap buffer*/
+
+public:
+
+    /**
+     * How the contents will be read, a hint for the operating system which pages to load ahead.
+     */
+    enum Access {
+        SEQUENTIAL,     /**< From start to end, ex. when parsing. Pages are read ahead*/
+        RANDOM          /**< Scattered, ex. looking up values in a JsonImage. Only the touched pages are loaded*/
+    };
+
+    /**
+     * Default constructor. Creates an empty, closed file.
+     */
+    MappedFile();
+
+    /**
+     * Creates a MappedFile and immediately opens a file.
+     * @throw invalid argument if the file can not be opened.
+     * @param file_name Path to the file.
+     * @param access How the contents will be read.
+     */
+    explicit MappedFile(const std::string& file_name, Access access = SEQUENTIAL);
+
+    /**
+     * Destructor, releases the mapping.
+     */
+    ~MappedFile();
+
+    /**
+     * Move constructor. The other file will be closed.
+     * @param other File to take the mapping from.
+     */
+    MappedFile(MappedFile&& other) noexcept;
+
+    /**
+     * Move assignment operator. The current mapping is released, the other file will be closed.
+     * @param other File to take the mapping from.
+     * @return reference to this object.
+     */
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    /**
+     * Deleted copy constructor. Copying is not allowed.
+     */
+    MappedFile(const MappedFile&) = delete;
+
+    /**
+     * Deleted assignment operator. Assigning is not allowed.
+     */
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * Opens a file. A previously opened file is closed first.
+     * @throw invalid argument if the file can not be opened.
+     * @param file_name Path to the file.
+     * @param access How the contents will be read.
+     */
+    void open(const std::string& file_name, Access access = SEQUENTIAL);
+
+    /**
+     * Releases the mapping. All pointers into the file become invalid.
+     */
+    void close();
+
+    /**
+     * Get the contents of the file.
+     * @return Start of the file contents, not null terminated.
+     */
+    const char* data() const
+    {
+        return m_data;
+    }
+
+    /**
+     * Get the size of the file.
+     * @return Size of the file in bytes.
+     */
+    size_t size() const
+    {
+        return m_size;
+    }
+};
+
+#endif //JSONPARSER_MAPPEDFILE_H
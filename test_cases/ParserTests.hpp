@@ -6,5 +6,26 @@
 #include "complex/complexExamples.h"
 #include "null/null.hpp"
 #include "array/arrays.hpp"
+#include "buffer/buffer.hpp"
+#include "arena/arena.hpp"
+#include "tape/tape.hpp"
+#include "structural/structural.hpp"
+#include "number/numbers.hpp"
+#include "object/objects.hpp"
+#include "document/documents.hpp"
+#include "reader/reader.hpp"
+#include "push/push.hpp"
+#include "lines/lines.hpp"
+#include "parallel/parallel.hpp"
+#include "loader/loader.hpp"
+#include "serializer/serializer.hpp"
+#include "writer/writer.hpp"
+#include "pointer/pointer.hpp"
+#include "query/query.hpp"
+#include "projection/projection.hpp"
+#include "ownership/ownership.hpp"
+#include "frozen/frozen.hpp"
+#include "binary/binary.hpp"
+#include "image/image.hpp"
 
 #endif //JSONPARSER_PARSERTESTS_HPP
@@ -0,0 +1,6 @@
+#ifndef JSONPARSER_ARENA_HPP
+#define JSONPARSER_ARENA_HPP
+
+#include "arenaTests.h"
+
+#endif //JSONPARSER_ARENA_HPP
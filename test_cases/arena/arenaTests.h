@@ -0,0 +1,64 @@
+#ifndef JSONPARSER_ARENATESTS_H
+#define JSONPARSER_ARENATESTS_H
+
+#include "../BaseTest.h"
+
+TEST_F(ValueTests, ArenaAllocate) // NOLINT
+{
+    JsonArena arena;
+    EXPECT_EQ(arena.blockCount(), 0);
+
+    auto* c = static_cast<char*>(arena.allocate(1, 1));
+    auto* d = static_cast<double*>(arena.allocate(sizeof(double), alignof(double)));
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(d) % alignof(double), 0);
+    EXPECT_GT(reinterpret_cast<char*>(d), c);
+    EXPECT_EQ(arena.blockCount(), 1);
+
+    // Large allocations get a block of their own
+    arena.allocate(1024*1024*4);
+    EXPECT_EQ(arena.blockCount(), 2);
+
+    char* copy = arena.copyString("walk_right", 10);
+    EXPECT_STREQ(copy, "walk_right");
+
+    arena.release();
+    EXPECT_EQ(arena.blockCount(), 0);
+}
+
+TEST_F(ValueTests, ArenaValues) // NOLINT
+{
+    JsonArena arena;
+    auto* object = arena.create<JsonValue>(ValueType::JSON_OBJ, &arena);
+    auto* array = arena.create<JsonValue>(ValueType::JSON_ARRAY, &arena);
+    object->addToObject(array, "a key that is too long for the small string buffer");
+    array->addToArray(arena.create<JsonValue>(ValueType::JSON_STRING, "a value that is too long as well", &arena));
+    array->addToArray(arena.create<JsonValue>(ValueType::JSON_NUM, "3", &arena));
+
+    // Heap values added to arena values are owned by the arena
+    array->addToArray(new JsonValue(ValueType::JSON_STRING, "heap"));
+
+    JsonValue& found = (*object)["a key that is too long for the small string buffer"];
+    ASSERT_EQ(found.getArrayValue().size(), 3);
+    EXPECT_STREQ(found[0].getStringValue().c_str(), "a value that is too long as well");
+    EXPECT_EQ(found[1].getNumberValue(), 3);
+    EXPECT_STREQ(found[2].getStringValue().c_str(), "heap");
+
+    // Copies of arena containers are allocated on the heap
+    JsonArray copy = found.getArrayValue();
+    EXPECT_EQ(copy.get_allocator().arena(), nullptr);
+    EXPECT_EQ(found.getArrayValue().get_allocator().arena(), &arena);
+}
+
+TEST_F(ParserTests, ArenaParserReuse) // NOLINT
+{
+    JsonParser& json = *parser;
+    json.parse(TEST_PATH "complex/animation.json");
+    json["animations"].addToArray(new JsonValue(ValueType::JSON_BOOL, "true"));
+    EXPECT_TRUE(json["animations"][2].getBoolValue());
+
+    json.parse(TEST_PATH "complex/objectarray.json");
+    EXPECT_FALSE(json.hasKey("animations"));
+    EXPECT_STREQ(json["array"][1]["name"].getStringValue().c_str(), "object2");
+}
+
+#endif //JSONPARSER_ARENATESTS_H
@@ -240,16 +240,16 @@ TEST_F(ValueTests, NumberValueInvalid)  // NOLINT(cert-err58-cpp)
     try {
         auto val = JsonValue(ValueType::JSON_NUM, "");
         val.getNumberValue();
-        FAIL() << "Expected std::invalid_argument (stod)";
+        FAIL() << "Expected std::invalid_argument";
     }
-    MY_CATCH("stod", std::invalid_argument)
+    MY_CATCH("Incorrect number format: ''", std::invalid_argument)
 
     try {
         auto val = JsonValue(ValueType::JSON_NUM, "flapdrol");
         val.getNumberValue();
-        FAIL() << "Expected std::invalid_argument (stod)";
+        FAIL() << "Expected std::invalid_argument";
     }
-    MY_CATCH("stod", std::invalid_argument)
+    MY_CATCH("Incorrect number format: 'flapdrol'", std::invalid_argument)
 
     try {
         auto val = JsonValue(ValueType::JSON_BOOL, "1");
@@ -0,0 +1,6 @@
+#ifndef JSONPARSER_BINARY_HPP
+#define JSONPARSER_BINARY_HPP
+
+#include "binaryTests.h"
+
+#endif //JSONPARSER_BINARY_HPP
@@ -0,0 +1,161 @@
+#ifndef JSONPARSER_BINARYTESTS_H
+#define JSONPARSER_BINARYTESTS_H
+
+#include <algorithm>
+#include <cstdio>
+#include <dirent.h>
+#include <fstream>
+#include <sys/stat.h>
+#include <vector>
+#include "../BaseTest.h"
+#include "../../jsonBinary.h"
+#include "../../jsonLoader.h"
+#include "../../jsonFrozenDocument.h"
+
+#define BINARY_FILE "binary_snapshot.ejsb"
+
+/**
+ * Write bytes to a file as they are.
+ */
+static void writeBytes(const std::string& file_name, const std::string& bytes)
+{
+    std::ofstream file(file_name, std::ios::binary | std::ios::trunc);
+    file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+/**
+ * Directories of the test input, sorted, so new categories of test files are round tripped as well.
+ */
+static std::vector<std::string> testDirectories()
+{
+    std::vector<std::string> directories;
+    DIR* entries = opendir(TEST_PATH);
+    if (entries==nullptr)
+        return directories;
+    for (dirent* entry = readdir(entries); entry!=nullptr; entry = readdir(entries)) {
+        std::string name = entry->d_name;
+        struct stat info{};
+        if (name!="." && name!=".." && stat((TEST_PATH+name).c_str(), &info)==0 && S_ISDIR(info.st_mode))
+            directories.push_back(TEST_PATH+name);
+    }
+    closedir(entries);
+    std::sort(directories.begin(), directories.end());
+    return directories;
+}
+
+TEST_F(ParserTests, BinaryRoundTrip) // NOLINT
+{
+    // Every document of the test input, the files that are not valid json can not be saved
+    JsonLoader loader(2);
+    size_t documents = 0;
+    const std::vector<std::string> directories = testDirectories();
+    EXPECT_GE(directories.size(), 10u);
+    for (const std::string& directory : directories) {
+        for (JsonLoadResult& result : loader.loadDirectory(directory, "")) {
+            if (!result.ok())
+                continue;
+            documents++;
+            result.document->save(BINARY_FILE);
+            parser->loadBinary(BINARY_FILE);
+            EXPECT_EQ(parser->dump(), result.document->dump()) << result.path;
+            // Objects and arrays are allocated with their final size instead of growing, only the root object
+            // is built inside a JsonValue
+            EXPECT_LE(parser->memoryUsage(), result.document->memoryUsage()+sizeof(JsonValue)) << result.path;
+        }
+    }
+    EXPECT_GE(documents, 14u);
+
+    // Exact integers, doubles and strings with escapes and null characters
+    const std::string text = R"({"int": -9223372036854775808, "uint": 18446744073709551615, "double": 0.1,)"
+                             R"( "big": 1e300, "escaped": "tab\t quote\" null\u0000 end", "": [[], {}, null]})";
+    parser->parseString(text);
+    const std::string expected = parser->dump();
+    parser->save(BINARY_FILE);
+    parser->loadBinary(BINARY_FILE);
+    EXPECT_EQ(parser->dump(), expected);
+    EXPECT_EQ((*parser)["int"].getInt64Value(), INT64_MIN);
+    EXPECT_EQ((*parser)["uint"].getUInt64Value(), UINT64_MAX);
+    EXPECT_EQ((*parser)["double"].getNumberValue(), 0.1);
+    EXPECT_EQ((*parser)["escaped"].getStringView().size(), 21u);
+
+    // A frozen document writes the same snapshot
+    parser->parseString(text);
+    parser->freeze().save(BINARY_FILE);
+    parser->loadBinary(BINARY_FILE);
+    EXPECT_EQ(parser->dump(), expected);
+    std::remove(BINARY_FILE);
+}
+
+TEST_F(ParserTests, BinaryLayout) // NOLINT
+{
+    JsonObject empty;
+    EXPECT_EQ(JsonBinary::encode(empty), std::string("EJSB\x01\0\0\0\0\0\0\0\x08\0\0\0\0", 17));
+
+    const char expected[] = "EJSB\x01\0\0\0"     // header
+                            "\x02\0\0\0"         // two strings
+                            "\x01\0\0\0" "a"
+                            "\x01\0\0\0" "b"
+                            "\x08\x02\0\0\0"     // root object with two members
+                            "\0\0\0\0\x07\x03\0\0\0"     // "a": array of three elements
+                            "\x03\x01\0\0\0\0\0\0\0"     // 1
+                            "\x06\0\0\0\0"               // "a"
+                            "\x02"                       // true
+                            "\x01\0\0\0\x06\0\0\0\0";    // "b": "a"
+    parser->parseString(R"({"a": [1, "a", true], "b": "a"})");
+    JsonFrozenDocument document = parser->freeze();
+    EXPECT_EQ(JsonBinary::encode(document.root()), std::string(expected, sizeof(expected)-1));
+}
+
+TEST_F(ParserTests, BinaryErrors) // NOLINT
+{
+    try {
+        parser->save(BINARY_FILE);
+        FAIL() << "Expected std::invalid_argument";
+    }
+    MY_CATCH("JsonParser is empty", std::invalid_argument)
+    try {
+        parser->loadBinary(TEST_PATH "missing.ejsb");
+        FAIL() << "Expected std::invalid_argument";
+    }
+    MY_CATCH("File not found '" TEST_PATH "missing.ejsb'", std::invalid_argument)
+
+    // Every truncated snapshot is rejected
+    parser->parseString(R"({"name": "walk", "frames": [1, 2.5, {"loop": false}], "extra": null})");
+    const std::string snapshot = JsonBinary::encode(parser->freeze().root());
+    JsonHandler ignore;
+    for (size_t length = 0; length<snapshot.size(); length++) {
+        try {
+            JsonBinary::decode(snapshot.data(), length, ignore);
+            FAIL() << "Expected std::invalid_argument for length " << length;
+        }
+        catch (const std::invalid_argument&) {
+        }
+    }
+    JsonBinary::decode(snapshot.data(), snapshot.size(), ignore);
+
+    const std::pair<std::string, const char*> corrupt[] = {
+            {"EJSX", "Invalid binary json: missing header"},
+            {std::string("EJSB\x02\0\0\0", 8), "Invalid binary json: unsupported version"},
+            {std::string("EJSB\x01\0\0\0\0\0\0\0\x07\0\0\0\0", 17), "Invalid binary json: the root is not an object"},
+            {std::string("EJSB\x01\0\0\0\0\0\0\0\x08\x01\0\0\0\0\0\0\0", 21),
+             "Invalid binary json: string index out of range"},
+            {std::string("EJSB\x01\0\0\0\x01\0\0\0\0\0\0\0\x08\x01\0\0\0\0\0\0\0\x09", 26),
+             "Invalid binary json: unknown type 9"},
+            {std::string("EJSB\x01\0\0\0\x01\0\0\0\0\0\0\0\x08\x02\0\0\0\0\0\0\0\0\0\0\0\0\0", 31),
+             "Duplicate key: ''"},
+            {std::string("EJSB\x01\0\0\0\0\0\0\0\x08\0\0\0\0\0", 18),
+             "Invalid binary json: data after the root object"},
+            {std::string("EJSB\x01\0\0\0\xff\xff\xff\xff", 12), "Invalid binary json: unexpected end of data"},
+    };
+    for (const auto& entry : corrupt) {
+        writeBytes(BINARY_FILE, entry.first);
+        try {
+            parser->loadBinary(BINARY_FILE);
+            FAIL() << "Expected std::invalid_argument";
+        }
+        MY_CATCH(entry.second, std::invalid_argument)
+    }
+    std::remove(BINARY_FILE);
+}
+
+#endif //JSONPARSER_BINARYTESTS_H
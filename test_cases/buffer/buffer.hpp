@@ -0,0 +1,7 @@
+#ifndef JSONPARSER_BUFFER_HPP
+#define JSONPARSER_BUFFER_HPP
+
+#include "parseString.h"
+#include "mappedFile.h"
+
+#endif //JSONPARSER_BUFFER_HPP
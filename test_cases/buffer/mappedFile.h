@@ -0,0 +1,49 @@
+#ifndef JSONPARSER_MAPPEDFILE_TEST_H
+#define JSONPARSER_MAPPEDFILE_TEST_H
+
+#include "../BaseTest.h"
+
+TEST_F(ParserTests, MappedAnimation) // NOLINT
+{
+    std::string file = TEST_PATH "complex/animation.json";
+    JsonParser& json = *parser;
+    json.parseMapped(file);
+    EXPECT_STREQ(json["file"].getStringValue().c_str(), "animation.png");
+    EXPECT_EQ(json["tile_size"]["width"].getNumberValue(), 32);
+    ASSERT_EQ(json["animations"].getArrayValue().size(), 2);
+    EXPECT_STREQ(json["animations"][1]["name"].getStringValue().c_str(), "idle_front");
+
+    // Parsing again releases the previous mapping
+    json.parseMapped(TEST_PATH "basics/empty.json");
+    EXPECT_FALSE(json.hasKey("file"));
+}
+
+TEST_F(ParserTests, MappedFileErrors) // NOLINT
+{
+    try {
+        parser->parseMapped(TEST_PATH "does_not_exist.json");
+        FAIL() << "Expected std::invalid_argument";
+    }
+    MY_CATCH("File not found './test_input/does_not_exist.json'", std::invalid_argument)
+
+    try {
+        parser->parseMapped(TEST_PATH "string/string5.json");
+        FAIL() << "Expected ParseError";
+    }
+    MY_CATCH("Error at line 2:\n|\nmiauw\nUnexpected token: 'm'", ParseError)
+}
+
+TEST_F(ValueTests, MappedFileContents) // NOLINT
+{
+    MappedFile file(TEST_PATH "string/string1.json");
+    ASSERT_EQ(file.size(), 22);
+    EXPECT_EQ(std::string(file.data(), file.size()), "{\n  \"string\": \"test\"\n}");
+
+    MappedFile moved(std::move(file));
+    EXPECT_EQ(file.data(), nullptr);
+    EXPECT_EQ(moved.size(), 22);
+    moved.close();
+    EXPECT_EQ(moved.size(), 0);
+}
+
+#endif //JSONPARSER_MAPPEDFILE_TEST_H
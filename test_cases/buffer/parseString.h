@@ -0,0 +1,103 @@
+#ifndef JSONPARSER_PARSESTRING_H
+#define JSONPARSER_PARSESTRING_H
+
+#include "../BaseTest.h"
+#define BUFFER_PATH TEST_PATH "buffer/"
+
+TEST_F(ParserTests, ParseStringMinified) // NOLINT
+{
+    JsonParser& json = *parser;
+    json.parseString(R"({"a":[1,{"b":"c"},[true,null]],"d":{"e":-2.5e1},"f":false})");
+    EXPECT_EQ(json["a"][0].getNumberValue(), 1);
+    EXPECT_STREQ(json["a"][1]["b"].getStringValue().c_str(), "c");
+    EXPECT_TRUE(json["a"][2][0].getBoolValue());
+    EXPECT_TRUE(json["a"][2][1].isNull());
+    EXPECT_EQ(json["d"]["e"].getNumberValue(), -25);
+    EXPECT_FALSE(json["f"].getBoolValue());
+}
+
+TEST_F(ParserTests, ParseBuffer) // NOLINT
+{
+    // Buffer is not null terminated, only the first part is parsed
+    const char data[] = {'{', '"', 'k', '"', ':', '1', '}', 'x', 'x'};
+    JsonParser& json = *parser;
+    json.parse(data, 7);
+    EXPECT_EQ(json["k"].getNumberValue(), 1);
+}
+
+TEST_F(ParserTests, CommaOnNextLine) // NOLINT
+{
+    std::string file = BUFFER_PATH "comma.json";
+    JsonParser& json = *parser;
+    json.parse(file);
+    EXPECT_TRUE(json["value1"].getBoolValue());
+    EXPECT_FALSE(json["value2"].getBoolValue());
+    ASSERT_EQ(json["array"].getArrayValue().size(), 3);
+    EXPECT_STREQ(json["array"][2].getStringValue().c_str(), "three");
+}
+
+TEST_F(ParserTests, EscapedStrings) // NOLINT
+{
+    JsonParser& json = *parser;
+    json.parseString(R"({"quote": "say \"hi\"", "path": "a\\b\/c", "unicode": "é😀", "tab": "\t"})");
+    EXPECT_STREQ(json["quote"].getStringValue().c_str(), "say \"hi\"");
+    EXPECT_STREQ(json["path"].getStringValue().c_str(), "a\\b/c");
+    EXPECT_STREQ(json["unicode"].getStringValue().c_str(), "\xC3\xA9\xF0\x9F\x98\x80");
+    EXPECT_STREQ(json["tab"].getStringValue().c_str(), "\t");
+}
+
+TEST_F(ParserTests, LongSingleLine) // NOLINT
+{
+    // Quadratic parsing would make this test take minutes
+    std::string text = "{\"array\": [";
+    for (int i = 0; i<200000; i++)
+        text += "{\"id\":"+std::to_string(i)+",\"name\":\"walk_right\"},";
+    text += "null]}";
+
+    JsonParser& json = *parser;
+    json.parseString(text);
+    ASSERT_EQ(json["array"].getArrayValue().size(), 200001);
+    EXPECT_EQ(json["array"][199999]["id"].getNumberValue(), 199999);
+    EXPECT_TRUE(json["array"][200000].isNull());
+}
+
+TEST_F(ParserTests, BufferErrors) // NOLINT
+{
+    try {
+        parser->parseString("{\n  \"a\": 1\n  \"b\": 2\n}");
+        FAIL() << "Expected ParseError";
+    }
+    MY_CATCH("Error at line 3:\n|\n\"b\": 2\nMissing ','", ParseError)
+
+    try {
+        parser->parseString("{\"a\": [1, 2}");
+        FAIL() << "Expected ParseError";
+    }
+    MY_CATCH("Error at line 1:\n|\n}\nUnexpected token: '}'", ParseError)
+
+    try {
+        parser->parseString("{\"a\": [1, 2]");
+        FAIL() << "Expected ParseError";
+    }
+    MY_CATCH("Error at line 1:\n|\nEND OF FILE\nUnbalanced {}", ParseError)
+
+    try {
+        parser->parseString("{\"a\": \"open}");
+        FAIL() << "Expected ParseError";
+    }
+    MY_CATCH("Error at line 1: Missing closing \"", ParseError)
+
+    try {
+        parser->parseString("{\"a\": 1.2.3}");
+        FAIL() << "Expected ParseError";
+    }
+    MY_CATCH("Error at line 1:\n|\n1.2.3}\nIncorrect number format", ParseError)
+
+    try {
+        parser->parseString("[1, 2]");
+        FAIL() << "Expected ParseError";
+    }
+    MY_CATCH("Error at line 1:\n|\n[1, 2]\nMissing root '{'", ParseError)
+}
+
+#endif //JSONPARSER_PARSESTRING_H
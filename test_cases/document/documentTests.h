@@ -0,0 +1,152 @@
+#ifndef JSONPARSER_DOCUMENTTESTS_H
+#define JSONPARSER_DOCUMENTTESTS_H
+
+#include "../BaseTest.h"
+#include "../../jsonDocument.h"
+
+TEST_F(ValueTests, DocumentAnimation) // NOLINT
+{
+    JsonDocument document(TEST_PATH "complex/animation.json");
+
+    EXPECT_EQ(document["file"].getStringView(), "animation.png");
+    EXPECT_EQ(document["tile_size"]["width"].getInt64Value(), 32);
+    EXPECT_EQ(document["border"].getNumberValue(), 1);
+    ASSERT_TRUE(document["animations"].isArray());
+    ASSERT_EQ(document["animations"].size(), 2);
+
+    JsonLazyValue animation = document["animations"][1];
+    EXPECT_EQ(animation["name"].getStringValue(), "idle_front");
+    EXPECT_TRUE(animation["loop"].getBoolValue());
+    EXPECT_FALSE(animation["pingpong"].getBoolValue());
+    EXPECT_EQ(animation["frame_time"].getNumberValue(), 0.8);
+    EXPECT_TRUE(animation.hasKey("default"));
+    EXPECT_FALSE(animation.hasKey("missing"));
+
+    std::vector<std::string> keys;
+    for (auto it = document.root().begin(); it!=document.root().end(); ++it)
+        keys.emplace_back(it.key());
+    std::vector<std::string> expected{"file", "tile_size", "border", "type", "number_of_animations", "animations",
+                                      "transitions"};
+    EXPECT_EQ(keys, expected);
+
+    double frameTimes = 0;
+    for (JsonLazyValue value : document["animations"])
+        frameTimes += value["frame_time"].getNumberValue();
+    EXPECT_DOUBLE_EQ(frameTimes, 1.0);
+}
+
+TEST_F(ValueTests, DocumentSkipsUntouchedValues) // NOLINT
+{
+    // Only the path to the requested value is read, the broken values around it are skipped
+    JsonDocument document;
+    document.parseString(R"({"broken": [1.2.3, tru, {"a" "b"}], "text": "a \"quoted\" ]}",)"
+                         R"( "wanted": {"skip": "'}'", "value": 'single' }, "after": 1 2})");
+
+    EXPECT_EQ(document["wanted"]["value"].getStringView(), "single");
+    EXPECT_EQ(document["text"].getStringView(), "a \"quoted\" ]}");
+    EXPECT_EQ(document["wanted"]["skip"].getStringValue(), "'}'");
+
+    EXPECT_THROW(document["broken"][0].getNumberValue(), ParseError);
+    EXPECT_THROW(document["broken"][1].getBoolValue(), ParseError);
+    EXPECT_THROW(document["broken"][2]["a"], ParseError);
+
+    try {
+        document["wanted"]["missing"];
+        FAIL() << "Expected std::invalid_argument";
+    }
+    MY_CATCH("Did not find key 'missing' in JsonObject", std::invalid_argument)
+
+    // Looking for a key that does not exist reads up to the end of the object
+    EXPECT_THROW(document["missing"], ParseError);
+}
+
+TEST_F(ValueTests, DocumentEscapedKeys) // NOLINT
+{
+    JsonDocument document;
+    document.parseString(R"({"tab\tkey": 1, "unicode é": [true, null, -5]})");
+
+    EXPECT_EQ(document["tab\tkey"].getUInt64Value(), 1);
+    JsonLazyValue array = document["unicode \xC3\xA9"];
+    EXPECT_TRUE(array[1].isNull());
+    EXPECT_TRUE(array[2].isInteger());
+    EXPECT_EQ(array[2].getInt64Value(), -5);
+
+    auto it = document.root().begin();
+    EXPECT_EQ(it.keyView(), "tab\tkey");
+    ++it;
+    EXPECT_EQ(it.keyView(), "unicode \xC3\xA9");
+    ++it;
+    EXPECT_EQ(it, document.root().end());
+
+    try {
+        array[3];
+        FAIL() << "Expected std::invalid_argument";
+    }
+    MY_CATCH("Index out of range, got [3], max is [2]", std::invalid_argument)
+
+    // Escaped strings are resolved once, reading them again does not grow the document
+    document.parseString(R"({"escaped\n": "line\nbreak"})");
+    JsonStringView value = document["escaped\n"].getStringView();
+    EXPECT_EQ(value, "line\nbreak");
+    EXPECT_EQ(document["escaped\n"].getStringView().data(), value.data());
+    EXPECT_EQ(document.root().begin().keyView().data(), document.root().begin().keyView().data());
+}
+
+TEST_F(ValueTests, DocumentMaterialize) // NOLINT
+{
+    JsonDocument document;
+    document.parseString(R"({"ignored": [[[[]]]], "object": {"list": [1, "two", {"three": 3.5}]}})");
+
+    JsonValue& object = document["object"].materialize();
+    ASSERT_TRUE(object.isObject());
+    EXPECT_EQ(object["list"][0].getInt64Value(), 1);
+    EXPECT_EQ(object["list"][1].getStringView(), "two");
+    EXPECT_EQ(object["list"][2]["three"].getNumberValue(), 3.5);
+    EXPECT_EQ(&document["object"].materialize(), &object);
+
+    document.parseString(R"({"object": {"list": [1, 2,]}})");
+    try {
+        document["object"].materialize();
+        FAIL() << "Expected ParseError";
+    }
+    MY_CATCH("Error at line 1: Expected new object after ','", ParseError)
+}
+
+TEST_F(ValueTests, DocumentErrors) // NOLINT
+{
+    JsonDocument document;
+    try {
+        document.parseString("[1, 2]");
+        FAIL() << "Expected ParseError";
+    }
+    MY_CATCH("Error at line 1:\n|\n[1, 2]\nMissing root '{'", ParseError)
+
+    try {
+        document.root();
+        FAIL() << "Expected std::invalid_argument";
+    }
+    MY_CATCH("JsonDocument is empty", std::invalid_argument)
+
+    document.parseString("{\"a\": [1, 2,\n\"b\": 3}");
+    try {
+        document["b"];
+        FAIL() << "Expected ParseError";
+    }
+    MY_CATCH("Error at line 2:\n|\nEND OF FILE\nUnbalanced {}", ParseError)
+
+    document.parseString(R"({"a": 1 "b": 2})");
+    EXPECT_EQ(document["a"].getInt64Value(), 1);
+    try {
+        document["b"];
+        FAIL() << "Expected ParseError";
+    }
+    MY_CATCH("Error at line 1:\n|\n\"b\": 2}\nMissing ','", ParseError)
+
+    try {
+        document["a"]["key"];
+        FAIL() << "Expected std::invalid_argument";
+    }
+    MY_CATCH("Object is not of type JsonObject", std::invalid_argument)
+}
+
+#endif //JSONPARSER_DOCUMENTTESTS_H
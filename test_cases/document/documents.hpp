@@ -0,0 +1,6 @@
+#ifndef JSONPARSER_DOCUMENTS_HPP
+#define JSONPARSER_DOCUMENTS_HPP
+
+#include "documentTests.h"
+
+#endif //JSONPARSER_DOCUMENTS_HPP
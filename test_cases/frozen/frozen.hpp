@@ -0,0 +1,6 @@
+#ifndef JSONPARSER_FROZEN_HPP
+#define JSONPARSER_FROZEN_HPP
+
+#include "frozenTests.h"
+
+#endif //JSONPARSER_FROZEN_HPP
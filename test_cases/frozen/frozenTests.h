@@ -0,0 +1,189 @@
+#ifndef JSONPARSER_FROZENTESTS_H
+#define JSONPARSER_FROZENTESTS_H
+
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <type_traits>
+#include "../BaseTest.h"
+#include "../../jsonFrozenDocument.h"
+#include "../../jsonPointer.h"
+#include "../../jsonQuery.h"
+
+TEST_F(ParserTests, FrozenTakesOverParser) // NOLINT
+{
+    parser->parse(TEST_PATH "complex/animation.json");
+    const std::string text = parser->dump();
+    const size_t memory = parser->memoryUsage();
+
+    JsonFrozenDocument document = parser->freeze();
+    EXPECT_EQ(document.dump(), text);
+    EXPECT_EQ(document.memoryUsage(), memory);
+    EXPECT_EQ(document["file"].getStringValue(), "animation.png");
+    EXPECT_EQ(document.root().size(), 7u);
+    EXPECT_TRUE(document.hasKey("animations"));
+    EXPECT_FALSE(document.hasKey("missing"));
+    EXPECT_EQ(document.find("missing"), nullptr);
+
+    // The parser is empty and can parse the next document, the frozen one stays valid
+    EXPECT_EQ(parser->find("file"), nullptr);
+    EXPECT_EQ(parser->memoryUsage(), 0u);
+    parser->parseString(R"({"file": "other.png"})");
+    EXPECT_EQ((*parser)["file"].getStringValue(), "other.png");
+    delete parser;
+    parser = nullptr;
+    EXPECT_EQ(document["file"].getStringValue(), "animation.png");
+
+    // Copies share the document
+    EXPECT_EQ(document.useCount(), 1);
+    JsonFrozenDocument copy = document;
+    EXPECT_EQ(document.useCount(), 2);
+    EXPECT_EQ(&copy.root(), &document.root());
+    document = JsonFrozenDocument();
+    EXPECT_TRUE(document.empty());
+    EXPECT_EQ(copy.useCount(), 1);
+    EXPECT_EQ(copy.dump(), text);
+
+    // Pointers and queries start from the root object
+    const JsonObject& root = copy.root();
+    static_assert(std::is_same<decltype(JsonPointer("/file").resolve(root)), const JsonValue*>::value,
+                  "Readers of a frozen document only get const values");
+    EXPECT_EQ(JsonPointer("/animations/1/name").resolve(root)->getStringValue(), "idle_front");
+    EXPECT_EQ(JsonPointer("/tile_size/width").resolve(root)->getInt64Value(), 32);
+    std::vector<const JsonValue*> names = JsonQuery("$.animations[?(@.loop == true)].name").evaluate(root);
+    ASSERT_EQ(names.size(), 2u);
+    EXPECT_EQ(names[0]->getStringValue(), "walk_right");
+}
+
+TEST_F(ParserTests, FrozenKeyIndex) // NOLINT
+{
+    parser->parse(TEST_PATH "complex/animation.json");
+    JsonFrozenDocument plain = parser->freeze();
+    EXPECT_FALSE(plain.root().hasIndex());
+
+    parser->parse(TEST_PATH "complex/animation.json");
+    const size_t memory = parser->memoryUsage();
+    JsonFrozenDocument indexed = parser->freeze(true);
+    EXPECT_GT(indexed.memoryUsage(), memory);
+    EXPECT_EQ(indexed.dump(), plain.dump());
+
+    // Objects with more than INDEX_THRESHOLD members are indexed, also nested in arrays
+    const JsonObject& root = indexed.root();
+    EXPECT_TRUE(root.hasIndex());
+    EXPECT_FALSE(indexed["tile_size"].getObjectValue().hasIndex());
+    for (JsonValue* animation : indexed["animations"].getArrayValue()) {
+        const JsonObject& object = animation->getObjectValue();
+        EXPECT_TRUE(object.hasIndex());
+        for (const auto& member : object) {
+            auto found = object.find(member.first);
+            ASSERT_NE(found, object.end());
+            EXPECT_EQ(found->second, member.second);
+        }
+        EXPECT_EQ(object.count("missing"), 0u);
+    }
+    for (const auto& member : root)
+        EXPECT_EQ(indexed.find(member.first), member.second);
+    EXPECT_EQ(JsonPointer("/animations/1/frame_time").resolve(root)->getNumberValue(), 0.8);
+
+    // An object with an index keeps it up to date
+    JsonObject object;
+    object.add(new JsonValue(ValueType::JSON_INT, "1"), "a");
+    object.buildIndex();
+    EXPECT_TRUE(object.hasIndex());
+    for (int i = 0; i<40; i++)
+        object.add(new JsonValue(ValueType::JSON_INT, std::to_string(i)), "key"+std::to_string(i));
+    EXPECT_EQ(object["a"].getInt64Value(), 1);
+    for (int i = 0; i<40; i++)
+        EXPECT_EQ(object["key"+std::to_string(i)].getInt64Value(), i);
+    for (auto& member : object)
+        delete member.second;
+}
+
+TEST_F(ParserTests, FrozenErrors) // NOLINT
+{
+    try {
+        parser->freeze();
+        FAIL() << "Expected std::invalid_argument";
+    }
+    MY_CATCH("JsonParser is empty", std::invalid_argument)
+
+    parser->feed(R"({"a": [1, 2)");
+    try {
+        parser->freeze();
+        FAIL() << "Expected std::invalid_argument";
+    }
+    MY_CATCH("JsonParser has an unfinished document", std::invalid_argument)
+    parser->feed("]}");
+    parser->finish();
+    EXPECT_EQ(parser->freeze().dump(), R"({"a":[1,2]})");
+
+    JsonFrozenDocument empty;
+    EXPECT_TRUE(empty.empty());
+    EXPECT_EQ(empty.useCount(), 0);
+    EXPECT_EQ(empty.memoryUsage(), 0u);
+    EXPECT_EQ(empty.find("a"), nullptr);
+    EXPECT_FALSE(empty.hasKey("a"));
+    try {
+        empty.root();
+        FAIL() << "Expected std::invalid_argument";
+    }
+    MY_CATCH("JsonFrozenDocument is empty", std::invalid_argument)
+    try {
+        empty["a"];
+        FAIL() << "Expected std::invalid_argument";
+    }
+    MY_CATCH("There is no such key 'a'", std::invalid_argument)
+}
+
+TEST_F(ParserTests, FrozenConcurrentReaders) // NOLINT
+{
+    std::string text = R"({"animations": [)";
+    for (int i = 0; i<500; i++) {
+        if (i>0)
+            text += ",";
+        text += R"({"id": )"+std::to_string(i)+R"(, "name": "animation number )"+std::to_string(i)
+                +R"(", "loop": )"+(i%3==0 ? "true" : "false")+R"(, "frames": [1, 2, 3], "frame_time": 0.5,
+                 "tags": {"a": 1, "b": 2, "c": 3, "d": 4, "e": 5, "f": 6}})";
+    }
+    text += R"(], "file": "animation.png", "count": 500})";
+    parser->parseString(text);
+    JsonFrozenDocument document = parser->freeze(true);
+    const std::string expected = document.dump();
+
+    const int threads = 8;
+    std::atomic<int> mismatches(0);
+    std::atomic<int> started(0);
+    std::vector<std::thread> readers;
+    for (int t = 0; t<threads; t++) {
+        // Every reader holds its own handle, the document is released by whichever finishes last
+        readers.emplace_back([document, t, &expected, &mismatches, &started]() {
+            started++;
+            JsonPointer name("/animations/"+std::to_string(t*50)+"/name");
+            JsonQuery looping("$.animations[?(@.loop == true && @.tags.f > 5)].id");
+            for (int i = 0; i<20; i++) {
+                JsonFrozenDocument local = document;
+                if (local.dump()!=expected)
+                    mismatches++;
+                const JsonValue* found = name.resolve(local.root());
+                if (found==nullptr || found->getStringValue()!="animation number "+std::to_string(t*50))
+                    mismatches++;
+                if (looping.evaluate(local.root()).size()!=167)
+                    mismatches++;
+                long long sum = 0;
+                for (JsonValue* animation : local["animations"].getArrayValue())
+                    sum += animation->getObjectValue()["tags"]["f"].getInt64Value();
+                if (sum!=6*500 || local["count"].getInt64Value()!=500)
+                    mismatches++;
+            }
+        });
+    }
+    while (started<threads)
+        std::this_thread::yield();
+    document = JsonFrozenDocument();
+
+    for (std::thread& reader : readers)
+        reader.join();
+    EXPECT_EQ(mismatches, 0);
+}
+
+#endif //JSONPARSER_FROZENTESTS_H
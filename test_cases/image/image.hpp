@@ -0,0 +1,6 @@
+#ifndef JSONPARSER_IMAGE_HPP
+#define JSONPARSER_IMAGE_HPP
+
+#include "imageTests.h"
+
+#endif //JSONPARSER_IMAGE_HPP
@@ -0,0 +1,236 @@
+#ifndef JSONPARSER_IMAGETESTS_H
+#define JSONPARSER_IMAGETESTS_H
+
+#include <cstdio>
+#include <functional>
+#include <type_traits>
+#include "../BaseTest.h"
+#include "../../jsonImage.h"
+#include "../../jsonLoader.h"
+#include "../binary/binaryTests.h"
+
+#define IMAGE_FILE "document_image.ejsi"
+
+static void expectSameObject(const JsonImageValue& image, const JsonObject& object);
+
+/**
+ * Check that a value of an image has the same type and contents as a parsed value.
+ */
+static void expectSameValue(const JsonImageValue& image, const JsonValue& value)
+{
+    if (value.isNull()) {
+        EXPECT_TRUE(image.isNull());
+    }
+    else if (value.isInteger()) {
+        ASSERT_TRUE(image.isInteger());
+        if (value.getNumberValue()<0)
+            EXPECT_EQ(image.getInt64Value(), value.getInt64Value());
+        else
+            EXPECT_EQ(image.getUInt64Value(), value.getUInt64Value());
+    }
+    else if (value.isNumber()) {
+        EXPECT_FALSE(image.isInteger());
+        EXPECT_EQ(image.getNumberValue(), value.getNumberValue());
+    }
+    else if (value.isBool()) {
+        // Numbers 0 and 1 are also JsonBool, so numbers are checked first
+        EXPECT_EQ(image.getBoolValue(), value.getBoolValue());
+    }
+    else if (value.isString()) {
+        EXPECT_EQ(image.getStringView(), value.getStringView());
+        EXPECT_EQ(image.c_str()[image.getStringView().size()], '\0');
+    }
+    else if (value.isArray()) {
+        const JsonArray& array = value.getArrayValue();
+        ASSERT_TRUE(image.isArray());
+        ASSERT_EQ(image.size(), array.size());
+        size_t i = 0;
+        for (JsonImageValue element : image)
+            expectSameValue(element, *array[i++]);
+    }
+    else {
+        expectSameObject(image, value.getObjectValue());
+    }
+}
+
+/**
+ * Check that an object of an image has the same members as a parsed object, in the same order.
+ */
+static void expectSameObject(const JsonImageValue& image, const JsonObject& object)
+{
+    ASSERT_TRUE(image.isObject());
+    ASSERT_EQ(image.size(), object.size());
+    auto member = object.begin();
+    for (auto it = image.begin(); it!=image.end(); ++it, ++member) {
+        EXPECT_EQ(it.keyView(), member->first);
+        expectSameValue(it.value(), *member->second);
+        // Lookups find the first member with the key, like the parsed object
+        EXPECT_TRUE(image.hasKey(it.keyView()));
+        expectSameValue(image[it.keyView()], *object.at(it.keyView()));
+    }
+    EXPECT_FALSE(image.hasKey("no such key in the image"));
+}
+
+TEST_F(ParserTests, ImageRoundTrip) // NOLINT
+{
+    static_assert(std::is_trivially_copyable<JsonImageValue>::value, "Image values are plain views");
+
+    // Every document of the test input, the files that are not valid json can not be saved
+    JsonLoader loader(2);
+    size_t documents = 0;
+    for (const std::string& directory : testDirectories()) {
+        for (JsonLoadResult& result : loader.loadDirectory(directory, "")) {
+            if (!result.ok())
+                continue;
+            documents++;
+            result.document->saveImage(IMAGE_FILE);
+            JsonImage image(IMAGE_FILE);
+            SCOPED_TRACE(result.path);
+            expectSameObject(image.root(), result.document->freeze().root());
+        }
+    }
+    EXPECT_GE(documents, 14u);
+
+    // Exact integers, doubles, inline and long strings with null characters, and empty containers
+    parser->parseString(R"({"int": -9223372036854775808, "uint": 18446744073709551615, "double": 0.1,)"
+                        R"( "small": "7 chars", "long": "eight ch", "escaped": "tab\t null\u0000 end",)"
+                        R"( "": [[], {}, null, true, false, -1]})");
+    JsonFrozenDocument document = parser->freeze();
+    const std::string bytes = JsonImage::build(document.root());
+    EXPECT_EQ(bytes.size()%8, 0u);
+    JsonImage image;
+    image.open(bytes.data(), bytes.size());
+    EXPECT_EQ(image.size(), bytes.size());
+    expectSameObject(image.root(), document.root());
+    EXPECT_EQ(image["int"].getInt64Value(), INT64_MIN);
+    EXPECT_EQ(image["uint"].getUInt64Value(), UINT64_MAX);
+    EXPECT_EQ(image["small"].getStringValue(), "7 chars");
+    EXPECT_EQ(image["escaped"].getStringView().size(), 14u);
+    EXPECT_EQ(image[""][5].getNumberValue(), -1.0);
+    std::remove(IMAGE_FILE);
+}
+
+TEST_F(ParserTests, ImageLargeObjects) // NOLINT
+{
+    // Objects around the index threshold, with keys that share their strings with values
+    for (int members : {0, 1, 8, 9, 100, 1000}) {
+        std::string text = "{";
+        for (int i = 0; i<members; i++)
+            text += (i==0 ? "\"key " : ", \"key ")+std::to_string(i)+"\": \"key "+std::to_string(members-1-i)+'"';
+        parser->parseString(text+"}");
+        const std::string bytes = JsonImage::build(parser->freeze().root());
+        JsonImage image;
+        image.open(bytes.data(), bytes.size());
+        ASSERT_EQ(image.root().size(), static_cast<size_t>(members));
+        for (int i = 0; i<members; i++) {
+            std::string key = "key "+std::to_string(i);
+            ASSERT_TRUE(image.hasKey(key)) << key;
+            EXPECT_EQ(image[key].getStringValue(), "key "+std::to_string(members-1-i));
+        }
+        EXPECT_FALSE(image.hasKey("key"));
+        EXPECT_FALSE(image.hasKey(std::to_string(members)));
+    }
+
+    // Repeated keys are written once
+    std::string text = R"({"records": [)";
+    for (int i = 0; i<100; i++)
+        text += std::string(i==0 ? "" : ", ")+R"({"identifier": 1, "description": "the same record"})";
+    parser->parseString(text+"]}");
+    EXPECT_LT(JsonImage::build(parser->freeze().root()).size(), 100u*5*16+200);
+}
+
+TEST_F(ParserTests, ImageAccessors) // NOLINT
+{
+    parser->parseString(R"({"array": [], "object": {"a": 1}, "string": "text", "number": 1.5, "negative": -1,)"
+                        R"( "huge": 18446744073709551615, "bool": true})");
+    parser->saveImage(IMAGE_FILE);
+    JsonImage image(IMAGE_FILE);
+    const std::pair<std::function<void()>, const char*> errors[] = {
+            {[&]() { image["missing"]; }, "There is no such key 'missing'"},
+            {[&]() { image.root()["missing"]; }, "Did not find key 'missing' in JsonObject"},
+            {[&]() { image["array"][0]; }, "Index out of range, got [0], but JsonArray is empty"},
+            {[&]() { image["array"]["a"]; }, "Object is not of type JsonObject"},
+            {[&]() { image["array"].hasKey("a"); }, "JsonValue is not of type 'JsonObject'"},
+            {[&]() { image["object"][1]; }, "Object is not of type JsonArray"},
+            {[&]() { image["object"].begin().keyView(); image["array"].begin().keyView(); },
+             "Object is not of type JsonObject"},
+            {[&]() { image["string"].size(); }, "Invalid type for: JsonArray or JsonObject"},
+            {[&]() { image["string"].getNumberValue(); }, "Invalid type for: JsonNumber"},
+            {[&]() { image["number"].getStringView(); }, "Invalid type for: JsonString"},
+            {[&]() { image["number"].getInt64Value(); }, "Invalid type for: JsonInt"},
+            {[&]() { image["negative"].getUInt64Value(); }, "Value out of range for: JsonUInt"},
+            {[&]() { image["huge"].getInt64Value(); }, "Value out of range for: JsonInt"},
+            {[&]() { image["number"].getBoolValue(); }, "Unexpected value for JsonBool"},
+    };
+    for (const auto& entry : errors) {
+        try {
+            entry.first();
+            FAIL() << "Expected std::invalid_argument";
+        }
+        MY_CATCH(entry.second, std::invalid_argument)
+    }
+    EXPECT_EQ(image["negative"].getNumberValue(), -1.0);
+    EXPECT_EQ(image["huge"].getNumberValue(), 18446744073709551615.0);
+    EXPECT_TRUE(image["bool"].getBoolValue());
+
+    image.close();
+    EXPECT_EQ(image.size(), 0u);
+    EXPECT_FALSE(image.hasKey("array"));
+    try {
+        image.root();
+        FAIL() << "Expected std::invalid_argument";
+    }
+    MY_CATCH("JsonImage is empty", std::invalid_argument)
+    std::remove(IMAGE_FILE);
+}
+
+TEST_F(ParserTests, ImageErrors) // NOLINT
+{
+    try {
+        parser->saveImage(IMAGE_FILE);
+        FAIL() << "Expected std::invalid_argument";
+    }
+    MY_CATCH("JsonParser is empty", std::invalid_argument)
+    try {
+        JsonImage image(TEST_PATH "missing.ejsi");
+        FAIL() << "Expected std::invalid_argument";
+    }
+    MY_CATCH("File not found '" TEST_PATH "missing.ejsi'", std::invalid_argument)
+
+    parser->parseString(R"({"name": "a long walk", "frames": [1, 2.5, {"loop": false}], "extra": null})");
+    const std::string bytes = JsonImage::build(parser->freeze().root());
+    std::string header = bytes.substr(0, 32);
+    const std::pair<std::string, const char*> corrupt[] = {
+            {"EJSX", "Invalid json image: missing header"},
+            {"EJSX"+bytes.substr(4), "Invalid json image: missing header"},
+            {bytes.substr(0, 4)+'\x02'+bytes.substr(5), "Invalid json image: unsupported version"},
+            {bytes.substr(0, bytes.size()-8), "Invalid json image: the size does not match the header"},
+            {header.substr(0, 16)+std::string("\xf8\xff\xff\xff\xff\xff\xff\xff", 8)+header.substr(24)
+             +bytes.substr(32), "Invalid json image: offset out of range"},
+            {header.substr(0, 16)+std::string("\0\0\0\0\0\0\0\0", 8)+header.substr(24)+bytes.substr(32),
+             "Invalid json image: the root is not an object"},
+    };
+    JsonImage image;
+    for (const auto& entry : corrupt) {
+        writeBytes(IMAGE_FILE, entry.first);
+        try {
+            image.open(IMAGE_FILE);
+            FAIL() << "Expected std::invalid_argument";
+        }
+        MY_CATCH(entry.second, std::invalid_argument)
+        EXPECT_EQ(image.size(), 0u);
+    }
+
+    // Offsets inside the values are checked when they are followed
+    std::string broken = bytes;
+    broken[32+15] = '\x7f';
+    image.open(broken.data(), broken.size());
+    try {
+        image["name"];
+        FAIL() << "Expected std::invalid_argument";
+    }
+    MY_CATCH("Invalid json image: offset out of range", std::invalid_argument)
+    std::remove(IMAGE_FILE);
+}
+
+#endif //JSONPARSER_IMAGETESTS_H
@@ -0,0 +1,6 @@
+#ifndef JSONPARSER_LINES_HPP
+#define JSONPARSER_LINES_HPP
+
+#include "linesTests.h"
+
+#endif //JSONPARSER_LINES_HPP
@@ -0,0 +1,158 @@
+#ifndef JSONPARSER_LINESTESTS_H
+#define JSONPARSER_LINESTESTS_H
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include "../BaseTest.h"
+#include "../../jsonLines.h"
+
+/**
+ * Makes a text with a record per line, large enough to be split over several threads.
+ */
+static std::string makeLines(int records)
+{
+    std::string text;
+    for (int i = 0; i<records; i++) {
+        text += R"({"id": )"+std::to_string(i)+R"(, "name": "record )"+std::to_string(i)
+                +R"(", "values": [1, 2, 3], "nested": {"ok": true}})";
+        // Some empty lines and windows line endings in between
+        text += i%100==0 ? "\n\n" : i%7==0 ? "\r\n" : "\n";
+    }
+    return text;
+}
+
+TEST_F(ValueTests, ThreadPoolRun) // NOLINT
+{
+    JsonThreadPool pool(4);
+    EXPECT_EQ(pool.size(), 4u);
+    std::vector<int> done(1000, 0);
+    std::atomic<int> wrongThread(0);
+    pool.run(done.size(), [&](size_t task, unsigned thread) {
+        done[task]++;
+        if (thread>=4)
+            wrongThread++;
+    });
+    EXPECT_EQ(std::count(done.begin(), done.end(), 1), 1000);
+    EXPECT_EQ(wrongThread, 0);
+
+    try {
+        pool.run(100, [](size_t task, unsigned) {
+            if (task==42)
+                throw std::runtime_error("task failed");
+        });
+        FAIL() << "Expected std::runtime_error";
+    }
+    MY_CATCH("task failed", std::runtime_error)
+
+    // The pool can still be used after an exception
+    std::atomic<size_t> sum(0);
+    pool.run(10, [&sum](size_t task, unsigned) { sum += task; });
+    EXPECT_EQ(sum, 45u);
+}
+
+TEST_F(ValueTests, ThreadPoolStealing) // NOLINT
+{
+    // The first task blocks until all others are done, the other tasks of its thread must be stolen
+    JsonThreadPool pool(2);
+    std::atomic<int> done(0);
+    std::atomic<bool> finished(false);
+    pool.run(16, [&](size_t task, unsigned) {
+        if (task==0) {
+            auto deadline = std::chrono::steady_clock::now()+std::chrono::seconds(10);
+            while (done<15 && std::chrono::steady_clock::now()<deadline)
+                std::this_thread::yield();
+            finished = done==15;
+        }
+        done++;
+    });
+    EXPECT_TRUE(finished);
+    EXPECT_EQ(done, 16);
+}
+
+TEST_F(ValueTests, LinesOrdered) // NOLINT
+{
+    JsonLines lines(4);
+    lines.parseString(makeLines(20000));
+    ASSERT_EQ(lines.size(), 20000u);
+    for (size_t i = 0; i<lines.size(); i++)
+        ASSERT_EQ(lines[i]["id"].getInt64Value(), static_cast<int64_t>(i));
+    EXPECT_EQ(lines[123]["name"].getStringValue(), "record 123");
+    EXPECT_TRUE(lines[19999]["nested"]["ok"].getBoolValue());
+    EXPECT_GT(lines.memoryUsage(), 0u);
+
+    lines.parse(TEST_PATH "lines/records.ndjson");
+    ASSERT_EQ(lines.size(), 3u);
+    EXPECT_EQ(lines[0]["name"].getStringValue(), "first");
+    EXPECT_EQ(lines[1]["tags"][1].getStringValue(), "b");
+    EXPECT_TRUE(lines[2]["nested"]["ok"].getBoolValue());
+    int id = 0;
+    for (JsonValue* record : lines)
+        EXPECT_EQ((*record)["id"].getNumberValue(), id++);
+
+    try {
+        lines[3];
+        FAIL() << "Expected std::invalid_argument";
+    }
+    MY_CATCH("Index out of range, got [3], max is [2]", std::invalid_argument)
+
+    lines.clear();
+    EXPECT_EQ(lines.size(), 0u);
+    EXPECT_EQ(lines.memoryUsage(), 0u);
+}
+
+TEST_F(ValueTests, LinesForEach) // NOLINT
+{
+    std::string text = makeLines(20000);
+    JsonLines lines(4);
+    std::mutex mutex;
+    std::vector<int> seen(20000, 0);
+    std::atomic<bool> wrongLine(false);
+    lines.forEach(text.data(), text.size(), [&](int line, JsonValue& record) {
+        int64_t id = record["id"].getInt64Value();
+        // Record i is on line i+1, plus one empty line after every hundredth record
+        if (line!=id+1+(id+99)/100)
+            wrongLine = true;
+        std::lock_guard<std::mutex> lock(mutex);
+        seen[id]++;
+    });
+    EXPECT_EQ(std::count(seen.begin(), seen.end(), 1), 20000);
+    EXPECT_FALSE(wrongLine);
+    // Records passed to a function are not kept
+    EXPECT_EQ(lines.size(), 0u);
+}
+
+TEST_F(ValueTests, LinesErrors) // NOLINT
+{
+    JsonLines lines(4);
+    std::string text = makeLines(20000);
+    // Break the records on lines 5000 and 15001
+    for (const char* record : {"\"id\": 4949,", "\"id\": 14851,"})
+        text.replace(text.find(record), strlen(record), "\"id\" 1,");
+    try {
+        lines.parseString(text);
+        FAIL() << "Expected ParseError";
+    }
+    MY_CATCH("Error at line 5000:\n|\n1, \"name\": \"record 4949\", \"values\": [1, 2, 3], \"nested\": {\"ok\": true}}\n"
+             "Missing ':' after \"id\"", ParseError)
+    EXPECT_EQ(lines.size(), 0u);
+
+    // The other records are still passed on
+    std::atomic<int> count(0);
+    try {
+        lines.forEach(text.data(), text.size(), [&count](int, JsonValue&) { count++; });
+        FAIL() << "Expected ParseError";
+    }
+    catch (ParseError&) {
+    }
+    EXPECT_EQ(count, 19998);
+
+    try {
+        lines.parseString("{\"a\": 1}\n[1]\n");
+        FAIL() << "Expected ParseError";
+    }
+    MY_CATCH("Error at line 2:\n|\n[1]\nMissing root '{'", ParseError)
+}
+
+#endif //JSONPARSER_LINESTESTS_H
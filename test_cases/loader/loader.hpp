@@ -0,0 +1,6 @@
+#ifndef JSONPARSER_LOADER_HPP
+#define JSONPARSER_LOADER_HPP
+
+#include "loaderTests.h"
+
+#endif //JSONPARSER_LOADER_HPP
@@ -0,0 +1,98 @@
+#ifndef JSONPARSER_LOADERTESTS_H
+#define JSONPARSER_LOADERTESTS_H
+
+#include <cstdio>
+#include <fstream>
+#include "../BaseTest.h"
+#include "../../jsonLoader.h"
+
+TEST_F(ValueTests, LoadAllFiles) // NOLINT
+{
+    JsonLoader loader(4);
+    std::vector<std::string> paths{TEST_PATH "complex/animation.json", TEST_PATH "string/string5.json",
+                                   TEST_PATH "missing.json", TEST_PATH "string/string2.json"};
+    // Enough files that every thread gets several of them
+    for (int i = 0; i<50; i++)
+        paths.push_back(TEST_PATH "complex/objectarray.json");
+    std::vector<JsonLoadResult> results = loader.loadAll(paths);
+
+    ASSERT_EQ(results.size(), paths.size());
+    for (size_t i = 0; i<paths.size(); i++)
+        EXPECT_EQ(results[i].path, paths[i]);
+    ASSERT_TRUE(results[0].ok());
+    EXPECT_EQ((*results[0].document)["file"].getStringValue(), "animation.png");
+    EXPECT_FALSE(results[1].ok());
+    EXPECT_EQ(results[1].error, "Error at line 2:\n|\nmiauw\nUnexpected token: 'm'");
+    EXPECT_FALSE(results[2].ok());
+    EXPECT_EQ(results[2].error, "File not found '" TEST_PATH "missing.json'");
+    ASSERT_TRUE(results[3].ok());
+    EXPECT_EQ((*results[3].document)["cat"].getStringValue(), "meow");
+    for (size_t i = 4; i<results.size(); i++) {
+        ASSERT_TRUE(results[i].ok());
+        EXPECT_TRUE(results[i].error.empty());
+    }
+
+    const JsonLoadStatistics& statistics = loader.statistics();
+    EXPECT_EQ(statistics.files, paths.size());
+    EXPECT_EQ(statistics.failed, 2u);
+    EXPECT_GT(statistics.bytes, 0u);
+    EXPECT_GE(statistics.ioSeconds, 0);
+    EXPECT_GE(statistics.parseSeconds, 0);
+    EXPECT_GT(statistics.wallSeconds, 0);
+
+    // Documents do not depend on the loader or on each other
+    results.erase(results.begin()+4, results.end());
+    loader.loadAll({});
+    EXPECT_EQ(loader.statistics().files, 0u);
+    EXPECT_EQ((*results[0].document)["file"].getStringValue(), "animation.png");
+}
+
+TEST_F(ValueTests, LoadDirectory) // NOLINT
+{
+    JsonLoader loader(2);
+    std::vector<JsonLoadResult> results = loader.loadDirectory(TEST_PATH "string");
+    ASSERT_EQ(results.size(), 6u);
+    for (size_t i = 0; i<results.size(); i++) {
+        std::string expected = TEST_PATH "string/string"+std::to_string(i+1)+".json";
+        EXPECT_EQ(results[i].path, expected);
+        // string3.json and string5.json are broken
+        EXPECT_EQ(results[i].ok(), i!=2 && i!=4) << results[i].path;
+    }
+    EXPECT_EQ(results[2].error, "Error at line 3: Expected new object after ','");
+    EXPECT_EQ(loader.statistics().failed, 2u);
+
+    EXPECT_TRUE(loader.loadDirectory(TEST_PATH "string", ".ndjson").empty());
+    try {
+        loader.loadDirectory(TEST_PATH "missing");
+        FAIL() << "Expected std::invalid_argument";
+    }
+    MY_CATCH("Directory not found '" TEST_PATH "missing'", std::invalid_argument)
+}
+
+TEST_F(ValueTests, LoadDuplicateKey) // NOLINT
+{
+    // A file that parses but can not be built keeps its error like a file with a syntax error
+    const std::string files[] = {"loader_a.json", "loader_b.json", "loader_c.json", "loader_d.json"};
+    const char* texts[] = {R"({"a": 1})", R"({"a":1,"a":2})", R"({"a": [1, 2)", R"({"d": true})"};
+    for (int i = 0; i<4; i++) {
+        std::ofstream file(files[i], std::ios::binary | std::ios::trunc);
+        file << texts[i];
+    }
+
+    JsonLoader loader(2);
+    std::vector<JsonLoadResult> results = loader.loadAll({files, files+4});
+    ASSERT_EQ(results.size(), 4u);
+    ASSERT_TRUE(results[0].ok());
+    EXPECT_EQ((*results[0].document)["a"].getNumberValue(), 1);
+    EXPECT_FALSE(results[1].ok());
+    EXPECT_EQ(results[1].error, "There already is a key 'a'");
+    EXPECT_FALSE(results[2].ok());
+    EXPECT_FALSE(results[2].error.empty());
+    ASSERT_TRUE(results[3].ok());
+    EXPECT_TRUE((*results[3].document)["d"].getBoolValue());
+    EXPECT_EQ(loader.statistics().failed, 2u);
+    for (const std::string& file : files)
+        std::remove(file.c_str());
+}
+
+#endif //JSONPARSER_LOADERTESTS_H
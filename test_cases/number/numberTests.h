@@ -0,0 +1,125 @@
+#ifndef JSONPARSER_NUMBERTESTS_H
+#define JSONPARSER_NUMBERTESTS_H
+
+#include <clocale>
+#include <cstring>
+#include <random>
+#include "../BaseTest.h"
+#include "../../jsonNumber.h"
+#include "../../jsonTape.h"
+
+TEST_F(ParserTests, NumberFile) // NOLINT
+{
+    parser->parse(TEST_PATH "number/number.json");
+    EXPECT_EQ((*parser)["number"].getNumberValue(), 10.5);
+    EXPECT_FALSE((*parser)["number"].isInteger());
+    EXPECT_TRUE((*parser)["number2"].isInteger());
+    EXPECT_EQ((*parser)["number2"].getInt64Value(), 10);
+    EXPECT_EQ((*parser)["number2"].getNumberValue(), 10);
+}
+
+TEST_F(ParserTests, NumberIntegers) // NOLINT
+{
+    parser->parseString(R"({"id": 9007199254740993, "min": -9223372036854775808, "max": 18446744073709551615,
+                            "big": 18446744073709551616, "negative": -9223372036854775809, "zero": -0})");
+
+    // Integers above 2^53 keep their exact value
+    EXPECT_EQ((*parser)["id"].getInt64Value(), 9007199254740993);
+    EXPECT_EQ((*parser)["id"].getUInt64Value(), 9007199254740993u);
+    EXPECT_EQ((*parser)["min"].getInt64Value(), INT64_MIN);
+    EXPECT_EQ((*parser)["max"].getUInt64Value(), UINT64_MAX);
+    EXPECT_EQ((*parser)["zero"].getInt64Value(), 0);
+
+    // Integers that do not fit in 64 bits are doubles
+    EXPECT_FALSE((*parser)["big"].isInteger());
+    EXPECT_EQ((*parser)["big"].getNumberValue(), 18446744073709551616.0);
+    EXPECT_EQ((*parser)["negative"].getNumberValue(), -9223372036854775809.0);
+
+    try {
+        (*parser)["max"].getInt64Value();
+        FAIL() << "Expected std::invalid_argument";
+    }
+    MY_CATCH("Value out of range for: JsonInt", std::invalid_argument)
+
+    try {
+        (*parser)["min"].getUInt64Value();
+        FAIL() << "Expected std::invalid_argument";
+    }
+    MY_CATCH("Value out of range for: JsonUInt", std::invalid_argument)
+
+    try {
+        (*parser)["big"].getInt64Value();
+        FAIL() << "Expected std::invalid_argument";
+    }
+    MY_CATCH("Invalid type for: JsonInt", std::invalid_argument)
+
+    JsonTape tape;
+    tape.parseString(R"({"id": 9007199254740993, "max": 18446744073709551615, "pi": 3.14})");
+    EXPECT_EQ(tape["id"].getInt64Value(), 9007199254740993);
+    EXPECT_EQ(tape["max"].getUInt64Value(), UINT64_MAX);
+    EXPECT_FALSE(tape["pi"].isInteger());
+    EXPECT_EQ(tape["pi"].getNumberValue(), 3.14);
+}
+
+TEST_F(ParserTests, NumberExponents) // NOLINT
+{
+    parser->parseString(R"({"a": 1e3, "b": 1E+3, "c": -2.5e-3, "d": 1e400, "e": 1e-400, "f": 4.9406564584124654e-324,
+                            "g": 0.1, "h": 123456789012345678901234567890e-20})");
+    EXPECT_EQ((*parser)["a"].getNumberValue(), 1000);
+    EXPECT_FALSE((*parser)["a"].isInteger());
+    EXPECT_EQ((*parser)["b"].getNumberValue(), 1000);
+    EXPECT_EQ((*parser)["c"].getNumberValue(), -0.0025);
+    EXPECT_EQ((*parser)["d"].getNumberValue(), HUGE_VAL);
+    EXPECT_EQ((*parser)["e"].getNumberValue(), 0);
+    EXPECT_EQ((*parser)["f"].getNumberValue(), 4.9406564584124654e-324);
+    EXPECT_EQ((*parser)["g"].getNumberValue(), 0.1);
+    EXPECT_EQ((*parser)["h"].getNumberValue(), 1234567890.12345678901234567890);
+
+    for (const char* invalid : {R"({"a": 1.})", R"({"a": 1e})", R"({"a": --1})", R"({"a": 1.5.2})"}) {
+        try {
+            parser->parseString(invalid);
+            FAIL() << "Expected ParseError for " << invalid;
+        }
+        catch (ParseError& e) {
+            EXPECT_NE(std::string(e.what()).find("Incorrect number format"), std::string::npos);
+        }
+    }
+}
+
+TEST_F(ValueTests, NumberRoundTrip) // NOLINT
+{
+    // Every double printed with 17 digits must parse back to the same bits
+    std::mt19937_64 random(2020);
+    for (int i = 0; i<100000; i++) {
+        uint64_t bits = random();
+        double value;
+        memcpy(&value, &bits, sizeof(value));
+        if (value!=value || value-value!=0)
+            continue;
+        char text[32];
+        snprintf(text, sizeof(text), "%.17g", value);
+
+        JsonNumber number{};
+        ASSERT_EQ(JsonNumber::parse(text, text+strlen(text), number), text+strlen(text)) << text;
+        double parsed = number.toDouble();
+        ASSERT_EQ(memcmp(&parsed, &value, sizeof(value)), 0) << text;
+    }
+}
+
+TEST_F(ValueTests, NumberLocale) // NOLINT
+{
+    // Locales with a decimal comma must not change the result
+    const char* previous = setlocale(LC_NUMERIC, nullptr);
+    std::string restore = previous!=nullptr ? previous : "C";
+    if (setlocale(LC_NUMERIC, "de_DE.UTF-8")==nullptr && setlocale(LC_NUMERIC, "fr_FR.UTF-8")==nullptr)
+        GTEST_SKIP() << "No locale with a decimal comma available";
+
+    auto value = JsonValue(ValueType::JSON_NUM, "2.578");
+    EXPECT_EQ(value.getNumberValue(), 2.578);
+    // Needs the slow path
+    auto slow = JsonValue(ValueType::JSON_NUM, "2.4703282292062328e-324");
+    EXPECT_EQ(slow.getNumberValue(), 4.9406564584124654e-324);
+    setlocale(LC_NUMERIC, restore.c_str());
+}
+
+#endif //JSONPARSER_NUMBERTESTS_H
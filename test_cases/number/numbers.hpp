@@ -0,0 +1,6 @@
+#ifndef JSONPARSER_NUMBERS_HPP
+#define JSONPARSER_NUMBERS_HPP
+
+#include "numberTests.h"
+
+#endif //JSONPARSER_NUMBERS_HPP
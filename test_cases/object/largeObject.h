@@ -0,0 +1,72 @@
+#ifndef JSONPARSER_LARGEOBJECT_H
+#define JSONPARSER_LARGEOBJECT_H
+
+#include "../BaseTest.h"
+
+TEST_F(ParserTests, ObjectInsertionOrder) // NOLINT
+{
+    parser->parseString(R"({"object": {"z": 1, "a": 2, "m": 3}})");
+
+    std::string keys;
+    for (auto& member : (*parser)["object"].getObjectValue())
+        keys += std::string(member.first);
+    EXPECT_EQ(keys, "zam");
+}
+
+TEST_F(ParserTests, ObjectLarge) // NOLINT
+{
+    // Enough keys to use the hash index, with keys that share prefixes
+    std::string json = "{\"flags\": {";
+    for (int i = 0; i<5000; i++) {
+        if (i>0)
+            json += ", ";
+        json += "\"feature_"+std::to_string(i)+"\": "+std::to_string(i);
+    }
+    json += "}}";
+    parser->parseString(json);
+
+    JsonObject& flags = (*parser)["flags"].getObjectValue();
+    ASSERT_EQ(flags.size(), 5000);
+    for (int i = 0; i<5000; i++)
+        ASSERT_EQ(flags["feature_"+std::to_string(i)].getInt64Value(), i);
+    EXPECT_EQ(flags.count("feature_5000"), 0);
+    EXPECT_EQ(flags.find("feature_"), flags.end());
+
+    // Duplicates are found through the index as well
+    try {
+        parser->parseString(json.substr(0, json.size()-2)+", \"feature_4321\": 1}}");
+        FAIL() << "Expected std::invalid_argument";
+    }
+    MY_CATCH("Duplicate key: 'feature_4321'", std::invalid_argument)
+}
+
+TEST_F(ValueTests, ObjectLargeHeap) // NOLINT
+{
+    JsonValue object(ValueType::JSON_OBJ);
+    for (int i = 0; i<100; i++)
+        object.addToObject(new JsonValue(ValueType::JSON_STRING, "value "+std::to_string(i)), "key "+std::to_string(i));
+
+    EXPECT_EQ(object.getObjectValue().size(), 100);
+    EXPECT_EQ(object["key 42"].getStringView(), "value 42");
+    EXPECT_EQ(object.getObjectValue().at("key 99")->getStringView(), "value 99");
+    EXPECT_EQ(object.getObjectValue().begin()->first, "key 0");
+
+    try {
+        object.getObjectValue().at("key 100");
+        FAIL() << "Expected std::out_of_range";
+    }
+    MY_CATCH("There is no such key 'key 100'", std::out_of_range)
+
+    // A rejected value stays owned by the caller
+    JsonValue* duplicate = new JsonValue();
+    try {
+        object.addToObject(duplicate, "key 7");
+        FAIL() << "Expected std::invalid_argument";
+    }
+    catch (std::invalid_argument& e) {
+        EXPECT_STREQ(e.what(), "Duplicate key: 'key 7'");
+    }
+    delete duplicate;
+}
+
+#endif //JSONPARSER_LARGEOBJECT_H
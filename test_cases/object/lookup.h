@@ -0,0 +1,71 @@
+#ifndef JSONPARSER_LOOKUP_H
+#define JSONPARSER_LOOKUP_H
+
+#include "../BaseTest.h"
+
+#define OBJ_PATH TEST_PATH "object/"
+
+TEST_F(ParserTests, ObjectFind) // NOLINT
+{
+    parser->parse(OBJ_PATH "object.json");
+
+    JsonValue* object = parser->find("object");
+    ASSERT_NE(object, nullptr);
+    EXPECT_EQ(parser->find("missing"), nullptr);
+
+    JsonValue* name = object->find("name");
+    ASSERT_NE(name, nullptr);
+    EXPECT_EQ(name->getStringView(), "jefke");
+    EXPECT_EQ(object->find("jefke"), nullptr);
+    EXPECT_EQ(name, &(*parser)["object"]["name"]);
+
+    try {
+        name->find("name");
+        FAIL() << "Expected std::invalid_argument";
+    }
+    MY_CATCH("Object is not of type JsonObject", std::invalid_argument)
+
+    // Nothing parsed yet
+    JsonParser empty;
+    EXPECT_EQ(empty.find("object"), nullptr);
+}
+
+TEST_F(ParserTests, ObjectKeyTypes) // NOLINT
+{
+    parser->parse(OBJ_PATH "object.json");
+
+    std::string key = "number";
+    JsonStringView view(key);
+    const char* literal = "number";
+    EXPECT_EQ((*parser)["object"][key].getInt64Value(), 34);
+    EXPECT_EQ((*parser)["object"][view].getInt64Value(), 34);
+    EXPECT_EQ((*parser)["object"][literal].getInt64Value(), 34);
+    EXPECT_TRUE((*parser)["object"].hasKey(view));
+    EXPECT_TRUE(parser->hasKey("object"));
+    EXPECT_TRUE((*parser)["object"].getObjectValue().count(view)==1);
+
+    // Keys are compared by their characters, not as null terminated strings
+    EXPECT_FALSE((*parser)["object"].hasKey(JsonStringView("number\0", 7)));
+    EXPECT_TRUE((*parser)["object"].hasKey(JsonStringView("numbers", 6)));
+
+    try {
+        (*parser)["object"][JsonStringView("name of", 4)].getStringView();
+    }
+    catch (std::invalid_argument&) {
+        FAIL() << "Expected to find 'name'";
+    }
+
+    try {
+        (*parser)["object"]["missing"];
+        FAIL() << "Expected std::invalid_argument";
+    }
+    MY_CATCH("Did not find key 'missing' in JsonObject", std::invalid_argument)
+
+    try {
+        (*parser)["missing"];
+        FAIL() << "Expected std::invalid_argument";
+    }
+    MY_CATCH("There is no such key 'missing'", std::invalid_argument)
+}
+
+#endif //JSONPARSER_LOOKUP_H
@@ -0,0 +1,7 @@
+#ifndef JSONPARSER_OBJECTS_HPP
+#define JSONPARSER_OBJECTS_HPP
+
+#include "lookup.h"
+#include "largeObject.h"
+
+#endif //JSONPARSER_OBJECTS_HPP
@@ -0,0 +1,6 @@
+#ifndef JSONPARSER_OWNERSHIP_HPP
+#define JSONPARSER_OWNERSHIP_HPP
+
+#include "ownershipTests.h"
+
+#endif //JSONPARSER_OWNERSHIP_HPP
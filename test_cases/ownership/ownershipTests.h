@@ -0,0 +1,120 @@
+#ifndef JSONPARSER_OWNERSHIPTESTS_H
+#define JSONPARSER_OWNERSHIPTESTS_H
+
+#include <type_traits>
+#include "../BaseTest.h"
+
+/**
+ * Build an object on the heap, as a function that returns a value would.
+ */
+static JsonValue makeAnimation(int id)
+{
+    JsonValue animation(ValueType::JSON_OBJ);
+    animation.addToObject(new JsonValue(ValueType::JSON_INT, std::to_string(id)), "id");
+    animation.addToObject(new JsonValue(ValueType::JSON_STRING, "a name that is too long to store inline"), "name");
+    JsonValue* frames = new JsonValue(ValueType::JSON_ARRAY);
+    for (int i = 0; i<3; i++)
+        frames->addToArray(new JsonValue(ValueType::JSON_INT, std::to_string(i)));
+    animation.addToObject(frames, "frames");
+    return animation;
+}
+
+TEST_F(ValueTests, OwnershipMove) // NOLINT
+{
+    EXPECT_FALSE(std::is_copy_constructible<JsonValue>::value);
+    EXPECT_FALSE(std::is_copy_assignable<JsonValue>::value);
+    EXPECT_TRUE(std::is_nothrow_move_constructible<JsonValue>::value);
+
+    const std::string text = R"({"id":1,"name":"a name that is too long to store inline","frames":[0,1,2]})";
+    JsonValue animation = makeAnimation(1);
+    EXPECT_EQ(animation.dump(), text);
+
+    // Moving takes the storage, the original is null and frees nothing
+    JsonValue moved(std::move(animation));
+    EXPECT_TRUE(animation.isNull());
+    EXPECT_EQ(moved.dump(), text);
+
+    // Assigning frees the storage that is replaced
+    moved = makeAnimation(2);
+    EXPECT_EQ(moved["id"].getInt64Value(), 2);
+    moved = JsonValue(ValueType::JSON_STRING, "short");
+    EXPECT_EQ(moved.getStringValue(), "short");
+
+    // Containers move their values when they grow
+    std::vector<JsonValue> animations;
+    for (int i = 0; i<100; i++)
+        animations.push_back(makeAnimation(i));
+    for (int i = 0; i<100; i++)
+        EXPECT_EQ(animations[i]["id"].getInt64Value(), i);
+    animations.erase(animations.begin(), animations.begin()+50);
+    EXPECT_EQ(animations[0]["frames"][2].getInt64Value(), 2);
+}
+
+TEST_F(ParserTests, OwnershipClone) // NOLINT
+{
+    parser->parse(TEST_PATH "complex/animation.json");
+    std::string text = (*parser)["animations"].dump();
+
+    // A clone does not depend on the arena of the parser
+    JsonValue animations = (*parser)["animations"].clone();
+    parser->parseString("{}");
+    EXPECT_EQ(animations.dump(), text);
+
+    JsonValue copy = animations.clone();
+    copy[0]["name"] = JsonValue(ValueType::JSON_STRING, "a changed name that is stored on the heap");
+    EXPECT_EQ(animations.dump(), text);
+    EXPECT_EQ(copy[0]["name"].getStringValue(), "a changed name that is stored on the heap");
+}
+
+TEST_F(ParserTests, OwnershipArena) // NOLINT
+{
+    parser->parse(TEST_PATH "complex/animation.json");
+    std::string text = (*parser)["animations"].dump();
+
+    // Values moved out of the document still use its arena
+    JsonValue animations = std::move((*parser)["animations"]);
+    EXPECT_EQ(animations.dump(), text);
+    EXPECT_TRUE((*parser)["animations"].isNull());
+
+    // Values of the arena only take values the arena does not need to free
+    (*parser)["animations"] = std::move(animations);
+    EXPECT_EQ((*parser)["animations"].dump(), text);
+    (*parser)["border"] = JsonValue(ValueType::JSON_INT, "2");
+    (*parser)["type"] = JsonValue(ValueType::JSON_STRING, "short");
+    EXPECT_EQ((*parser)["border"].getInt64Value(), 2);
+    EXPECT_EQ((*parser)["type"].getStringValue(), "short");
+    try {
+        (*parser)["border"] = makeAnimation(1);
+        FAIL() << "Expected std::invalid_argument";
+    }
+    MY_CATCH("Can not move a value with heap memory into a value of an arena", std::invalid_argument)
+    EXPECT_EQ((*parser)["border"].getInt64Value(), 2);
+}
+
+TEST_F(ValueTests, OwnershipHandle) // NOLINT
+{
+    EXPECT_EQ(sizeof(JsonValuePtr), sizeof(JsonValue*));
+
+    JsonValue array(ValueType::JSON_ARRAY);
+    JsonValuePtr animation(new JsonValue(makeAnimation(1)));
+    array.addToArray(std::move(animation));
+    EXPECT_EQ(animation, nullptr);
+    EXPECT_EQ(array[0]["id"].getInt64Value(), 1);
+
+    // A value that can not be added is freed by its handle
+    JsonValue object(ValueType::JSON_OBJ);
+    object.addToObject(JsonValuePtr(new JsonValue(makeAnimation(2))), "animation");
+    try {
+        object.addToObject(JsonValuePtr(new JsonValue(makeAnimation(3))), "animation");
+        FAIL() << "Expected std::invalid_argument";
+    }
+    MY_CATCH("Duplicate key: 'animation'", std::invalid_argument)
+    EXPECT_EQ(object["animation"]["id"].getInt64Value(), 2);
+
+    // Values of an arena are owned by the arena
+    JsonArena arena;
+    JsonValuePtr inArena(arena.create<JsonValue>(ValueType::JSON_OBJ, &arena));
+    inArena.reset();
+}
+
+#endif //JSONPARSER_OWNERSHIPTESTS_H
@@ -0,0 +1,6 @@
+#ifndef JSONPARSER_PARALLEL_HPP
+#define JSONPARSER_PARALLEL_HPP
+
+#include "parallelTests.h"
+
+#endif //JSONPARSER_PARALLEL_HPP
@@ -0,0 +1,122 @@
+#ifndef JSONPARSER_PARALLELTESTS_H
+#define JSONPARSER_PARALLELTESTS_H
+
+#include "../BaseTest.h"
+#include "../../jsonParallelParser.h"
+
+/**
+ * Writes a value as short text, to compare complete documents.
+ */
+static std::string describe(const JsonValue& value)
+{
+    if (value.isArray()) {
+        std::string result = "[";
+        for (JsonValue* element : value.getArrayValue())
+            result += describe(*element)+",";
+        return result+"]";
+    }
+    if (value.isObject()) {
+        std::string result = "{";
+        for (const auto& member : value.getObjectValue())
+            result += std::string(member.first)+":"+describe(*member.second)+",";
+        return result+"}";
+    }
+    if (value.isString())
+        return "'"+value.getStringValue()+"'";
+    if (value.isNumber())
+        return std::to_string(value.getNumberValue());
+    if (value.isBool())
+        return value.getBoolValue() ? "true" : "false";
+    return "null";
+}
+
+/**
+ * Makes a root array of objects with strings that contain brackets, commas and quotes.
+ */
+static std::string makeRecords(int records)
+{
+    const char* texts[] = {R"(plain)", R"(with, comma)", R"(brackets ]}[{)", R"(escaped \" quote, ])",
+                           R"(backslash at the end \\)", R"(it's)", R"(\\\"[)"};
+    std::string text = "[\n";
+    for (int i = 0; i<records; i++) {
+        if (i>0)
+            text += i%3==0 ? ",\n" : ", ";
+        text += R"({"id": )"+std::to_string(i)+R"(, "text": ")"+texts[i%7]+R"(", "list": [)"+std::to_string(i%5)
+                +R"(, [], {"deep": [null, true]}], "empty": {}})";
+    }
+    return text+"\n]\n";
+}
+
+TEST_F(ValueTests, ParallelSameAsSerial) // NOLINT
+{
+    std::string text = makeRecords(30000);
+    JsonParallelParser parallel(8);
+    JsonParallelParser serial(1);
+    parallel.parseString(text);
+    serial.parseString(text);
+
+    ASSERT_EQ(parallel.root().getArrayValue().size(), 30000u);
+    EXPECT_EQ(describe(parallel.root()), describe(serial.root()));
+    EXPECT_EQ(parallel.root()[12345]["id"].getNumberValue(), 12345);
+    EXPECT_EQ(parallel.root()[12344]["text"].getStringValue(), "escaped \" quote, ]");
+    EXPECT_GT(parallel.memoryUsage(), 0u);
+
+    // Other roots are read by a single thread
+    parallel.parseString(R"({"a": [1, 2]})");
+    EXPECT_EQ(parallel.root()["a"][1].getNumberValue(), 2);
+    parallel.parseString(" [ ] ");
+    EXPECT_TRUE(parallel.root().getArrayValue().empty());
+    parallel.parseString("42");
+    EXPECT_EQ(parallel.root().getNumberValue(), 42);
+
+    // Single quoted strings can not be split safely
+    std::string singleQuotes = text;
+    singleQuotes.replace(singleQuotes.find("\"plain\""), 7, "'pl\"ain'");
+    parallel.parseString(singleQuotes);
+    EXPECT_EQ(parallel.root()[0]["text"].getStringValue(), "pl\"ain");
+    EXPECT_EQ(parallel.root().getArrayValue().size(), 30000u);
+
+    parallel.clear();
+    try {
+        parallel.root();
+        FAIL() << "Expected std::invalid_argument";
+    }
+    MY_CATCH("Nothing was parsed", std::invalid_argument)
+}
+
+TEST_F(ValueTests, ParallelErrors) // NOLINT
+{
+    JsonParallelParser parallel(8);
+    JsonParallelParser serial(1);
+    std::string valid = makeRecords(30000);
+    std::string broken[] = {valid, valid, valid, valid.substr(0, valid.size()-3)+",\n]", valid+"[]"};
+    broken[0].replace(broken[0].find("\"id\": 20000"), 11, "\"id\" 20000");
+    broken[1].replace(broken[1].find("{\"id\": 15000"), 1, "");
+    broken[2].replace(broken[2].find("true", valid.size()/2), 4, "tru");
+
+    for (const std::string& text : broken) {
+        std::string expected;
+        try {
+            serial.parseString(text);
+            FAIL() << "Expected ParseError";
+        }
+        catch (ParseError& e) {
+            expected = e.what();
+        }
+        try {
+            parallel.parseString(text);
+            FAIL() << "Expected ParseError";
+        }
+        catch (ParseError& e) {
+            EXPECT_EQ(std::string(e.what()), expected);
+        }
+    }
+
+    try {
+        parallel.parseString("  ");
+        FAIL() << "Expected ParseError";
+    }
+    MY_CATCH("Error at line 1: Missing root value", ParseError)
+}
+
+#endif //JSONPARSER_PARALLELTESTS_H
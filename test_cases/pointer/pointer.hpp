@@ -0,0 +1,6 @@
+#ifndef JSONPARSER_POINTER_HPP
+#define JSONPARSER_POINTER_HPP
+
+#include "pointerTests.h"
+
+#endif //JSONPARSER_POINTER_HPP
@@ -0,0 +1,93 @@
+#ifndef JSONPARSER_POINTERTESTS_H
+#define JSONPARSER_POINTERTESTS_H
+
+#include <type_traits>
+#include "../BaseTest.h"
+#include "../../jsonPointer.h"
+
+TEST_F(ParserTests, PointerExamples) // NOLINT
+{
+    // The example document of RFC 6901
+    parser->parseString(R"({"foo": ["bar", "baz"], "": 0, "a/b": 1, "c%d": 2, "e^f": 3, "g|h": 4, "i\\j": 5,
+                            "k\"l": 6, " ": 7, "m~n": 8})");
+    EXPECT_EQ(JsonPointer("").resolve(*parser), nullptr);
+    EXPECT_EQ(JsonPointer("/foo").resolve(*parser), &(*parser)["foo"]);
+    EXPECT_EQ(JsonPointer("/foo/0").resolve(*parser)->getStringValue(), "bar");
+    EXPECT_EQ(JsonPointer("/foo/1").resolve(*parser)->getStringValue(), "baz");
+    const char* keys[] = {"/", "/a~1b", "/c%d", "/e^f", "/g|h", "/i\\j", "/k\"l", "/ ", "/m~0n"};
+    for (int i = 0; i<9; i++) {
+        JsonValue* value = JsonPointer(keys[i]).resolve(*parser);
+        ASSERT_NE(value, nullptr) << keys[i];
+        EXPECT_EQ(value->getInt64Value(), i) << keys[i];
+    }
+
+    // Pointers that do not resolve
+    for (const char* missing : {"/foo/2", "/foo/-", "/foo/01", "/foo/bar", "/foo/0/0", "/missing", "/a~1b/c", "//"})
+        EXPECT_EQ(JsonPointer(missing).resolve(*parser), nullptr) << missing;
+
+    // Resolving from a value, "" is the value itself
+    JsonValue& foo = (*parser)["foo"];
+    EXPECT_EQ(JsonPointer("").resolve(foo), &foo);
+    EXPECT_EQ(JsonPointer("/1").resolve(foo)->getStringValue(), "baz");
+
+    // A const root gives const values
+    const JsonValue& constFoo = foo;
+    const JsonParser& constParser = *parser;
+    static_assert(std::is_same<decltype(JsonPointer("").resolve(constFoo)), const JsonValue*>::value, "const value");
+    static_assert(std::is_same<decltype(JsonPointer("").resolve(constParser)), const JsonValue*>::value,
+                  "const parser");
+    EXPECT_EQ(JsonPointer("").resolve(constFoo), &foo);
+    EXPECT_EQ(JsonPointer("/0").resolve(constFoo)->getStringValue(), "bar");
+    EXPECT_EQ(JsonPointer("/foo/1").resolve(constParser), JsonPointer("/foo/1").resolve(*parser));
+
+    JsonPointer pointer("/a~1b/~0");
+    EXPECT_EQ(pointer.size(), 2u);
+    EXPECT_EQ(pointer.str(), "/a~1b/~0");
+}
+
+TEST_F(ParserTests, PointerManyDocuments) // NOLINT
+{
+    // Numeric keys of objects and keys of objects with a hash index
+    JsonPointer pointer("/animations/1/frame_time");
+    JsonPointer numbered("/objects/3/key 19");
+    std::vector<std::unique_ptr<JsonParser>> documents;
+    for (int i = 0; i<10; i++) {
+        std::string json = R"({"animations": [{"frame_time": 0}, {"frame_time": )"+std::to_string(i)+R"(}], "objects": {)";
+        for (int j = 0; j<20; j++)
+            json += (j==0 ? "\"" : ", \"")+std::to_string(j)+R"(": {"key 19": )"+std::to_string(i*100+j)+"}";
+        json += "}}";
+        documents.emplace_back(new JsonParser());
+        documents.back()->parseString(json);
+    }
+    for (int i = 0; i<10; i++) {
+        ASSERT_NE(pointer.resolve(*documents[i]), nullptr);
+        EXPECT_EQ(pointer.resolve(*documents[i])->getInt64Value(), i);
+        EXPECT_EQ(numbered.resolve(*documents[i])->getInt64Value(), i*100+3);
+    }
+
+    parser->parse(TEST_PATH "complex/animation.json");
+    EXPECT_DOUBLE_EQ(pointer.resolve(*parser)->getNumberValue(), 0.8);
+    EXPECT_EQ(JsonPointer("/animations/2/frame_time").resolve(*parser), nullptr);
+    EXPECT_EQ(JsonPointer("/animations/1/frame_time").resolve(JsonParser()), nullptr);
+}
+
+TEST_F(ValueTests, PointerSyntax) // NOLINT
+{
+    try {
+        JsonPointer("foo");
+        FAIL() << "Expected std::invalid_argument";
+    }
+    MY_CATCH("Invalid JSON pointer 'foo', it must start with '/'", std::invalid_argument)
+    try {
+        JsonPointer("/a~2b");
+        FAIL() << "Expected std::invalid_argument";
+    }
+    MY_CATCH("Invalid escape sequence in JSON pointer '/a~2b'", std::invalid_argument)
+    try {
+        JsonPointer("/a~");
+        FAIL() << "Expected std::invalid_argument";
+    }
+    MY_CATCH("Invalid escape sequence in JSON pointer '/a~'", std::invalid_argument)
+}
+
+#endif //JSONPARSER_POINTERTESTS_H
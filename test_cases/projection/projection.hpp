@@ -0,0 +1,6 @@
+#ifndef JSONPARSER_PROJECTION_HPP
+#define JSONPARSER_PROJECTION_HPP
+
+#include "projectionTests.h"
+
+#endif //JSONPARSER_PROJECTION_HPP
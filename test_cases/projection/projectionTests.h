@@ -0,0 +1,76 @@
+#ifndef JSONPARSER_PROJECTIONTESTS_H
+#define JSONPARSER_PROJECTIONTESTS_H
+
+#include "../BaseTest.h"
+#include "../../jsonProjection.h"
+
+TEST_F(ParserTests, ProjectionPointers) // NOLINT
+{
+    JsonProjection projection{"/file", "/tile_size/width", "/animations/name", "/animations/frame_time"};
+    parser->parse(TEST_PATH "complex/animation.json", projection);
+    EXPECT_EQ(parser->dump(), R"({"file":"animation.png","tile_size":{"width":32},"animations":[)"
+                              R"({"name":"walk_right","frame_time":0.2},{"name":"idle_front","frame_time":0.8}]})");
+    size_t projected = parser->memoryUsage();
+
+    // A whole value, paths below it are part of it
+    parser->parse(TEST_PATH "complex/animation.json", JsonProjection{"/transitions/id", "/transitions"});
+    EXPECT_EQ(parser->dump(), R"({"transitions":[{"id":0,"name":"idle->walk_right","from":"idle_front",)"
+                              R"("to":"walk_right","blend":false,"wait_end":false}]})");
+
+    // "" keeps everything, an empty projection keeps nothing
+    JsonParser full(TEST_PATH "complex/animation.json");
+    parser->parse(TEST_PATH "complex/animation.json", JsonProjection{""});
+    EXPECT_EQ(parser->dump(), full.dump());
+    EXPECT_LT(projected, full.memoryUsage());
+    parser->parse(TEST_PATH "complex/animation.json", JsonProjection());
+    EXPECT_EQ(parser->dump(), "{}");
+
+    // Scalars where an object is expected are dropped, objects are kept to keep the indices of arrays
+    parser->parseString(R"({"a": [1, {"b": 2, "c": 3}, {"c": 4}, [{"b": 5}]], "a~/b": "x", "d": "e"})",
+                        JsonProjection{"/a/b", "/d/e", "/a~0~1b"});
+    EXPECT_EQ(parser->dump(), R"({"a":[{"b":2},{},[{"b":5}]],"a~/b":"x"})");
+}
+
+TEST_F(ParserTests, ProjectionTree) // NOLINT
+{
+    JsonParser tree;
+    tree.parseString(R"({"border": true, "animations": {"id": true, "loop": true}, "tile_size": {}})");
+    JsonProjection projection(tree);
+    parser->parse(TEST_PATH "complex/animation.json", projection);
+    EXPECT_EQ(parser->dump(), R"({"tile_size":{},"border":1,"animations":[{"id":0,"loop":true},{"id":1,"loop":true}]})");
+
+    // The same projection parses many documents
+    for (int i = 0; i<3; i++) {
+        parser->parseString(R"({"animations": [{"id": )"+std::to_string(i)+R"(, "name": "a"}], "border": 2})",
+                            projection);
+        EXPECT_EQ(parser->dump(), R"({"animations":[{"id":)"+std::to_string(i)+R"(}],"border":2})");
+    }
+
+    tree.parseString(R"({"animations": {"id": 1}})");
+    try {
+        JsonProjection invalid(tree);
+        FAIL() << "Expected std::invalid_argument";
+    }
+    MY_CATCH("Invalid projection of 'id', expected true or an object", std::invalid_argument)
+}
+
+TEST_F(ParserTests, ProjectionSkipsValues) // NOLINT
+{
+    JsonProjection projection{"/b"};
+
+    // Skipped values are not validated, brackets in strings are no brackets
+    parser->parseString(R"({"a": [1, tru, {"x": }, "]}"], "b": 1, "c": {"[": "{"}})", projection);
+    EXPECT_EQ(parser->dump(), R"({"b":1})");
+
+    // Without a structural index, ex. because of single quotes
+    parser->parseString(R"({'a': {'x': "}", "y": '{'}, 'b': 2})", projection);
+    EXPECT_EQ(parser->dump(), R"({"b":2})");
+
+    // The values that are read are still validated, and skipped values must end
+    EXPECT_THROW(parser->parseString(R"({"a": 1, "b": tru})", projection), ParseError);
+    EXPECT_THROW(parser->parseString(R"({"a": [1, 2, "b": 1})", projection), ParseError);
+    EXPECT_THROW(parser->parseString(R"({"a": "x)", projection), ParseError);
+    EXPECT_THROW(parser->parseString(R"({"a" 1, "b": 1})", projection), ParseError);
+}
+
+#endif //JSONPARSER_PROJECTIONTESTS_H
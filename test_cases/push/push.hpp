@@ -0,0 +1,6 @@
+#ifndef JSONPARSER_PUSH_HPP
+#define JSONPARSER_PUSH_HPP
+
+#include "pushTests.h"
+
+#endif //JSONPARSER_PUSH_HPP
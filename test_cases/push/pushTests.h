@@ -0,0 +1,131 @@
+#ifndef JSONPARSER_PUSHTESTS_H
+#define JSONPARSER_PUSHTESTS_H
+
+#include <fstream>
+#include <sstream>
+#include "../BaseTest.h"
+#include "../reader/readerTests.h"
+#include "../../jsonPushParser.h"
+
+/**
+ * Feed a text to a push parser in chunks of the same size.
+ */
+static void feedInChunks(JsonPushParser& parser, const std::string& text, size_t chunkSize)
+{
+    for (size_t i = 0; i<text.size(); i += chunkSize)
+        parser.feed(text.data()+i, std::min(chunkSize, text.size()-i));
+    parser.finish();
+}
+
+TEST_F(ValueTests, PushEventsAnyChunkSize) // NOLINT
+{
+    std::string text = "{\"a\": [1, 2.5, \"x\\ty\", -30],\n \"b\": {\"c\": null, \"d\": [[], {}]},"
+                       " \"e\": true, \"f\": false, \"g\": \"\\\"quoted\\\"\"}  ";
+    JsonReader reader;
+    RecordingHandler expected;
+    reader.parseString(text, expected);
+
+    for (size_t chunkSize = 1; chunkSize<=text.size(); ++chunkSize) {
+        RecordingHandler handler;
+        JsonPushParser parser(handler);
+        feedInChunks(parser, text, chunkSize);
+        EXPECT_EQ(handler.events, expected.events) << "chunk size " << chunkSize;
+        EXPECT_FALSE(parser.started());
+    }
+}
+
+TEST_F(ParserTests, PushAnimationExample) // NOLINT
+{
+    std::ifstream file(TEST_PATH "complex/animation.json");
+    std::stringstream content;
+    content << file.rdbuf();
+    std::string text = content.str();
+
+    JsonParser expected;
+    expected.parseString(text);
+    for (size_t chunkSize : {1, 7, 4096}) {
+        for (size_t i = 0; i<text.size(); i += chunkSize)
+            parser->feed(text.data()+i, std::min(chunkSize, text.size()-i));
+        parser->finish();
+        EXPECT_EQ(parser->memoryUsage(), expected.memoryUsage());
+        EXPECT_EQ((*parser)["file"].getStringValue(), "animation.png");
+        EXPECT_EQ((*parser)["tile_size"]["height"].getNumberValue(), 32);
+        ASSERT_EQ((*parser)["animations"].getArrayValue().size(), 2);
+        EXPECT_EQ((*parser)["animations"][0]["frame_time"].getNumberValue(), 0.2);
+    }
+}
+
+TEST_F(ValueTests, PushPendingBytes) // NOLINT
+{
+    RecordingHandler handler;
+    JsonPushParser parser(handler);
+    parser.feed("{\"key\": \"a long");
+    EXPECT_EQ(parser.pendingBytes(), 7u);
+    parser.feed(" string\", \"n\": 12");
+    EXPECT_EQ(parser.pendingBytes(), 2u);
+    parser.feed("34}");
+    EXPECT_EQ(parser.pendingBytes(), 0u);
+    EXPECT_EQ(handler.events, "{ key: 'a long string' n: i1234 } ");
+    parser.finish();
+}
+
+TEST_F(ParserTests, PushErrors) // NOLINT
+{
+    try {
+        parser->feed("{\"a\": 1,\n\"b\": tr");
+        parser->feed("ue,\n\"c\": [1, 2}");
+        FAIL() << "Expected ParseError";
+    }
+    MY_CATCH("Error at line 3:\n|\n}\nUnexpected token: '}'", ParseError)
+
+    try {
+        parser->feed("{\"a\": fa");
+        parser->feed("lsy}");
+        FAIL() << "Expected ParseError";
+    }
+    MY_CATCH("Error at line 1:\n|\nfalsy\nUnexpected token: 'f'", ParseError)
+
+    try {
+        parser->feed("{\"a\": \"not");
+        parser->feed(" closed");
+        parser->finish();
+        FAIL() << "Expected ParseError";
+    }
+    MY_CATCH("Error at line 1: Missing closing \"", ParseError)
+
+    try {
+        parser->feed("{\"a\": [1,\n");
+        parser->feed("2");
+        parser->finish();
+        FAIL() << "Expected ParseError";
+    }
+    MY_CATCH("Error at line 2:\n|\nEND OF FILE\nUnbalanced []", ParseError)
+
+    try {
+        parser->finish();
+        FAIL() << "Expected ParseError";
+    }
+    MY_CATCH("Error at line 1: Missing root '{'", ParseError)
+
+    // The parser can be used again after an error
+    parser->feed("{\"a\": ");
+    parser->feed("1}");
+    parser->finish();
+    EXPECT_EQ((*parser)["a"].getNumberValue(), 1);
+
+    // A duplicate key also ends the document, the rest of its chunks are not continued
+    try {
+        parser->feed("{\"a\": 1, ");
+        parser->feed("\"a\": 2, \"b\": [");
+        FAIL() << "Expected std::invalid_argument";
+    }
+    MY_CATCH("There already is a key 'a'", std::invalid_argument)
+    parser->feed("{\"c\": ");
+    parser->feed("3}");
+    parser->finish();
+    EXPECT_EQ((*parser)["c"].getNumberValue(), 3);
+    EXPECT_FALSE(parser->hasKey("a"));
+    EXPECT_FALSE(parser->hasKey("b"));
+}
+
+#endif //JSONPARSER_PUSHTESTS_H
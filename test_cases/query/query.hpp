@@ -0,0 +1,6 @@
+#ifndef JSONPARSER_QUERY_HPP
+#define JSONPARSER_QUERY_HPP
+
+#include "queryTests.h"
+
+#endif //JSONPARSER_QUERY_HPP
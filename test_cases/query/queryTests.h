@@ -0,0 +1,140 @@
+#ifndef JSONPARSER_QUERYTESTS_H
+#define JSONPARSER_QUERYTESTS_H
+
+#include "../BaseTest.h"
+#include "../../jsonQuery.h"
+
+/**
+ * Get the string values of a query result, values that are no string are written as json.
+ */
+static std::vector<std::string> queryStrings(const std::vector<JsonValue*>& values)
+{
+    std::vector<std::string> result;
+    for (const JsonValue* value : values)
+        result.push_back(value->isString() ? value->getStringValue() : value->dump());
+    return result;
+}
+
+TEST_F(ParserTests, QuerySelectors) // NOLINT
+{
+    parser->parse(TEST_PATH "complex/animation.json");
+    using Strings = std::vector<std::string>;
+    EXPECT_EQ(queryStrings(JsonQuery("$.file").evaluate(*parser)), Strings{"animation.png"});
+    EXPECT_EQ(queryStrings(JsonQuery("$['tile_size'][\"width\"]").evaluate(*parser)), Strings{"32"});
+    EXPECT_EQ(queryStrings(JsonQuery("$.tile_size.*").evaluate(*parser)), (Strings{"32", "32"}));
+    EXPECT_EQ(queryStrings(JsonQuery("$.animations[*].name").evaluate(*parser)),
+              (Strings{"walk_right", "idle_front"}));
+    EXPECT_EQ(queryStrings(JsonQuery("$.animations[-1].name").evaluate(*parser)), Strings{"idle_front"});
+    EXPECT_EQ(queryStrings(JsonQuery("$.animations[ 0 ].id").evaluate(*parser)), Strings{"0"});
+    EXPECT_EQ(queryStrings(JsonQuery("$..name").evaluate(*parser)),
+              (Strings{"walk_right", "idle_front", "idle->walk_right"}));
+    EXPECT_EQ(queryStrings(JsonQuery("$..[0].id").evaluate(*parser)), (Strings{"0", "0"}));
+    EXPECT_EQ(JsonQuery("$..*").evaluate(*parser).size(), 33u);
+
+    // Selectors that do not match anything
+    for (const char* missing : {"$", "$.missing", "$.file.name", "$.animations[2]", "$.animations[-3]",
+                                "$.animations.name", "$.tile_size[0]"})
+        EXPECT_TRUE(JsonQuery(missing).evaluate(*parser).empty()) << missing;
+    EXPECT_TRUE(JsonQuery("$.file").evaluate(JsonParser()).empty());
+
+    // Starting from a value, $ is the value itself
+    JsonValue& animations = (*parser)["animations"];
+    EXPECT_EQ(JsonQuery("$").evaluate(animations), std::vector<JsonValue*>{&animations});
+    EXPECT_EQ(queryStrings(JsonQuery("$[1].name").evaluate(animations)), Strings{"idle_front"});
+
+    // A const root gives const values
+    const JsonValue& constAnimations = animations;
+    const JsonParser& constParser = *parser;
+    EXPECT_EQ(JsonQuery("$").evaluate(constAnimations), std::vector<const JsonValue*>{&animations});
+    std::vector<const JsonValue*> names = JsonQuery("$..name").evaluate(constParser);
+    std::vector<JsonValue*> mutableNames = JsonQuery("$..name").evaluate(*parser);
+    EXPECT_EQ(names, std::vector<const JsonValue*>(mutableNames.begin(), mutableNames.end()));
+    EXPECT_EQ(JsonQuery("$..name").evaluate(constAnimations).size(), 2u);
+}
+
+TEST_F(ParserTests, QueryFilters) // NOLINT
+{
+    parser->parse(TEST_PATH "complex/animation.json");
+    using Strings = std::vector<std::string>;
+    auto names = [this](const char* query) {
+        return queryStrings(JsonQuery(query).evaluate(*parser));
+    };
+    EXPECT_EQ(names("$.animations[?(@.loop == true)].name"), (Strings{"walk_right", "idle_front"}));
+    EXPECT_EQ(names("$.animations[?(@.frame_time > 0.5)].name"), Strings{"idle_front"});
+    EXPECT_EQ(names("$.animations[?(0.5 > @.frame_time)].name"), Strings{"walk_right"});
+    EXPECT_EQ(names("$.animations[?(@.name == 'walk_right')].id"), Strings{"0"});
+    EXPECT_EQ(names("$.animations[?(@.name != \"walk_right\")].id"), Strings{"1"});
+    EXPECT_EQ(names("$.animations[?(@.name < 'j')].name"), Strings{"idle_front"});
+    EXPECT_EQ(names("$.animations[?(@.default)].name"), Strings{"idle_front"});
+    EXPECT_EQ(names("$.animations[?(!@.default)].name"), Strings{"walk_right"});
+    EXPECT_EQ(names("$.animations[?(@.id == 0 || @.default == true)].name"), (Strings{"walk_right", "idle_front"}));
+    EXPECT_EQ(names("$.animations[?((@.id == 0 || @.id == 1) && @['sprite_count'] >= 8)].id"),
+              (Strings{"0", "1"}));
+    EXPECT_EQ(names("$.animations[?(@.id <= 0 && !(@.pingpong == true))].name"), Strings{"walk_right"});
+    EXPECT_EQ(names("$..[?(@.to == 'walk_right')].name"), Strings{"idle->walk_right"});
+    EXPECT_EQ(names("$.tile_size[?(@ == 32)]"), (Strings{"32", "32"}));
+
+    // Values of other types and missing values are unequal to everything and not ordered
+    EXPECT_EQ(names("$.animations[?(@.default != true)].name"), Strings{"walk_right"});
+    EXPECT_TRUE(names("$.animations[?(@.name > 0)]").empty());
+    EXPECT_TRUE(names("$.animations[?(@.missing == null)]").empty());
+    EXPECT_TRUE(names("$.animations[?(@.frame_time <= 'a')]").empty());
+}
+
+TEST_F(ParserTests, QueryLiterals) // NOLINT
+{
+    parser->parseString(R"({"values": [null, true, false, 0, 1, -1, 1.5, 9007199254740993, 18446744073709551615,
+                                       -9223372036854775808, "1", "", [], {}]})");
+    auto count = [this](const char* query) {
+        return JsonQuery(query).evaluate(*parser).size();
+    };
+    // Numbers 0 and 1 are no bools
+    EXPECT_EQ(count("$.values[?(@ == true)]"), 1u);
+    EXPECT_EQ(count("$.values[?(@ == false)]"), 1u);
+    EXPECT_EQ(count("$.values[?(@ == null)]"), 1u);
+    EXPECT_EQ(count("$.values[?(@ == 1)]"), 1u);
+    EXPECT_EQ(count("$.values[?(@ == 1.0)]"), 1u);
+    EXPECT_EQ(count("$.values[?(@ == '1')]"), 1u);
+    EXPECT_EQ(count("$.values[?(@ == '')]"), 1u);
+    EXPECT_EQ(count("$.values[?(@ >= 0)]"), 5u);
+    EXPECT_EQ(count("$.values[?(@ < 0)]"), 2u);
+    EXPECT_EQ(count("$.values[?(@ != 1)]"), 13u);
+
+    // Integers are compared exactly
+    EXPECT_EQ(count("$.values[?(@ > 9007199254740992)]"), 2u);
+    EXPECT_EQ(count("$.values[?(@ == 9007199254740993)]"), 1u);
+    EXPECT_EQ(count("$.values[?(@ == 18446744073709551615)]"), 1u);
+    EXPECT_EQ(count("$.values[?(@ < -9223372036854775807)]"), 1u);
+
+    // Escape sequences in strings
+    parser->parseString(R"({"a'b": 1, "list": [{"k": "x\ty"}]})");
+    EXPECT_EQ(count(R"($['a\'b'])"), 1u);
+    EXPECT_EQ(count(R"($.list[?(@.k == "x\ty")])"), 1u);
+}
+
+TEST_F(ValueTests, QuerySyntax) // NOLINT
+{
+    const char* invalid[][2] = {
+            {"animations", "Invalid query 'animations' at position 0: expected '$'"},
+            {"$.", "Invalid query '$.' at position 2: expected a key"},
+            {"$animations", "Invalid query '$animations' at position 1: expected '.' or '['"},
+            {"$[1", "Invalid query '$[1' at position 3: expected ']'"},
+            {"$[x]", "Invalid query '$[x]' at position 2: expected an index"},
+            {"$['x]", "Invalid query '$['x]' at position 5: expected '''"},
+            {"$[?(@.a == )]", "Invalid query '$[?(@.a == )]' at position 11: expected a literal"},
+            {"$[?(@.a == trueish)]", "Invalid query '$[?(@.a == trueish)]' at position 15: expected a literal"},
+            {"$[?(1 == 2)]", "Invalid query '$[?(1 == 2)]' at position 9: expected a path starting with '@'"},
+            {"$[?(@.a == 1]", "Invalid query '$[?(@.a == 1]' at position 12: expected ')'"},
+            {"$[?(@[-1])]", "Invalid query '$[?(@[-1])]' at position 6: expected an index"},
+    };
+    for (auto& entry : invalid) {
+        try {
+            JsonQuery query(entry[0]);
+            FAIL() << "Expected std::invalid_argument for " << entry[0];
+        }
+        MY_CATCH(entry[1], std::invalid_argument)
+    }
+    EXPECT_EQ(JsonQuery("$..a[?(@.b)]").str(), "$..a[?(@.b)]");
+}
+
+#endif //JSONPARSER_QUERYTESTS_H
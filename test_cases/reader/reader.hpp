@@ -0,0 +1,6 @@
+#ifndef JSONPARSER_READER_HPP
+#define JSONPARSER_READER_HPP
+
+#include "readerTests.h"
+
+#endif //JSONPARSER_READER_HPP
@@ -0,0 +1,118 @@
+#ifndef JSONPARSER_READERTESTS_H
+#define JSONPARSER_READERTESTS_H
+
+#include "../BaseTest.h"
+#include "../../jsonReader.h"
+#include "../../jsonCursor.h"
+
+/**
+ * Writes every event as a short token.
+ */
+struct RecordingHandler : public JsonHandler {
+    std::string events;
+
+    void startObject() override
+    {
+        events += "{ ";
+    }
+
+    void key(JsonStringView key) override
+    {
+        events += std::string(key)+": ";
+    }
+
+    void endObject() override
+    {
+        events += "} ";
+    }
+
+    void startArray() override
+    {
+        events += "[ ";
+    }
+
+    void endArray() override
+    {
+        events += "] ";
+    }
+
+    void string(JsonStringView value) override
+    {
+        events += "'"+std::string(value)+"' ";
+    }
+
+    void number(const JsonNumber& value) override
+    {
+        events += (value.kind==JsonNumber::DOUBLE ? "d" : "i")+std::to_string(static_cast<int64_t>(value.toDouble()))
+                +" ";
+    }
+
+    void boolean(bool value) override
+    {
+        events += value ? "true " : "false ";
+    }
+
+    void null() override
+    {
+        events += "null ";
+    }
+};
+
+TEST_F(ValueTests, ReaderEvents) // NOLINT
+{
+    JsonReader reader;
+    RecordingHandler handler;
+    reader.parseString(R"({"a": [1, 2.5, "x\ty"], "b": {"c": null, "d": [[], {}]}, "e": true, "f": false})",
+                       handler);
+    EXPECT_EQ(handler.events, "{ a: [ i1 d2 'x\ty' ] b: { c: null d: [ [ ] { } ] } e: true f: false } ");
+
+    // A default handler ignores everything
+    JsonHandler ignore;
+    reader.parse(TEST_PATH "complex/animation.json", ignore);
+}
+
+TEST_F(ValueTests, ReaderSingleValue) // NOLINT
+{
+    JsonReader reader;
+    RecordingHandler handler;
+    std::string text = R"([1, {"a": "b"}], "next")";
+    JsonCursor cursor(text.data(), text.size());
+    reader.readValue(cursor, handler);
+    EXPECT_EQ(handler.events, "[ i1 { a: 'b' } ] ");
+    EXPECT_EQ(cursor.peek(), ',');
+
+    handler.events.clear();
+    cursor.advance(2);
+    reader.readValue(cursor, handler);
+    EXPECT_EQ(handler.events, "'next' ");
+    EXPECT_TRUE(cursor.atEnd());
+}
+
+TEST_F(ValueTests, ReaderErrors) // NOLINT
+{
+    JsonReader reader;
+    RecordingHandler handler;
+    try {
+        reader.parseString(R"({"a": [1, 2}})", handler);
+        FAIL() << "Expected ParseError";
+    }
+    MY_CATCH("Error at line 1:\n|\n}}\nUnexpected token: '}'", ParseError)
+    // Events up to the error have been passed on
+    EXPECT_EQ(handler.events, "{ a: [ i1 i2 ");
+
+    // Exceptions of the handler stop the reader
+    struct StopAtKey : public JsonHandler {
+        void key(JsonStringView key) override
+        {
+            if (key=="stop")
+                throw std::runtime_error("stopped");
+        }
+    } stop;
+    try {
+        reader.parseString(R"({"go": 1, "stop": 2})", stop);
+        FAIL() << "Expected std::runtime_error";
+    }
+    MY_CATCH("stopped", std::runtime_error)
+}
+
+#endif //JSONPARSER_READERTESTS_H
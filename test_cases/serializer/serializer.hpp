@@ -0,0 +1,6 @@
+#ifndef JSONPARSER_SERIALIZER_HPP
+#define JSONPARSER_SERIALIZER_HPP
+
+#include "serializerTests.h"
+
+#endif //JSONPARSER_SERIALIZER_HPP
@@ -0,0 +1,149 @@
+#ifndef JSONPARSER_SERIALIZERTESTS_H
+#define JSONPARSER_SERIALIZERTESTS_H
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <sstream>
+#include "../BaseTest.h"
+#include "../../jsonSerializer.h"
+
+/**
+ * Formats a double with JsonFormat.
+ */
+static std::string formatDouble(double value)
+{
+    char buffer[JsonFormat::MAX_NUMBER_LENGTH];
+    return std::string(buffer, JsonFormat::writeDouble(value, buffer));
+}
+
+TEST_F(ParserTests, SerializeCompactAndPretty) // NOLINT
+{
+    std::string file = TEST_PATH "complex/objectarray.json";
+    parser->parse(file);
+    EXPECT_EQ(parser->dump(), R"({"array":[{"name":"object1","id":1},{"name":"object2","id":3,"dead":true}],"nepper":true})");
+
+    // The file itself is indented with two spaces
+    std::ifstream stream(file);
+    std::stringstream text;
+    text << stream.rdbuf();
+    EXPECT_EQ(parser->dump(2), text.str());
+    EXPECT_EQ((*parser)["array"][1].dump(), R"({"name":"object2","id":3,"dead":true})");
+
+    parser->parseString(R"({"empty": {}, "list": [], "number": 10.0, "null": null})");
+    EXPECT_EQ(parser->dump(4), "{\n    \"empty\": {},\n    \"list\": [],\n    \"number\": 10.0,\n    \"null\": null\n}");
+
+    JsonParser empty;
+    try {
+        empty.dump();
+        FAIL() << "Expected std::invalid_argument";
+    }
+    MY_CATCH("JsonParser is empty", std::invalid_argument)
+}
+
+TEST_F(ParserTests, SerializeRoundTrip) // NOLINT
+{
+    for (const char* file : {"array/array.json", "basics/empty.json", "bool/bool.json", "complex/animation.json",
+                             "complex/multiple.json", "complex/nested_object.json", "null/null1.json",
+                             "number/number.json", "object/object.json", "string/string6.json"}) {
+        parser->parse(std::string(TEST_PATH)+file);
+        for (int indent : {0, 2}) {
+            std::string text = parser->dump(indent);
+            JsonParser reparsed;
+            reparsed.parseString(text);
+            EXPECT_EQ(reparsed.dump(indent), text) << file;
+        }
+    }
+}
+
+TEST_F(ValueTests, FormatNumbers) // NOLINT
+{
+    EXPECT_EQ(formatDouble(0.0), "0.0");
+    EXPECT_EQ(formatDouble(-0.0), "-0.0");
+    EXPECT_EQ(formatDouble(0.1), "0.1");
+    EXPECT_EQ(formatDouble(0.1+0.2), "0.30000000000000004");
+    EXPECT_EQ(formatDouble(-1.5), "-1.5");
+    EXPECT_EQ(formatDouble(100.0), "100.0");
+    EXPECT_EQ(formatDouble(1e20), "100000000000000000000.0");
+    EXPECT_EQ(formatDouble(1e21), "1e21");
+    EXPECT_EQ(formatDouble(0.000001234), "0.000001234");
+    EXPECT_EQ(formatDouble(1e-7), "1e-7");
+    EXPECT_EQ(formatDouble(1.5e300), "1.5e300");
+    EXPECT_EQ(formatDouble(5e-324), "5e-324");
+    EXPECT_EQ(formatDouble(std::numeric_limits<double>::max()), "1.7976931348623157e308");
+    EXPECT_EQ(formatDouble(std::numeric_limits<double>::infinity()), "null");
+    EXPECT_EQ(formatDouble(std::numeric_limits<double>::quiet_NaN()), "null");
+
+    // Every double reads back as itself
+    std::mt19937_64 random(42);
+    for (int i = 0; i<100000; i++) {
+        uint64_t bits = random();
+        double value;
+        memcpy(&value, &bits, sizeof(value));
+        if (value!=value || value-value!=0)
+            continue;
+        std::string text = formatDouble(value);
+        JsonNumber number{};
+        ASSERT_EQ(JsonNumber::parse(text.data(), text.data()+text.size(), number), text.data()+text.size()) << text;
+        ASSERT_EQ(number.kind, JsonNumber::DOUBLE) << text;
+        ASSERT_EQ(memcmp(&number.double_value, &value, sizeof(value)), 0) << text;
+    }
+
+    char buffer[JsonFormat::MAX_NUMBER_LENGTH];
+    EXPECT_EQ(std::string(buffer, JsonFormat::writeInt64(0, buffer)), "0");
+    EXPECT_EQ(std::string(buffer, JsonFormat::writeInt64(-42, buffer)), "-42");
+    EXPECT_EQ(std::string(buffer, JsonFormat::writeInt64(std::numeric_limits<int64_t>::min(), buffer)),
+              "-9223372036854775808");
+    EXPECT_EQ(std::string(buffer, JsonFormat::writeUInt64(std::numeric_limits<uint64_t>::max(), buffer)),
+              "18446744073709551615");
+}
+
+TEST_F(ParserTests, SerializeStrings) // NOLINT
+{
+    JsonValue value(std::string("quote \" backslash \\ slash / tab \t newline \n bell \x07 \xc3\xa9"));
+    EXPECT_EQ(value.dump(), R"("quote \" backslash \\ slash / tab \t newline \n bell \u0007 )" "\xc3\xa9\"");
+
+    parser->parseString(R"({"key \"quoted\"": "line\nbreak", "unicode": "é\u0001"})");
+    std::string text = parser->dump();
+    EXPECT_EQ(text, R"({"key \"quoted\"":"line\nbreak","unicode":")" "\xc3\xa9" R"(\u0001"})");
+    JsonParser reparsed;
+    reparsed.parseString(text);
+    EXPECT_EQ(reparsed["key \"quoted\""].getStringValue(), "line\nbreak");
+}
+
+TEST_F(ParserTests, SerializeToFileDescriptor) // NOLINT
+{
+    // Larger than a block, so the text is written in several blocks
+    std::string json = R"({"values": [)";
+    for (int i = 0; i<20000; i++)
+        json += (i==0 ? "" : ", ")+std::string(R"({"id": )")+std::to_string(i)+R"(, "name": "value )"
+                +std::to_string(i)+R"(", "ratio": )"+std::to_string(i/7.0)+"}";
+    json += "]}";
+    parser->parseString(json);
+
+    JsonSerializer serializer(2);
+    std::string expected(serializer.serialize(*parser));
+    ASSERT_GT(expected.size(), JsonSerializer::BLOCK_SIZE*2);
+
+    FILE* file = tmpfile();
+    ASSERT_NE(file, nullptr);
+    serializer.serialize(*parser, fileno(file));
+    rewind(file);
+    std::string written(expected.size()+1, '\0');
+    written.resize(fread(&written[0], 1, written.size(), file));
+    fclose(file);
+    EXPECT_EQ(written, expected);
+
+    try {
+        serializer.serialize((*parser)["values"], -1);
+        FAIL() << "Expected std::invalid_argument";
+    }
+    MY_CATCH("Can not write to file descriptor -1", std::invalid_argument)
+    // The serializer can still be used after an error
+    EXPECT_EQ(serializer.serialize((*parser)["values"][0]), "{\n  \"id\": 0,\n  \"name\": \"value 0\",\n  \"ratio\": 0.0\n}");
+}
+
+#endif //JSONPARSER_SERIALIZERTESTS_H
@@ -0,0 +1,45 @@
+#ifndef JSONPARSER_SMALLSTRING_H
+#define JSONPARSER_SMALLSTRING_H
+
+#include "../BaseTest.h"
+
+TEST_F(ValueTests, StringStorage) // NOLINT
+{
+    EXPECT_EQ(sizeof(JsonValue), 16);
+
+    // Around the inline capacity of 14 characters
+    for (size_t length : {0, 1, 13, 14, 15, 16, 100}) {
+        std::string text;
+        for (size_t i = 0; i<length; i++)
+            text += static_cast<char>('a'+i%26);
+
+        auto* value = new JsonValue(ValueType::JSON_STRING, text);
+        EXPECT_EQ(value->getStringValue(), text);
+
+        // Clones copy the storage, moves take it over
+        JsonValue copy = value->clone();
+        delete value;
+        EXPECT_EQ(copy.getStringValue(), text);
+        JsonValue moved = std::move(copy);
+        EXPECT_EQ(moved.getStringValue(), text);
+        EXPECT_TRUE(copy.isNull());
+
+        JsonArena arena;
+        auto* arenaValue = arena.create<JsonValue>(ValueType::JSON_STRING, text, &arena);
+        EXPECT_EQ(arenaValue->getStringValue(), text);
+    }
+
+    // Strings may contain null characters
+    auto value = JsonValue(ValueType::JSON_STRING, std::string("a\0b", 3));
+    EXPECT_EQ(value.getStringValue(), std::string("a\0b", 3));
+}
+
+TEST_F(ParserTests, StringStorageParsed) // NOLINT
+{
+    parser->parseString(R"({"short": "walk_right", "full": "abcdefghijklmn", "long": "abcdefghijklmnopqrstuvwxyz"})");
+    EXPECT_EQ((*parser)["short"].getStringValue(), "walk_right");
+    EXPECT_EQ((*parser)["full"].getStringValue(), "abcdefghijklmn");
+    EXPECT_EQ((*parser)["long"].getStringValue(), "abcdefghijklmnopqrstuvwxyz");
+}
+
+#endif //JSONPARSER_SMALLSTRING_H
@@ -0,0 +1,69 @@
+#ifndef JSONPARSER_STRINGVIEW_H
+#define JSONPARSER_STRINGVIEW_H
+
+#include <sstream>
+#include "../BaseTest.h"
+#include "../../jsonTape.h"
+
+TEST_F(ValueTests, StringView) // NOLINT
+{
+    JsonStringView empty;
+    EXPECT_TRUE(empty.empty());
+    JsonStringView view("walk_right");
+    EXPECT_EQ(view.size(), 10);
+    EXPECT_EQ(view, "walk_right");
+    EXPECT_EQ(view, std::string("walk_right"));
+    EXPECT_NE(view, "walk");
+    EXPECT_LT(JsonStringView("walk"), view);
+    EXPECT_EQ(view.substr(5), "right");
+    EXPECT_EQ(view.find('_'), 4);
+    EXPECT_EQ(view.find('x'), JsonStringView::npos);
+    EXPECT_EQ(std::string(view), "walk_right");
+
+    std::stringstream stream;
+    stream << view.substr(0, 4);
+    EXPECT_EQ(stream.str(), "walk");
+}
+
+TEST_F(ParserTests, StringViewAccess) // NOLINT
+{
+    parser->parseString(R"({"short": "walk_right", "long": "a string that does not fit inside the value", "number": 1})");
+
+    JsonValue& shortValue = (*parser)["short"];
+    EXPECT_EQ(shortValue.getStringView(), "walk_right");
+    EXPECT_STREQ(shortValue.c_str(), "walk_right");
+    // Views point to the stored characters, nothing is copied
+    EXPECT_EQ(shortValue.getStringView().data(), shortValue.c_str());
+
+    JsonValue& longValue = (*parser)["long"];
+    EXPECT_EQ(longValue.getStringView(), "a string that does not fit inside the value");
+    EXPECT_EQ(longValue.getStringView().data(), longValue.c_str());
+
+    try {
+        (*parser)["number"].getStringView();
+        FAIL() << "Expected std::invalid_argument";
+    }
+    MY_CATCH("Invalid type for: JsonString", std::invalid_argument)
+
+    try {
+        (*parser)["number"].c_str();
+        FAIL() << "Expected std::invalid_argument";
+    }
+    MY_CATCH("Invalid type for: JsonString", std::invalid_argument)
+
+    std::vector<std::string> keys;
+    JsonParser object;
+    object.parseString(R"({"outer": {"b": 1, "a": 2}})");
+    for (auto& member : object["outer"].getObjectValue()) {
+        JsonStringView key = member.first;
+        keys.emplace_back(key.data(), key.size());
+    }
+    EXPECT_EQ(keys, (std::vector<std::string>{"b", "a"}));
+
+    JsonTape tape;
+    tape.parseString(R"({"key": "value", "object": {"x": 1}})");
+    EXPECT_EQ(tape["key"].getStringView(), "value");
+    EXPECT_EQ(tape["object"].begin().keyView(), "x");
+}
+
+#endif //JSONPARSER_STRINGVIEW_H
@@ -2,6 +2,8 @@
 #define JSONPARSER_STRINGS_HPP
 
 #include "oneVar.h"
+#include "smallString.h"
+#include "stringView.h"
 
 
 #endif //JSONPARSER_STRINGS_HPP
@@ -0,0 +1,6 @@
+#ifndef JSONPARSER_STRUCTURAL_HPP
+#define JSONPARSER_STRUCTURAL_HPP
+
+#include "structuralTests.h"
+
+#endif //JSONPARSER_STRUCTURAL_HPP
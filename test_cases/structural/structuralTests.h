@@ -0,0 +1,93 @@
+#ifndef JSONPARSER_STRUCTURALTESTS_H
+#define JSONPARSER_STRUCTURALTESTS_H
+
+#include <fstream>
+#include <sstream>
+#include "../BaseTest.h"
+#include "../../jsonStructural.h"
+#include "../../jsonTape.h"
+
+TEST_F(ValueTests, StructuralPositions) // NOLINT
+{
+    std::string json = R"({"a": [1, true], "b\"c": "x y"})";
+    JsonStructuralIndex index;
+    ASSERT_TRUE(index.build(json.data(), json.size()));
+
+    std::vector<uint32_t> expected{0, 1, 3, 4, 6, 7, 8, 10, 14, 15, 17, 22, 23, 25, 29, 30};
+    EXPECT_EQ(index.positions(), expected);
+}
+
+TEST_F(ValueTests, StructuralUnusable) // NOLINT
+{
+    JsonStructuralIndex index;
+    std::string singleQuotes = "{'a': 1}";
+    std::string newLine = "{\"a\nb\": 1}";
+    std::string unterminated = "{\"a\": \"b";
+    EXPECT_FALSE(index.build(singleQuotes.data(), singleQuotes.size()));
+    EXPECT_FALSE(index.build(newLine.data(), newLine.size()));
+    EXPECT_FALSE(index.build(unterminated.data(), unterminated.size()));
+
+    // Single quotes inside double quoted strings are fine
+    std::string quoted = R"({"it's": 1})";
+    EXPECT_TRUE(index.build(quoted.data(), quoted.size()));
+}
+
+TEST_F(ValueTests, StructuralImplementations) // NOLINT
+{
+    // Escapes, quotes and tokens on every offset around the block boundaries
+    std::string json = "{";
+    for (int i = 0; i<200; i++) {
+        if (i>0)
+            json += ", ";
+        json += "\"k" + std::to_string(i) + "\": [\"" + std::string(i%7, '\\') + std::string(i%7, '\\')
+                + "\\\"" + std::string(i%5, 'x') + "\", " + std::to_string(i*13) + ", true, null]";
+    }
+    json += "}";
+
+    std::ifstream file(TEST_PATH "complex/animation.json");
+    std::stringstream animation;
+    animation << file.rdbuf();
+
+    for (const std::string& input : {json, animation.str()}) {
+        JsonStructuralIndex scalar;
+        ASSERT_TRUE(scalar.build(input.data(), input.size(), JsonStructuralIndex::SCALAR));
+        for (auto implementation : {JsonStructuralIndex::SSE2, JsonStructuralIndex::AVX2}) {
+            if (!JsonStructuralIndex::isSupported(implementation))
+                continue;
+            JsonStructuralIndex index;
+            ASSERT_TRUE(index.build(input.data(), input.size(), implementation));
+            EXPECT_EQ(index.positions(), scalar.positions());
+        }
+    }
+
+    // Parsing with the index gives the same values as the string contents
+    JsonTape tape;
+    tape.parseString(json);
+    EXPECT_EQ(tape["k3"][0].getStringValue(), "\\\\\\\"xxx");
+    EXPECT_EQ(tape["k199"][1].getNumberValue(), 199*13);
+}
+
+TEST_F(ValueTests, StructuralSummary) // NOLINT
+{
+    // Part 2 starts inside the string "x]\\\"{", right after an escaped backslash
+    std::string json = R"({"a": [1, {"b": "x]\"{"}], 'c': 2})";
+    size_t cut = json.find("\\")+2;
+    const char* text = json.data();
+    for (auto implementation : {JsonStructuralIndex::SCALAR, JsonStructuralIndex::SSE2, JsonStructuralIndex::AVX2}) {
+        if (!JsonStructuralIndex::isSupported(implementation))
+            continue;
+        auto first = JsonStructuralIndex::summarize(text, text, text+cut, implementation);
+        EXPECT_EQ(first.depthChange[0], 3);
+        EXPECT_TRUE(first.oddQuotes);
+        EXPECT_FALSE(first.singleQuotes[0]);
+
+        auto second = JsonStructuralIndex::summarize(text, text+cut, text+json.size(), implementation);
+        EXPECT_EQ(second.depthChange[1], -3);
+        EXPECT_EQ(second.depthChange[0], 1);
+        EXPECT_TRUE(second.oddQuotes);
+        EXPECT_TRUE(second.singleQuotes[1]);
+        EXPECT_EQ(second.newLines, 0u);
+    }
+}
+
+#endif //JSONPARSER_STRUCTURALTESTS_H
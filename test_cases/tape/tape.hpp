@@ -0,0 +1,6 @@
+#ifndef JSONPARSER_TAPE_HPP
+#define JSONPARSER_TAPE_HPP
+
+#include "tapeTests.h"
+
+#endif //JSONPARSER_TAPE_HPP
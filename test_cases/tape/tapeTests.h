@@ -0,0 +1,115 @@
+#ifndef JSONPARSER_TAPETESTS_H
+#define JSONPARSER_TAPETESTS_H
+
+#include "../BaseTest.h"
+#include "../../jsonTape.h"
+
+TEST_F(ValueTests, TapeLayout) // NOLINT
+{
+    JsonTape tape;
+    tape.parseString(R"({"a": [1, true], "b": "c"})");
+
+    // { "a" [ l 1 t ] "b" "c" }
+    const std::vector<uint64_t>& words = tape.words();
+    ASSERT_EQ(words.size(), 10);
+    std::string types;
+    for (uint64_t word : words)
+        types += static_cast<char>(word >> 56);
+    EXPECT_EQ(types.substr(0, 4), "{\"[l");
+    EXPECT_EQ(types.substr(5), "t]\"\"}");
+
+    // Start words jump past their end word and know their size
+    EXPECT_EQ(words[0] & 0xFFFFFFFFu, 10);
+    EXPECT_EQ((words[0] >> 32) & 0xFFFFFF, 2);
+    EXPECT_EQ(words[2] & 0xFFFFFFFFu, 7);
+    EXPECT_EQ(words[6] & 0xFFFFFFFFFFFFFFull, 2);
+}
+
+TEST_F(ValueTests, TapeAnimation) // NOLINT
+{
+    JsonTape tape(TEST_PATH "complex/animation.json");
+
+    EXPECT_STREQ(tape["file"].c_str(), "animation.png");
+    ASSERT_EQ(tape["tile_size"].size(), 2);
+    EXPECT_EQ(tape["tile_size"]["width"].getNumberValue(), 32);
+    EXPECT_EQ(tape["border"].getNumberValue(), 1);
+    ASSERT_TRUE(tape["animations"].isArray());
+    ASSERT_EQ(tape["animations"].size(), 2);
+
+    JsonTapeValue animation = tape["animations"][1];
+    EXPECT_EQ(animation["name"].getStringValue(), "idle_front");
+    EXPECT_TRUE(animation["loop"].getBoolValue());
+    EXPECT_FALSE(animation["pingpong"].getBoolValue());
+    EXPECT_EQ(animation["frame_time"].getNumberValue(), 0.8);
+    EXPECT_TRUE(animation.hasKey("default"));
+    EXPECT_FALSE(animation.hasKey("missing"));
+
+    std::vector<std::string> keys;
+    for (auto it = tape.root().begin(); it!=tape.root().end(); ++it)
+        keys.emplace_back(it.key());
+    std::vector<std::string> expected{"file", "tile_size", "border", "type", "number_of_animations", "animations",
+                                      "transitions"};
+    EXPECT_EQ(keys, expected);
+
+    double frameTimes = 0;
+    for (JsonTapeValue value : tape["animations"])
+        frameTimes += value["frame_time"].getNumberValue();
+    EXPECT_DOUBLE_EQ(frameTimes, 1.0);
+}
+
+TEST_F(ValueTests, TapeErrors) // NOLINT
+{
+    JsonTape tape;
+    tape.parseString(R"({"array": [], "null": null})");
+    EXPECT_TRUE(tape["null"].isNull());
+    EXPECT_EQ(tape["array"].size(), 0);
+
+    try {
+        tape["array"][0];
+        FAIL() << "Expected std::invalid_argument";
+    }
+    MY_CATCH("Index out of range, got [0], but JsonArray is empty", std::invalid_argument)
+
+    try {
+        tape["null"]["key"];
+        FAIL() << "Expected std::invalid_argument";
+    }
+    MY_CATCH("Object is not of type JsonObject", std::invalid_argument)
+
+    try {
+        tape.parse(TEST_PATH "string/string5.json");
+        FAIL() << "Expected ParseError";
+    }
+    MY_CATCH("Error at line 2:\n|\nmiauw\nUnexpected token: 'm'", ParseError)
+
+    try {
+        tape.parse(TEST_PATH "string/string3.json");
+        FAIL() << "Expected ParseError";
+    }
+    MY_CATCH("Error at line 3: Expected new object after ','", ParseError)
+}
+
+TEST_F(ValueTests, TapeAfterFailedParse) // NOLINT
+{
+    // The tape of a failed parse is cleared, queries do not walk a half built tape
+    JsonTape tape;
+    tape.parseString(R"({"a": 1})");
+    EXPECT_THROW(tape.parseString(R"({"a": {"b": 1, "c": [1,2,)"), ParseError);
+    EXPECT_FALSE(tape.hasKey("zzz"));
+    EXPECT_FALSE(tape.hasKey("a"));
+    try {
+        tape["a"];
+        FAIL() << "Expected std::invalid_argument";
+    }
+    MY_CATCH("There is no such key 'a'", std::invalid_argument)
+    try {
+        tape.root();
+        FAIL() << "Expected std::invalid_argument";
+    }
+    MY_CATCH("JsonTape is empty", std::invalid_argument)
+
+    tape.parseString(R"({"a": [1, 2]})");
+    EXPECT_EQ(tape["a"].size(), 2);
+}
+
+#endif //JSONPARSER_TAPETESTS_H
@@ -0,0 +1,6 @@
+#ifndef JSONPARSER_WRITER_HPP
+#define JSONPARSER_WRITER_HPP
+
+#include "writerTests.h"
+
+#endif //JSONPARSER_WRITER_HPP
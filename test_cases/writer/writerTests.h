@@ -0,0 +1,167 @@
+#ifndef JSONPARSER_WRITERTESTS_H
+#define JSONPARSER_WRITERTESTS_H
+
+#include <cstdio>
+#include <limits>
+#include "../BaseTest.h"
+#include "../../jsonWriter.h"
+
+/**
+ * Writes the contents of complex/objectarray.json call by call.
+ */
+static void writeObjectArray(JsonWriter& writer)
+{
+    writer.beginObject().key("array").beginArray();
+    writer.beginObject().key("name").value("object1").key("id").value(1).endObject();
+    writer.beginObject().key("name").value(std::string("object2")).key("id").value(3u).key("dead").value(true)
+          .endObject();
+    writer.endArray().key("nepper").value(true).endObject();
+}
+
+TEST_F(ParserTests, WriterSameAsSerializer) // NOLINT
+{
+    parser->parse(TEST_PATH "complex/objectarray.json");
+    for (int indent : {0, 2, 3}) {
+        std::string text;
+        JsonWriter writer([&text](const char* data, size_t length) { text.append(data, length); }, indent);
+        writeObjectArray(writer);
+        EXPECT_TRUE(writer.complete());
+        writer.finish();
+        EXPECT_EQ(text, parser->dump(indent));
+    }
+
+    std::string text;
+    {
+        JsonWriter writer([&text](const char* data, size_t length) { text.append(data, length); });
+        writer.beginArray().value((*parser)["array"]).value(-7).value(std::numeric_limits<uint64_t>::max())
+              .value(0.5).null().beginObject().endObject().beginArray().endArray().endArray();
+        // The destructor flushes the rest
+    }
+    EXPECT_EQ(text, R"([[{"name":"object1","id":1},{"name":"object2","id":3,"dead":true}],-7,18446744073709551615,)"
+                    R"(0.5,null,{},[]])");
+}
+
+TEST_F(ParserTests, WriterSmallBuffer) // NOLINT
+{
+    // Strings and indentation longer than the buffer are written in parts
+    std::string text;
+    size_t flushes = 0;
+    size_t largest = 0;
+    JsonWriter writer([&](const char* data, size_t length) {
+        text.append(data, length);
+        flushes++;
+        largest = std::max(largest, length);
+    }, 40, JsonWriter::MIN_BUFFER_SIZE);
+    std::string longString;
+    for (int i = 0; i<1000; i++)
+        longString += "text \"quoted\"\n\x01 ";
+    writer.beginObject().key(longString).beginArray();
+    for (int i = 0; i<10; i++)
+        writer.beginArray();
+    writer.value(longString).value(1e300);
+    for (int i = 0; i<10; i++)
+        writer.endArray();
+    writer.endArray().endObject().finish();
+    EXPECT_GT(flushes, 100u);
+    EXPECT_LE(largest, JsonWriter::MIN_BUFFER_SIZE);
+
+    parser->parseString(text);
+    EXPECT_EQ(parser->dump(40), text);
+    JsonValue* element = &(*parser)[longString];
+    for (int i = 0; i<11; i++)
+        element = &(*element)[0];
+    EXPECT_EQ(element->getStringValue(), longString);
+}
+
+TEST_F(ValueTests, WriterCallOrder) // NOLINT
+{
+    std::string text;
+    JsonWriter writer([&text](const char* data, size_t length) { text.append(data, length); });
+    try {
+        writer.key("key");
+        FAIL() << "Expected std::invalid_argument";
+    }
+    MY_CATCH("Key outside of an object", std::invalid_argument)
+    try {
+        writer.finish();
+        FAIL() << "Expected std::invalid_argument";
+    }
+    MY_CATCH("Nothing was written", std::invalid_argument)
+
+    writer.beginObject();
+    try {
+        writer.value(1);
+        FAIL() << "Expected std::invalid_argument";
+    }
+    MY_CATCH("Missing key before value in object", std::invalid_argument)
+    writer.key("list");
+    try {
+        writer.key("other");
+        FAIL() << "Expected std::invalid_argument";
+    }
+    MY_CATCH("Missing value after key", std::invalid_argument)
+    try {
+        writer.endObject();
+        FAIL() << "Expected std::invalid_argument";
+    }
+    MY_CATCH("Missing value after key", std::invalid_argument)
+    writer.beginArray();
+    try {
+        writer.endObject();
+        FAIL() << "Expected std::invalid_argument";
+    }
+    MY_CATCH("endObject without beginObject", std::invalid_argument)
+    try {
+        writer.finish();
+        FAIL() << "Expected std::invalid_argument";
+    }
+    MY_CATCH("Unfinished array", std::invalid_argument)
+    writer.endArray();
+    try {
+        writer.endArray();
+        FAIL() << "Expected std::invalid_argument";
+    }
+    MY_CATCH("endArray without beginArray", std::invalid_argument)
+    writer.endObject();
+    try {
+        writer.value("second root");
+        FAIL() << "Expected std::invalid_argument";
+    }
+    MY_CATCH("The root value is already complete", std::invalid_argument)
+
+    // Wrong calls do not write anything
+    writer.finish();
+    EXPECT_EQ(text, R"({"list":[]})");
+}
+
+TEST_F(ValueTests, WriterFileDescriptor) // NOLINT
+{
+    FILE* file = tmpfile();
+    ASSERT_NE(file, nullptr);
+    {
+        JsonWriter writer(fileno(file), 0, 1000);
+        writer.beginArray();
+        for (int i = 0; i<10000; i++)
+            writer.value(i);
+        writer.endArray().finish();
+    }
+    rewind(file);
+    std::string written(100000, '\0');
+    written.resize(fread(&written[0], 1, written.size(), file));
+    fclose(file);
+
+    JsonParser parser;
+    parser.parseString("{\"values\": "+written+"}");
+    ASSERT_EQ(parser["values"].getArrayValue().size(), 10000u);
+    EXPECT_EQ(parser["values"][9999].getInt64Value(), 9999);
+
+    JsonWriter broken(-1);
+    broken.value("text");
+    try {
+        broken.finish();
+        FAIL() << "Expected std::invalid_argument";
+    }
+    MY_CATCH("Can not write to file descriptor -1", std::invalid_argument)
+}
+
+#endif //JSONPARSER_WRITERTESTS_H